@@ -0,0 +1,118 @@
+#include "plyodine/byte_source.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <ios>
+#include <istream>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include "plyodine/internal/mapped_file.h"
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+
+#include <cerrno>
+#define PLYODINE_HAS_READ 1
+#endif
+
+namespace plyodine {
+
+std::expected<std::span<const std::byte>, std::error_code>
+SpanByteSource::Next() {
+  std::span<const std::byte> result = data_.subspan(position_);
+  position_ = data_.size();
+  return result;
+}
+
+void SpanByteSource::BackUp(size_t count) { position_ -= count; }
+
+StreamByteSource::StreamByteSource(std::istream& stream, size_t block_size)
+    : stream_(stream), buffer_(std::max(block_size, size_t(1u))) {}
+
+std::expected<std::span<const std::byte>, std::error_code>
+StreamByteSource::Next() {
+  if (backed_up_ != 0u) {
+    std::span<const std::byte> result(buffer_.data() + size_ - backed_up_,
+                                      backed_up_);
+    backed_up_ = 0u;
+    return result;
+  }
+
+  stream_.read(reinterpret_cast<char*>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size()));
+  size_ = static_cast<size_t>(stream_.gcount());
+
+  if (size_ == 0u && (stream_.bad() || !stream_.eof())) {
+    return std::unexpected(std::make_error_code(std::io_errc::stream));
+  }
+
+  return std::span<const std::byte>(buffer_.data(), size_);
+}
+
+void StreamByteSource::BackUp(size_t count) { backed_up_ = count; }
+
+FileDescriptorByteSource::FileDescriptorByteSource(int fd, size_t block_size)
+    : fd_(fd), buffer_(std::max(block_size, size_t(1u))) {}
+
+std::expected<std::span<const std::byte>, std::error_code>
+FileDescriptorByteSource::Next() {
+  if (backed_up_ != 0u) {
+    std::span<const std::byte> result(buffer_.data() + size_ - backed_up_,
+                                      backed_up_);
+    backed_up_ = 0u;
+    return result;
+  }
+
+#ifdef PLYODINE_HAS_READ
+  for (;;) {
+    ssize_t bytes_read = read(fd_, buffer_.data(), buffer_.size());
+    if (bytes_read >= 0) {
+      size_ = static_cast<size_t>(bytes_read);
+      break;
+    }
+
+    if (errno != EINTR) {
+      return std::unexpected(std::error_code(errno, std::generic_category()));
+    }
+  }
+
+  return std::span<const std::byte>(buffer_.data(), size_);
+#else
+  return std::unexpected(
+      std::make_error_code(std::errc::function_not_supported));
+#endif  // PLYODINE_HAS_READ
+}
+
+void FileDescriptorByteSource::BackUp(size_t count) { backed_up_ = count; }
+
+struct MappedFileByteSource::File final {
+  internal::MappedFile file;
+};
+
+MappedFileByteSource::MappedFileByteSource(std::unique_ptr<File> file)
+    : file_(std::move(file)), source_(file_->file.data()) {}
+
+MappedFileByteSource::MappedFileByteSource(MappedFileByteSource&&) = default;
+
+MappedFileByteSource& MappedFileByteSource::operator=(MappedFileByteSource&&) =
+    default;
+
+MappedFileByteSource::~MappedFileByteSource() = default;
+
+std::expected<MappedFileByteSource, std::error_code> MappedFileByteSource::Open(
+    const std::filesystem::path& path) {
+  auto file = internal::MappedFile::Open(path);
+  if (!file) {
+    return std::unexpected(file.error());
+  }
+
+  return MappedFileByteSource(
+      std::make_unique<File>(File{std::move(*file)}));
+}
+
+}  // namespace plyodine
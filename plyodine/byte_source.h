@@ -0,0 +1,132 @@
+#ifndef _PLYODINE_BYTE_SOURCE_
+#define _PLYODINE_BYTE_SOURCE_
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace plyodine {
+
+// An input that is read as a sequence of contiguous buffers that are borrowed
+// from the source rather than copied out of it. Implementations may wrap
+// anything that produces bytes in blocks, such as a decompressor or a network
+// buffer, and the consumer reads each block in place.
+class ByteSource {
+ public:
+  virtual ~ByteSource() = default;
+
+  // Returns the next buffer of the input. The bytes remain valid until the
+  // next call to `Next` or `BackUp`. Returns an empty span once the input has
+  // ended and an `std::error_code` containing a non-zero value if the input
+  // could not be read, after which the source should not be read again.
+  virtual std::expected<std::span<const std::byte>, std::error_code>
+  Next() = 0;
+
+  // Returns the last `count` bytes of the buffer most recently returned by
+  // `Next` to the source so that they are returned again by the following call
+  // to `Next`. May only be called once after each call to `Next` and `count`
+  // must not exceed the size of that buffer.
+  virtual void BackUp(size_t count) = 0;
+};
+
+// Reads from a span of memory, which is returned by `Next` as a single buffer.
+class SpanByteSource final : public ByteSource {
+ public:
+  explicit SpanByteSource(std::span<const std::byte> data) : data_(data) {}
+
+  std::expected<std::span<const std::byte>, std::error_code> Next() override;
+  void BackUp(size_t count) override;
+
+ private:
+  std::span<const std::byte> data_;
+  size_t position_ = 0u;
+};
+
+// Reads from an `std::istream` in blocks of `block_size` bytes. Because the
+// stream is read ahead of the consumer, the stream may have been advanced
+// beyond the bytes that have been consumed.
+//
+// If the stream fails before it reaches its end, `Next` returns
+// `std::io_errc::stream`.
+//
+// NOTE: Behavior is undefined if `stream` is not a binary stream.
+class StreamByteSource final : public ByteSource {
+ public:
+  explicit StreamByteSource(std::istream& stream,
+                            size_t block_size = kDefaultBlockSize);
+
+  std::expected<std::span<const std::byte>, std::error_code> Next() override;
+  void BackUp(size_t count) override;
+
+ private:
+  static constexpr size_t kDefaultBlockSize = 64u * 1024u;
+
+  std::istream& stream_;
+  std::vector<std::byte> buffer_;
+  size_t size_ = 0u;
+  size_t backed_up_ = 0u;
+};
+
+// Reads from a file descriptor in blocks of `block_size` bytes using `read`.
+// The descriptor is not closed by the source. As with `StreamByteSource`, the
+// descriptor may be read beyond the bytes that have been consumed.
+//
+// Errors are reported using `std::generic_category`. Where file descriptors
+// are not supported, `Next` returns `std::errc::function_not_supported`.
+class FileDescriptorByteSource final : public ByteSource {
+ public:
+  explicit FileDescriptorByteSource(int fd,
+                                    size_t block_size = kDefaultBlockSize);
+
+  std::expected<std::span<const std::byte>, std::error_code> Next() override;
+  void BackUp(size_t count) override;
+
+ private:
+  static constexpr size_t kDefaultBlockSize = 64u * 1024u;
+
+  int fd_;
+  std::vector<std::byte> buffer_;
+  size_t size_ = 0u;
+  size_t backed_up_ = 0u;
+};
+
+// Reads the contents of a file, which are returned by `Next` as a single
+// buffer. Where supported, regular files are memory mapped. Otherwise, the
+// contents of the file are read into memory when it is opened.
+class MappedFileByteSource final : public ByteSource {
+ public:
+  // Opens the file at `path`. Errors are reported using
+  // `std::generic_category` and are `std::errc::io_error` when the reason is
+  // unknown.
+  static std::expected<MappedFileByteSource, std::error_code> Open(
+      const std::filesystem::path& path);
+
+  MappedFileByteSource(MappedFileByteSource&&);
+  MappedFileByteSource& operator=(MappedFileByteSource&&);
+  ~MappedFileByteSource() override;
+
+  std::expected<std::span<const std::byte>, std::error_code> Next() override {
+    return source_.Next();
+  }
+
+  void BackUp(size_t count) override { source_.BackUp(count); }
+
+ private:
+  struct File;
+
+  explicit MappedFileByteSource(std::unique_ptr<File> file);
+
+  // The contents of an open file stay at the same address, so the span held by
+  // `source_` remains valid when the source is moved
+  std::unique_ptr<File> file_;
+  SpanByteSource source_;
+};
+
+}  // namespace plyodine
+
+#endif  // _PLYODINE_BYTE_SOURCE_
@@ -0,0 +1,146 @@
+#include "plyodine/byte_source.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "googletest/include/gtest/gtest.h"
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace plyodine {
+namespace {
+
+std::span<const std::byte> AsBytes(const std::string& string) {
+  return std::as_bytes(std::span(string.data(), string.size()));
+}
+
+std::string AsString(std::span<const std::byte> bytes) {
+  return std::string(reinterpret_cast<const char*>(bytes.data()),
+                     bytes.size());
+}
+
+// Reads each remaining buffer of `source`, backing up the last byte of every
+// buffer with more than one byte to check that it is returned again.
+std::string ReadAll(ByteSource& source) {
+  std::string result;
+  for (;;) {
+    auto buffer = source.Next();
+    EXPECT_TRUE(buffer);
+    if (!buffer || buffer->empty()) {
+      return result;
+    }
+
+    if (buffer->size() > 1u) {
+      source.BackUp(1u);
+      buffer = buffer->first(buffer->size() - 1u);
+    }
+
+    result += AsString(*buffer);
+  }
+}
+
+const std::string kContents = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+TEST(SpanByteSource, Reads) {
+  SpanByteSource source(AsBytes(kContents));
+
+  auto buffer = source.Next();
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(kContents, AsString(*buffer));
+
+  source.BackUp(5u);
+  buffer = source.Next();
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ("vwxyz", AsString(*buffer));
+
+  buffer = source.Next();
+  ASSERT_TRUE(buffer);
+  EXPECT_TRUE(buffer->empty());
+}
+
+TEST(StreamByteSource, Reads) {
+  for (size_t block_size : {1u, 4u, 36u, 1000u}) {
+    std::stringstream stream(kContents, std::ios::in | std::ios::binary);
+    StreamByteSource source(stream, block_size);
+    EXPECT_EQ(kContents, ReadAll(source));
+  }
+}
+
+TEST(StreamByteSource, Fails) {
+  std::stringstream stream(kContents, std::ios::in | std::ios::binary);
+  stream.setstate(std::ios::badbit);
+
+  StreamByteSource source(stream);
+  auto buffer = source.Next();
+  ASSERT_FALSE(buffer);
+  EXPECT_EQ(std::io_errc::stream, buffer.error());
+}
+
+#if __has_include(<unistd.h>)
+
+TEST(FileDescriptorByteSource, Reads) {
+  for (size_t block_size : {1u, 4u, 36u, 1000u}) {
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    ASSERT_EQ(static_cast<ssize_t>(kContents.size()),
+              write(fds[1], kContents.data(), kContents.size()));
+    close(fds[1]);
+
+    FileDescriptorByteSource source(fds[0], block_size);
+    EXPECT_EQ(kContents, ReadAll(source));
+
+    close(fds[0]);
+  }
+}
+
+TEST(FileDescriptorByteSource, Fails) {
+  FileDescriptorByteSource source(-1);
+  auto buffer = source.Next();
+  ASSERT_FALSE(buffer);
+  EXPECT_EQ(std::errc::bad_file_descriptor, buffer.error());
+}
+
+#endif  // __has_include(<unistd.h>)
+
+TEST(MappedFileByteSource, Reads) {
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "mapped_file_byte_source";
+  std::ofstream(path, std::ios::out | std::ios::binary) << kContents;
+
+  auto source = MappedFileByteSource::Open(path);
+  ASSERT_TRUE(source);
+
+  // The contents remain readable after the source is moved
+  MappedFileByteSource moved = std::move(*source);
+  EXPECT_EQ(kContents, ReadAll(moved));
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileByteSource, Missing) {
+  auto source = MappedFileByteSource::Open(
+      std::filesystem::path(testing::TempDir()) / "missing");
+  ASSERT_FALSE(source);
+  EXPECT_EQ(std::errc::no_such_file_or_directory, source.error());
+}
+
+TEST(MappedFileByteSource, Directory) {
+  // Directories are opened but cannot be read as a file
+  auto source =
+      MappedFileByteSource::Open(std::filesystem::path(testing::TempDir()));
+  ASSERT_FALSE(source);
+  EXPECT_NE(0, source.error().value());
+  EXPECT_EQ(std::generic_category(), source.error().category());
+}
+
+}  // namespace
+}  // namespace plyodine
@@ -0,0 +1,135 @@
+#include "plyodine/internal/ascii_scanner.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PLYODINE_ASCII_SCANNER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PLYODINE_ASCII_SCANNER_NEON
+#endif
+
+namespace plyodine::internal {
+namespace {
+
+bool IsPrintable(char c) { return c >= ' ' && c <= '~'; }
+
+#if defined(PLYODINE_ASCII_SCANNER_SSE2)
+
+constexpr size_t kVectorSize = 16u;
+
+// Returns a mask with the bits set for the bytes of `value` that are not
+// printable. When interpreted as signed, these are the bytes that are either
+// less than ' ' (including every byte with its high bit set) or equal to DEL.
+__m128i NonPrintableMask(__m128i value) {
+  return _mm_or_si128(_mm_cmplt_epi8(value, _mm_set1_epi8(' ')),
+                      _mm_cmpeq_epi8(value, _mm_set1_epi8(0x7F)));
+}
+
+__m128i Load(const char* data) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+bool Any(__m128i mask) { return _mm_movemask_epi8(mask) != 0; }
+
+size_t FirstIndex(__m128i mask) {
+  return static_cast<size_t>(
+      std::countr_zero(static_cast<uint32_t>(_mm_movemask_epi8(mask))));
+}
+
+__m128i Or(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+
+#elif defined(PLYODINE_ASCII_SCANNER_NEON)
+
+constexpr size_t kVectorSize = 16u;
+
+uint8x16_t NonPrintableMask(uint8x16_t value) {
+  int8x16_t as_signed = vreinterpretq_s8_u8(value);
+  return vorrq_u8(vcltq_s8(as_signed, vdupq_n_s8(' ')),
+                  vceqq_u8(value, vdupq_n_u8(0x7F)));
+}
+
+uint8x16_t Load(const char* data) {
+  return vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+}
+
+bool Any(uint8x16_t mask) { return vmaxvq_u8(mask) != 0; }
+
+size_t FirstIndex(uint8x16_t mask) {
+  // Narrows each byte of the mask to four bits of a 64-bit value
+  uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+  uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+  return static_cast<size_t>(std::countr_zero(bits)) / 4u;
+}
+
+uint8x16_t Or(uint8x16_t a, uint8x16_t b) { return vorrq_u8(a, b); }
+
+#endif
+
+}  // namespace
+
+const char* FindNonPrintable(const char* begin, const char* end) {
+#if defined(PLYODINE_ASCII_SCANNER_SSE2) || defined(PLYODINE_ASCII_SCANNER_NEON)
+  while (static_cast<size_t>(end - begin) >= 4u * kVectorSize) {
+    auto mask0 = NonPrintableMask(Load(begin));
+    auto mask1 = NonPrintableMask(Load(begin + kVectorSize));
+    auto mask2 = NonPrintableMask(Load(begin + 2u * kVectorSize));
+    auto mask3 = NonPrintableMask(Load(begin + 3u * kVectorSize));
+
+    if (Any(Or(Or(mask0, mask1), Or(mask2, mask3)))) {
+      break;
+    }
+
+    begin += 4u * kVectorSize;
+  }
+
+  while (static_cast<size_t>(end - begin) >= kVectorSize) {
+    if (auto mask = NonPrintableMask(Load(begin)); Any(mask)) {
+      return begin + FirstIndex(mask);
+    }
+
+    begin += kVectorSize;
+  }
+#endif
+
+  while (begin != end && IsPrintable(*begin)) {
+    begin += 1;
+  }
+
+  return begin;
+}
+
+const char* FindLineEnd(const char* begin, const char* end, bool& has_tabs) {
+  for (;;) {
+    begin = FindNonPrintable(begin, end);
+    if (begin == end || *begin != '\t') {
+      return begin;
+    }
+
+    has_tabs = true;
+    begin += 1;
+  }
+}
+
+std::string_view NextToken(std::string_view& line) {
+  size_t prefix_length = line.find_first_not_of(" \t");
+  if (prefix_length == std::string_view::npos) {
+    line = std::string_view();
+    return std::string_view();
+  }
+
+  line.remove_prefix(prefix_length);
+
+  size_t token_length = std::min(line.find_first_of(" \t"), line.size());
+  std::string_view token = line.substr(0u, token_length);
+  line.remove_prefix(token_length);
+
+  return token;
+}
+
+}  // namespace plyodine::internal
@@ -0,0 +1,26 @@
+#ifndef _PLYODINE_INTERNAL_ASCII_SCANNER_
+#define _PLYODINE_INTERNAL_ASCII_SCANNER_
+
+#include <string_view>
+
+namespace plyodine::internal {
+
+// Returns a pointer to the first character in the range [`begin`, `end`) that
+// is not a printable ASCII character (a character outside the range of ' ' to
+// '~'), or `end` if there is no such character. The range is scanned using
+// SIMD instructions where supported.
+const char* FindNonPrintable(const char* begin, const char* end);
+
+// Returns a pointer to the first character in the range [`begin`, `end`) that
+// is neither a printable ASCII character nor a tab, or `end` if there is no
+// such character. Sets `has_tabs` if any tabs were passed over.
+const char* FindLineEnd(const char* begin, const char* end, bool& has_tabs);
+
+// Removes the next token from the front of `line` and returns it, where tokens
+// are separated by spaces and tabs. Returns an empty string if `line` has no
+// tokens remaining.
+std::string_view NextToken(std::string_view& line);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_ASCII_SCANNER_
@@ -0,0 +1,81 @@
+#include "plyodine/internal/ascii_scanner.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+TEST(FindNonPrintable, Empty) {
+  std::string input;
+  EXPECT_EQ(input.data(),
+            FindNonPrintable(input.data(), input.data() + input.size()));
+}
+
+TEST(FindNonPrintable, AllPrintable) {
+  std::string input;
+  for (size_t i = 0; i < 300u; i++) {
+    input.push_back(static_cast<char>(' ' + i % 95u));
+
+    const char* end = input.data() + input.size();
+    EXPECT_EQ(end, FindNonPrintable(input.data(), end));
+  }
+}
+
+TEST(FindNonPrintable, EachCharacter) {
+  for (int c = 0; c < 256; c++) {
+    bool printable = c >= ' ' && c <= '~';
+    for (size_t length : {1u, 15u, 16u, 17u, 63u, 64u, 65u, 200u}) {
+      for (size_t position = 0; position < length; position++) {
+        std::string input(length, 'a');
+        input[position] = static_cast<char>(c);
+
+        const char* end = input.data() + input.size();
+        const char* expected = printable ? end : input.data() + position;
+        EXPECT_EQ(expected, FindNonPrintable(input.data(), end));
+      }
+    }
+  }
+}
+
+TEST(FindNonPrintable, FindsFirst) {
+  std::string input(100u, 'a');
+  input[70] = '\n';
+  input[40] = '\t';
+  input[90] = '\r';
+
+  EXPECT_EQ(input.data() + 40,
+            FindNonPrintable(input.data(), input.data() + input.size()));
+  EXPECT_EQ(input.data() + 70,
+            FindNonPrintable(input.data() + 41, input.data() + input.size()));
+  EXPECT_EQ(input.data() + 60,
+            FindNonPrintable(input.data() + 41, input.data() + 60));
+}
+
+TEST(FindLineEnd, SkipsTabs) {
+  std::string input = "a\tb\t\tc\r\nd";
+  const char* end = input.data() + input.size();
+
+  bool has_tabs = false;
+  EXPECT_EQ(input.data() + 6, FindLineEnd(input.data(), end, has_tabs));
+  EXPECT_TRUE(has_tabs);
+
+  has_tabs = false;
+  EXPECT_EQ(end, FindLineEnd(input.data() + 8, end, has_tabs));
+  EXPECT_FALSE(has_tabs);
+}
+
+TEST(NextToken, Splits) {
+  std::string_view line = "  ab\t c  d\t";
+  EXPECT_EQ("ab", NextToken(line));
+  EXPECT_EQ("c", NextToken(line));
+  EXPECT_EQ("d", NextToken(line));
+  EXPECT_EQ("", NextToken(line));
+  EXPECT_EQ("", NextToken(line));
+}
+
+}  // namespace
+}  // namespace plyodine::internal
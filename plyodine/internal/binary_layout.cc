@@ -0,0 +1,76 @@
+#include "plyodine/internal/binary_layout.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine::internal {
+namespace {
+
+template <typename T>
+bool ReadListSize(const std::byte* bytes, bool swap_bytes, uintmax_t& size) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+
+  if (swap_bytes) {
+    value = std::byteswap(value);
+  }
+
+  if constexpr (std::is_signed_v<T>) {
+    if (value < 0) {
+      return false;
+    }
+  }
+
+  size = static_cast<uintmax_t>(value);
+
+  return true;
+}
+
+}  // namespace
+
+uintmax_t SaturatingAdd(uintmax_t a, uintmax_t b) {
+  if (std::numeric_limits<uintmax_t>::max() - a < b) {
+    return std::numeric_limits<uintmax_t>::max();
+  }
+
+  return a + b;
+}
+
+uintmax_t SaturatingMultiply(uintmax_t a, uintmax_t b) {
+  if (a != 0 && std::numeric_limits<uintmax_t>::max() / a < b) {
+    return std::numeric_limits<uintmax_t>::max();
+  }
+
+  return a * b;
+}
+
+size_t GetBinarySize(PlyHeader::Property::Type type) {
+  static constexpr size_t sizes[8] = {1u, 1u, 2u, 2u, 4u, 4u, 4u, 8u};
+  return sizes[static_cast<size_t>(type)];
+}
+
+bool ReadListSize(const std::byte* bytes, PlyHeader::Property::Type type,
+                  bool swap_bytes, uintmax_t& size) {
+  switch (type) {
+    case PlyHeader::Property::Type::CHAR:
+      return ReadListSize<int8_t>(bytes, swap_bytes, size);
+    case PlyHeader::Property::Type::UCHAR:
+      return ReadListSize<uint8_t>(bytes, swap_bytes, size);
+    case PlyHeader::Property::Type::SHORT:
+      return ReadListSize<int16_t>(bytes, swap_bytes, size);
+    case PlyHeader::Property::Type::USHORT:
+      return ReadListSize<uint16_t>(bytes, swap_bytes, size);
+    case PlyHeader::Property::Type::INT:
+      return ReadListSize<int32_t>(bytes, swap_bytes, size);
+    default:
+      return ReadListSize<uint32_t>(bytes, swap_bytes, size);
+  }
+}
+
+}  // namespace plyodine::internal
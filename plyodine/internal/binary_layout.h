@@ -0,0 +1,28 @@
+#ifndef _PLYODINE_INTERNAL_BINARY_LAYOUT_
+#define _PLYODINE_INTERNAL_BINARY_LAYOUT_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine::internal {
+
+// Returns `a + b`, or the largest `uintmax_t` if the sum would overflow.
+uintmax_t SaturatingAdd(uintmax_t a, uintmax_t b);
+
+// Returns `a * b`, or the largest `uintmax_t` if the product would overflow.
+uintmax_t SaturatingMultiply(uintmax_t a, uintmax_t b);
+
+// Returns the number of bytes taken by a binary value of `type`.
+size_t GetBinarySize(PlyHeader::Property::Type type);
+
+// Decodes the binary list size of integral `type` stored at `bytes` into
+// `size`, reversing the order of its bytes first if `swap_bytes` is set.
+// Returns false if the list size is negative.
+bool ReadListSize(const std::byte* bytes, PlyHeader::Property::Type type,
+                  bool swap_bytes, uintmax_t& size);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_BINARY_LAYOUT_
@@ -0,0 +1,87 @@
+#include "plyodine/internal/binary_layout.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "googletest/include/gtest/gtest.h"
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine::internal {
+namespace {
+
+using Type = PlyHeader::Property::Type;
+
+template <typename T>
+bool ReadValue(T value, Type type, bool swap_bytes, uintmax_t& size) {
+  if (swap_bytes) {
+    value = std::byteswap(value);
+  }
+
+  std::byte bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+
+  return ReadListSize(bytes, type, swap_bytes, size);
+}
+
+TEST(SaturatingAdd, Saturates) {
+  constexpr uintmax_t kMax = std::numeric_limits<uintmax_t>::max();
+  EXPECT_EQ(5u, SaturatingAdd(2u, 3u));
+  EXPECT_EQ(kMax, SaturatingAdd(kMax - 1u, 1u));
+  EXPECT_EQ(kMax, SaturatingAdd(kMax - 1u, 2u));
+  EXPECT_EQ(kMax, SaturatingAdd(kMax, kMax));
+}
+
+TEST(SaturatingMultiply, Saturates) {
+  constexpr uintmax_t kMax = std::numeric_limits<uintmax_t>::max();
+  EXPECT_EQ(0u, SaturatingMultiply(0u, kMax));
+  EXPECT_EQ(0u, SaturatingMultiply(kMax, 0u));
+  EXPECT_EQ(6u, SaturatingMultiply(2u, 3u));
+  EXPECT_EQ(kMax - 1u, SaturatingMultiply(kMax / 2u, 2u));
+  EXPECT_EQ(kMax, SaturatingMultiply(kMax / 2u + 1u, 2u));
+}
+
+TEST(GetBinarySize, Types) {
+  EXPECT_EQ(1u, GetBinarySize(Type::CHAR));
+  EXPECT_EQ(1u, GetBinarySize(Type::UCHAR));
+  EXPECT_EQ(2u, GetBinarySize(Type::SHORT));
+  EXPECT_EQ(2u, GetBinarySize(Type::USHORT));
+  EXPECT_EQ(4u, GetBinarySize(Type::INT));
+  EXPECT_EQ(4u, GetBinarySize(Type::UINT));
+  EXPECT_EQ(4u, GetBinarySize(Type::FLOAT));
+  EXPECT_EQ(8u, GetBinarySize(Type::DOUBLE));
+}
+
+TEST(ReadListSize, Types) {
+  for (bool swap_bytes : {false, true}) {
+    uintmax_t size = 0u;
+    EXPECT_TRUE(ReadValue<int8_t>(127, Type::CHAR, swap_bytes, size));
+    EXPECT_EQ(127u, size);
+    EXPECT_TRUE(ReadValue<uint8_t>(255u, Type::UCHAR, swap_bytes, size));
+    EXPECT_EQ(255u, size);
+    EXPECT_TRUE(ReadValue<int16_t>(0x1234, Type::SHORT, swap_bytes, size));
+    EXPECT_EQ(0x1234u, size);
+    EXPECT_TRUE(ReadValue<uint16_t>(0xFEDCu, Type::USHORT, swap_bytes, size));
+    EXPECT_EQ(0xFEDCu, size);
+    EXPECT_TRUE(ReadValue<int32_t>(0x12345678, Type::INT, swap_bytes, size));
+    EXPECT_EQ(0x12345678u, size);
+    EXPECT_TRUE(
+        ReadValue<uint32_t>(0xFEDCBA98u, Type::UINT, swap_bytes, size));
+    EXPECT_EQ(0xFEDCBA98u, size);
+  }
+}
+
+TEST(ReadListSize, Negative) {
+  for (bool swap_bytes : {false, true}) {
+    uintmax_t size = 7u;
+    EXPECT_FALSE(ReadValue<int8_t>(-1, Type::CHAR, swap_bytes, size));
+    EXPECT_FALSE(ReadValue<int16_t>(-2, Type::SHORT, swap_bytes, size));
+    EXPECT_FALSE(ReadValue<int32_t>(-3, Type::INT, swap_bytes, size));
+    EXPECT_EQ(7u, size);
+  }
+}
+
+}  // namespace
+}  // namespace plyodine::internal
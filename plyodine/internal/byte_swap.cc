@@ -0,0 +1,208 @@
+#include "plyodine/internal/byte_swap.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PLYODINE_BYTE_SWAP_SSSE3
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PLYODINE_BYTE_SWAP_NEON
+#endif
+
+namespace plyodine::internal {
+namespace {
+
+// Periods larger than this many bytes are not used and each record is instead
+// covered by its own set of chunks.
+constexpr size_t kMaxPeriodSize = 512u;
+
+using SwapChunksFunc = void (*)(char* data, size_t num_periods,
+                                size_t period_size,
+                                std::span<const RecordByteSwapper::Chunk>);
+
+#if defined(PLYODINE_BYTE_SWAP_SSSE3)
+
+__attribute__((target("ssse3"))) void SwapChunksSSSE3(
+    char* data, size_t num_periods, size_t period_size,
+    std::span<const RecordByteSwapper::Chunk> chunks) {
+  for (size_t i = 0; i < num_periods; i++) {
+    for (const auto& chunk : chunks) {
+      __m128i mask =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk.mask.data()));
+      __m128i* location = reinterpret_cast<__m128i*>(data + chunk.offset);
+      _mm_storeu_si128(location,
+                       _mm_shuffle_epi8(_mm_loadu_si128(location), mask));
+    }
+
+    data += period_size;
+  }
+}
+
+#elif defined(PLYODINE_BYTE_SWAP_NEON)
+
+void SwapChunksNEON(char* data, size_t num_periods, size_t period_size,
+                    std::span<const RecordByteSwapper::Chunk> chunks) {
+  for (size_t i = 0; i < num_periods; i++) {
+    for (const auto& chunk : chunks) {
+      uint8x16_t mask = vld1q_u8(chunk.mask.data());
+      uint8_t* location = reinterpret_cast<uint8_t*>(data + chunk.offset);
+      vst1q_u8(location, vqtbl1q_u8(vld1q_u8(location), mask));
+    }
+
+    data += period_size;
+  }
+}
+
+#endif
+
+SwapChunksFunc GetSwapChunksFunc() {
+#if defined(PLYODINE_BYTE_SWAP_SSSE3)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("ssse3")) {
+    return SwapChunksSSSE3;
+  }
+#elif defined(PLYODINE_BYTE_SWAP_NEON)
+  return SwapChunksNEON;
+#endif
+
+  return nullptr;
+}
+
+template <typename T>
+void SwapValue(char* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  value = std::byteswap(value);
+  std::memcpy(data, &value, sizeof(T));
+}
+
+void SwapField(char* data, size_t size) {
+  switch (size) {
+    case 2u:
+      SwapValue<uint16_t>(data);
+      break;
+    case 4u:
+      SwapValue<uint32_t>(data);
+      break;
+    case 8u:
+      SwapValue<uint64_t>(data);
+      break;
+  }
+}
+
+}  // namespace
+
+RecordByteSwapper::RecordByteSwapper(std::span<const size_t> field_sizes) {
+  std::vector<size_t> all_offsets;
+  for (size_t size : field_sizes) {
+    all_offsets.push_back(record_size_);
+
+    if (size > 1u) {
+      field_offsets_.push_back(record_size_);
+      field_sizes_.push_back(size);
+    }
+
+    record_size_ += size;
+  }
+
+  if (field_sizes_.empty()) {
+    return;
+  }
+
+  records_per_period_ = 16u / std::gcd(record_size_, size_t(16u));
+  if (records_per_period_ * record_size_ > kMaxPeriodSize) {
+    records_per_period_ = 1u;
+  }
+
+  for (size_t r = 0; r < records_per_period_; r++) {
+    for (size_t i = 0; i < field_sizes.size(); i++) {
+      size_t size = field_sizes[i];
+      if (chunks_.empty() || chunks_.back().length + size > 16u) {
+        Chunk chunk{r * record_size_ + all_offsets[i], 0u, {}};
+        for (size_t j = 0; j < chunk.mask.size(); j++) {
+          chunk.mask[j] = static_cast<uint8_t>(j);
+        }
+        chunks_.push_back(chunk);
+      }
+
+      Chunk& chunk = chunks_.back();
+      for (size_t j = 0; j < size; j++) {
+        chunk.mask[chunk.length + j] =
+            static_cast<uint8_t>(chunk.length + size - 1u - j);
+      }
+      chunk.length += size;
+    }
+  }
+
+  std::erase_if(chunks_, [](const Chunk& chunk) {
+    for (size_t j = 0; j < chunk.mask.size(); j++) {
+      if (chunk.mask[j] != j) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+void RecordByteSwapper::Swap(char* data, size_t num_records) const {
+  if (field_sizes_.empty()) {
+    return;
+  }
+
+  static const SwapChunksFunc swap_chunks = GetSwapChunksFunc();
+
+  // Each chunk reads and writes 16 bytes from its offset, so the final 16 bytes
+  // of the input are always left for the scalar loop.
+  size_t num_swapped = 0u;
+  if (size_t num_bytes = num_records * record_size_;
+      swap_chunks && num_bytes >= 16u) {
+    size_t period_size = records_per_period_ * record_size_;
+    size_t num_periods = (num_bytes - 16u) / period_size;
+    swap_chunks(data, num_periods, period_size, chunks_);
+    num_swapped = num_periods * records_per_period_;
+  }
+
+  SwapScalar(data + num_swapped * record_size_, num_records - num_swapped);
+}
+
+void RecordByteSwapper::SwapScalar(char* data, size_t num_records) const {
+  for (size_t r = 0; r < num_records; r++) {
+    for (size_t i = 0; i < field_sizes_.size(); i++) {
+      SwapField(data + field_offsets_[i], field_sizes_[i]);
+    }
+
+    data += record_size_;
+  }
+}
+
+void ByteSwap(char* data, size_t value_size, size_t count) {
+  static constexpr size_t kSizes[3] = {2u, 4u, 8u};
+  static const RecordByteSwapper swappers[3] = {
+      RecordByteSwapper(std::span(kSizes + 0, 1u)),
+      RecordByteSwapper(std::span(kSizes + 1, 1u)),
+      RecordByteSwapper(std::span(kSizes + 2, 1u))};
+
+  switch (value_size) {
+    case 2u:
+      swappers[0].Swap(data, count);
+      break;
+    case 4u:
+      swappers[1].Swap(data, count);
+      break;
+    case 8u:
+      swappers[2].Swap(data, count);
+      break;
+  }
+}
+
+}  // namespace plyodine::internal
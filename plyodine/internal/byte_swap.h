@@ -0,0 +1,55 @@
+#ifndef _PLYODINE_INTERNAL_BYTE_SWAP_
+#define _PLYODINE_INTERNAL_BYTE_SWAP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace plyodine::internal {
+
+// Reverses the byte order of each field of a sequence of fixed-size records in
+// place. The shuffle masks used to do so are computed once on construction and
+// are applied using SIMD instructions where supported by the CPU.
+class RecordByteSwapper final {
+ public:
+  // `field_sizes` contains the size in bytes of each field of a record. Each
+  // size must be 1, 2, 4, or 8.
+  explicit RecordByteSwapper(std::span<const size_t> field_sizes);
+
+  // Reverses the byte order of each field of the `num_records` records stored
+  // at `data`.
+  void Swap(char* data, size_t num_records) const;
+
+  size_t record_size() const { return record_size_; }
+
+  // A run of up to 16 bytes made up of whole fields that are swapped by a
+  // single shuffle. Entries of the mask beyond `length` leave their bytes in
+  // place.
+  struct Chunk {
+    size_t offset;
+    size_t length;
+    std::array<uint8_t, 16> mask;
+  };
+
+ private:
+  void SwapScalar(char* data, size_t num_records) const;
+
+  size_t record_size_ = 0u;
+  std::vector<size_t> field_offsets_;
+  std::vector<size_t> field_sizes_;
+
+  // The chunks covering `records_per_period_` records. The period is chosen
+  // such that its size is a multiple of 16 bytes where practical.
+  size_t records_per_period_ = 0u;
+  std::vector<Chunk> chunks_;
+};
+
+// Reverses the byte order of each of the `count` values of `value_size` bytes
+// stored at `data`. `value_size` must be 1, 2, 4, or 8.
+void ByteSwap(char* data, size_t value_size, size_t count);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_BYTE_SWAP_
@@ -0,0 +1,85 @@
+#include "plyodine/internal/byte_swap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+std::vector<char> MakeInput(size_t num_bytes) {
+  std::vector<char> result;
+  for (size_t i = 0; i < num_bytes; i++) {
+    result.push_back(static_cast<char>(i * 7u + 3u));
+  }
+  return result;
+}
+
+std::vector<char> SwapSlowly(std::vector<char> input,
+                             const std::vector<size_t>& field_sizes,
+                             size_t num_records) {
+  char* data = input.data();
+  for (size_t r = 0; r < num_records; r++) {
+    for (size_t size : field_sizes) {
+      std::reverse(data, data + size);
+      data += size;
+    }
+  }
+  return input;
+}
+
+void TestLayout(const std::vector<size_t>& field_sizes) {
+  RecordByteSwapper swapper(field_sizes);
+
+  for (size_t num_records = 0; num_records < 300u; num_records++) {
+    std::vector<char> input = MakeInput(num_records * swapper.record_size());
+    std::vector<char> expected = SwapSlowly(input, field_sizes, num_records);
+
+    swapper.Swap(input.data(), num_records);
+    EXPECT_EQ(expected, input);
+  }
+}
+
+TEST(RecordByteSwapper, Empty) { TestLayout({}); }
+
+TEST(RecordByteSwapper, OnlyBytes) { TestLayout({1u, 1u, 1u}); }
+
+TEST(RecordByteSwapper, Uniform) {
+  TestLayout({2u});
+  TestLayout({4u});
+  TestLayout({8u});
+  TestLayout({4u, 4u, 4u});
+}
+
+TEST(RecordByteSwapper, Mixed) {
+  TestLayout({4u, 1u, 8u, 2u});
+  TestLayout({4u, 4u, 4u, 1u, 1u, 1u});
+  TestLayout({8u, 8u, 8u, 4u, 4u, 4u, 2u, 1u});
+  TestLayout({1u, 2u, 1u, 4u, 1u, 8u, 1u});
+}
+
+TEST(RecordByteSwapper, Large) {
+  std::vector<size_t> field_sizes;
+  for (size_t i = 0; i < 40u; i++) {
+    field_sizes.push_back(size_t(1u) << (i % 4u));
+  }
+  TestLayout(field_sizes);
+}
+
+TEST(ByteSwap, Sizes) {
+  for (size_t size : {1u, 2u, 4u, 8u}) {
+    for (size_t count = 0; count < 100u; count++) {
+      std::vector<char> input = MakeInput(size * count);
+      std::vector<char> expected = SwapSlowly(input, {size}, count);
+
+      ByteSwap(input.data(), size, count);
+      EXPECT_EQ(expected, input);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace plyodine::internal
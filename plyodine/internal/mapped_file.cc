@@ -0,0 +1,112 @@
+#include "plyodine/internal/mapped_file.h"
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#define PLYODINE_HAS_MMAP 1
+#endif
+
+namespace plyodine::internal {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      size_(std::exchange(other.size_, 0u)),
+      contents_(std::move(other.contents_)) {}
+
+MappedFile::~MappedFile() {
+#ifdef PLYODINE_HAS_MMAP
+  if (mapping_ != nullptr) {
+    munmap(mapping_, size_);
+  }
+#endif  // PLYODINE_HAS_MMAP
+}
+
+std::span<const std::byte> MappedFile::data() const {
+  if (mapping_ != nullptr) {
+    return std::span(static_cast<const std::byte*>(mapping_), size_);
+  }
+
+  return contents_;
+}
+
+std::expected<MappedFile, std::error_code> MappedFile::Open(
+    const std::filesystem::path& path) {
+#ifdef PLYODINE_HAS_MMAP
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return std::unexpected(std::error_code(errno, std::generic_category()));
+  }
+
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    std::error_code error(errno, std::generic_category());
+    close(fd);
+    return std::unexpected(error);
+  }
+
+  // Pipes, devices, and empty files cannot be usefully mapped
+  if (!S_ISREG(status.st_mode) || status.st_size <= 0) {
+    close(fd);
+    return ReadContents(path);
+  }
+
+  MappedFile result;
+  result.size_ = static_cast<size_t>(status.st_size);
+  void* mapping =
+      mmap(nullptr, result.size_, PROT_READ, MAP_PRIVATE, fd, /*offset=*/0);
+  std::error_code error(errno, std::generic_category());
+  close(fd);
+
+  if (mapping == MAP_FAILED) {
+    return std::unexpected(error);
+  }
+
+  result.mapping_ = mapping;
+  posix_madvise(mapping, result.size_, POSIX_MADV_SEQUENTIAL);
+
+  return result;
+#else
+  return ReadContents(path);
+#endif  // PLYODINE_HAS_MMAP
+}
+
+// The reason a stream failed is unknown, so failures are reported as
+// `std::errc::io_error`.
+std::expected<MappedFile, std::error_code> MappedFile::ReadContents(
+    const std::filesystem::path& path) {
+  std::ifstream stream(path, std::ios::in | std::ios::binary);
+  if (!stream) {
+    return std::unexpected(std::make_error_code(std::errc::io_error));
+  }
+
+  MappedFile result;
+  std::array<char, 65536u> block;
+  while (stream.read(block.data(), block.size()) || stream.gcount() != 0) {
+    const std::byte* begin = reinterpret_cast<const std::byte*>(block.data());
+    result.contents_.insert(result.contents_.end(), begin,
+                            begin + stream.gcount());
+  }
+
+  if (stream.bad()) {
+    return std::unexpected(std::make_error_code(std::errc::io_error));
+  }
+
+  return result;
+}
+
+}  // namespace plyodine::internal
@@ -0,0 +1,42 @@
+#ifndef _PLYODINE_INTERNAL_MAPPED_FILE_
+#define _PLYODINE_INTERNAL_MAPPED_FILE_
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace plyodine::internal {
+
+// The read-only contents of a file. Where supported, regular files are memory
+// mapped. Otherwise, the contents of the file are read into memory.
+class MappedFile final {
+ public:
+  // Opens the file at `path`. Errors are reported using
+  // `std::generic_category` and are `std::errc::io_error` when the reason is
+  // unknown.
+  static std::expected<MappedFile, std::error_code> Open(
+      const std::filesystem::path& path);
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) = delete;
+  ~MappedFile();
+
+  std::span<const std::byte> data() const;
+
+ private:
+  MappedFile() = default;
+
+  static std::expected<MappedFile, std::error_code> ReadContents(
+      const std::filesystem::path& path);
+
+  void* mapping_ = nullptr;
+  size_t size_ = 0u;
+  std::vector<std::byte> contents_;
+};
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_MAPPED_FILE_
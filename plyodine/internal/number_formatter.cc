@@ -0,0 +1,129 @@
+#include "plyodine/internal/number_formatter.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace plyodine::internal {
+namespace {
+
+constexpr char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+template <typename Unsigned>
+size_t CountDigits(Unsigned value) {
+  size_t length = 1u;
+  for (;;) {
+    if (value < 10u) {
+      return length;
+    }
+
+    if (value < 100u) {
+      return length + 1u;
+    }
+
+    if (value < 1000u) {
+      return length + 2u;
+    }
+
+    if (value < 10000u) {
+      return length + 3u;
+    }
+
+    value /= 10000u;
+    length += 4u;
+  }
+}
+
+// Writes the digits from least to most significant so that each division
+// produces two of them
+template <typename Unsigned>
+char* FormatUnsigned(Unsigned value, char* dest) {
+  char* end = dest + CountDigits(value);
+
+  char* position = end;
+  while (value >= 100u) {
+    size_t pair = static_cast<size_t>(value % 100u) * 2u;
+    value /= 100u;
+    position -= 2;
+    std::memcpy(position, kDigitPairs + pair, 2u);
+  }
+
+  if (value >= 10u) {
+    std::memcpy(position - 2, kDigitPairs + static_cast<size_t>(value) * 2u,
+                2u);
+  } else {
+    position[-1] = static_cast<char>('0' + value);
+  }
+
+  return end;
+}
+
+template <typename Signed>
+char* FormatSigned(Signed value, char* dest) {
+  // Negated as unsigned to avoid overflowing on the minimum value
+  uint32_t magnitude = static_cast<uint32_t>(value);
+  if (value < 0) {
+    *dest++ = '-';
+    magnitude = 0u - magnitude;
+  }
+
+  return FormatUnsigned(magnitude, dest);
+}
+
+template <typename T>
+char* FormatFloatingPoint(T value, char* dest) {
+  return std::to_chars(dest, dest + kMaxFormattedLength<T>, value,
+                       std::chars_format::fixed)
+      .ptr;
+}
+
+}  // namespace
+
+char* FormatNumber(int8_t value, char* dest) {
+  return FormatSigned(value, dest);
+}
+
+char* FormatNumber(uint8_t value, char* dest) {
+  return FormatUnsigned(static_cast<uint32_t>(value), dest);
+}
+
+char* FormatNumber(int16_t value, char* dest) {
+  return FormatSigned(value, dest);
+}
+
+char* FormatNumber(uint16_t value, char* dest) {
+  return FormatUnsigned(static_cast<uint32_t>(value), dest);
+}
+
+char* FormatNumber(int32_t value, char* dest) {
+  return FormatSigned(value, dest);
+}
+
+char* FormatNumber(uint32_t value, char* dest) {
+  return FormatUnsigned(value, dest);
+}
+
+char* FormatNumber(uint64_t value, char* dest) {
+  return FormatUnsigned(value, dest);
+}
+
+char* FormatNumber(float value, char* dest) {
+  return FormatFloatingPoint(value, dest);
+}
+
+char* FormatNumber(double value, char* dest) {
+  return FormatFloatingPoint(value, dest);
+}
+
+}  // namespace plyodine::internal
@@ -0,0 +1,40 @@
+#ifndef _PLYODINE_INTERNAL_NUMBER_FORMATTER_
+#define _PLYODINE_INTERNAL_NUMBER_FORMATTER_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace plyodine::internal {
+
+// The maximum number of characters written by `FormatNumber` for a value of
+// type `T`.
+template <typename T>
+inline constexpr size_t kMaxFormattedLength =
+    std::numeric_limits<T>::digits10 + 2u;
+template <>
+inline constexpr size_t kMaxFormattedLength<float> = 50u;
+template <>
+inline constexpr size_t kMaxFormattedLength<double> = 330u;
+
+// Writes `value` in decimal to the buffer starting at `dest`, which must have
+// space for at least `kMaxFormattedLength` characters, and returns a pointer
+// to the end of the characters written.
+//
+// Integers are written two digits at a time from a table of digit pairs.
+// Floating point values must be finite and are written in fixed notation using
+// the fewest digits that parse back to exactly the same value, without a
+// decimal point if the value is integral.
+char* FormatNumber(int8_t value, char* dest);
+char* FormatNumber(uint8_t value, char* dest);
+char* FormatNumber(int16_t value, char* dest);
+char* FormatNumber(uint16_t value, char* dest);
+char* FormatNumber(int32_t value, char* dest);
+char* FormatNumber(uint32_t value, char* dest);
+char* FormatNumber(uint64_t value, char* dest);
+char* FormatNumber(float value, char* dest);
+char* FormatNumber(double value, char* dest);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_NUMBER_FORMATTER_
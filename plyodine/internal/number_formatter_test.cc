@@ -0,0 +1,119 @@
+#include "plyodine/internal/number_formatter.h"
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+template <typename T>
+std::string Format(T value) {
+  char buffer[kMaxFormattedLength<T>];
+  return std::string(buffer, FormatNumber(value, buffer));
+}
+
+template <typename T>
+void ExpectMatchesToChars(T value) {
+  char buffer[32];
+  std::to_chars_result result = std::to_chars(buffer, buffer + 32, value);
+  ASSERT_EQ(std::errc(), result.ec);
+  EXPECT_EQ(std::string(buffer, result.ptr), Format(value));
+}
+
+template <typename T>
+void ExpectIntegersMatchToChars() {
+  for (T value : {std::numeric_limits<T>::min(), std::numeric_limits<T>::max(),
+                  static_cast<T>(0), static_cast<T>(1), static_cast<T>(9),
+                  static_cast<T>(10), static_cast<T>(99),
+                  static_cast<T>(100)}) {
+    ExpectMatchesToChars(value);
+    ExpectMatchesToChars(static_cast<T>(value + 1));
+    ExpectMatchesToChars(static_cast<T>(value - 1));
+  }
+
+  std::mt19937_64 engine(1u);
+  std::uniform_int_distribution<int64_t> distribution(
+      std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+  for (int i = 0; i < 10000; i++) {
+    ExpectMatchesToChars(static_cast<T>(distribution(engine)));
+  }
+}
+
+TEST(FormatNumber, Integers) {
+  ExpectIntegersMatchToChars<int8_t>();
+  ExpectIntegersMatchToChars<uint8_t>();
+  ExpectIntegersMatchToChars<int16_t>();
+  ExpectIntegersMatchToChars<uint16_t>();
+  ExpectIntegersMatchToChars<int32_t>();
+  ExpectIntegersMatchToChars<uint32_t>();
+
+  for (uint64_t value = 1u; value != 0u; value *= 10u) {
+    ExpectMatchesToChars(value - 1u);
+    ExpectMatchesToChars(value);
+    if (value > std::numeric_limits<uint64_t>::max() / 10u) {
+      break;
+    }
+  }
+  ExpectMatchesToChars(std::numeric_limits<uint64_t>::max());
+}
+
+template <typename T>
+void ExpectRoundTrips(T value) {
+  std::string formatted = Format(value);
+  ASSERT_LE(formatted.size(), kMaxFormattedLength<T>);
+  EXPECT_EQ(std::string::npos, formatted.find_first_of("eE"));
+
+  T parsed;
+  std::from_chars_result result = std::from_chars(
+      formatted.data(), formatted.data() + formatted.size(), parsed);
+  ASSERT_EQ(std::errc(), result.ec) << formatted;
+  EXPECT_EQ(0, std::memcmp(&value, &parsed, sizeof(T))) << formatted;
+}
+
+template <typename T, typename Bits>
+void ExpectFloatingPointRoundTrips() {
+  for (T value :
+       {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(),
+        std::numeric_limits<T>::min(), std::numeric_limits<T>::denorm_min(),
+        -std::numeric_limits<T>::denorm_min(),
+        std::nextafter(std::numeric_limits<T>::min(), static_cast<T>(0)),
+        static_cast<T>(0), -static_cast<T>(0), static_cast<T>(1),
+        static_cast<T>(0.1), static_cast<T>(1e10),
+        std::acos(-static_cast<T>(1))}) {
+    ExpectRoundTrips(value);
+  }
+
+  std::mt19937_64 engine(1u);
+  for (int i = 0; i < 100000; i++) {
+    T value = std::bit_cast<T>(static_cast<Bits>(engine()));
+    if (std::isfinite(value)) {
+      ExpectRoundTrips(value);
+    }
+  }
+}
+
+TEST(FormatNumber, Float) {
+  ExpectFloatingPointRoundTrips<float, uint32_t>();
+  EXPECT_EQ("1.5", Format(1.5f));
+  EXPECT_EQ("-2", Format(-2.0f));
+  EXPECT_EQ("3.1415927", Format(std::acos(-1.0f)));
+}
+
+TEST(FormatNumber, Double) {
+  ExpectFloatingPointRoundTrips<double, uint64_t>();
+  EXPECT_EQ("1.5", Format(1.5));
+  EXPECT_EQ("-2", Format(-2.0));
+  EXPECT_EQ("3.141592653589793", Format(std::acos(-1.0)));
+}
+
+}  // namespace
+}  // namespace plyodine::internal
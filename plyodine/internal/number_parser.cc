@@ -0,0 +1,241 @@
+#include "plyodine/internal/number_parser.h"
+
+#include <bit>
+#include <cfloat>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace plyodine::internal {
+namespace {
+
+// The largest number of digits that can always be accumulated into a uint64_t
+// without overflowing.
+constexpr size_t kMaxExactDigits = 19u;
+
+// Returns true if each of the eight bytes of `chunk` is an ASCII digit.
+bool AllDigits(uint64_t chunk) {
+  return (chunk & 0xF0F0F0F0F0F0F0F0u) == 0x3030303030303030u &&
+         ((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) ==
+             0x3030303030303030u;
+}
+
+// Returns the value of the eight ASCII digits of `chunk`, where the first digit
+// is stored in the least significant byte.
+uint64_t DigitsValue(uint64_t chunk) {
+  static constexpr uint64_t kMask = 0x000000FF000000FFu;
+  static constexpr uint64_t kMultiplier0 = 100u + (1000000ull << 32u);
+  static constexpr uint64_t kMultiplier1 = 1u + (10000ull << 32u);
+
+  chunk -= 0x3030303030303030u;
+  chunk = (chunk * 10u) + (chunk >> 8u);
+  return ((chunk & kMask) * kMultiplier0 +
+          ((chunk >> 16u) & kMask) * kMultiplier1) >>
+         32u;
+}
+
+// Accumulates the run of ASCII digits starting at `pos` into `value`,
+// consuming at most `max_digits` of them. Returns the number of digits
+// consumed.
+size_t AccumulateDigits(const char*& pos, const char* end, size_t max_digits,
+                        uint64_t& value) {
+  const char* start = pos;
+  const char* limit =
+      (static_cast<size_t>(end - pos) > max_digits) ? pos + max_digits : end;
+
+  while (limit - pos >= 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, pos, sizeof(chunk));
+    if constexpr (std::endian::native == std::endian::big) {
+      chunk = std::byteswap(chunk);
+    }
+
+    if (!AllDigits(chunk)) {
+      break;
+    }
+
+    value = value * 100000000u + DigitsValue(chunk);
+    pos += 8;
+  }
+
+  while (pos != limit && *pos >= '0' && *pos <= '9') {
+    value = value * 10u + static_cast<uint64_t>(*pos - '0');
+    pos += 1;
+  }
+
+  return static_cast<size_t>(pos - start);
+}
+
+template <std::integral T>
+std::errc ParseInteger(const char* begin, const char* end, T& value) {
+  bool negative = false;
+  if constexpr (std::is_signed_v<T>) {
+    negative = begin != end && *begin == '-';
+    if (negative) {
+      begin += 1;
+    }
+  }
+
+  const char* pos = begin;
+  uint64_t magnitude = 0u;
+  AccumulateDigits(pos, end, kMaxExactDigits, magnitude);
+
+  if (pos == begin) {
+    return std::errc::invalid_argument;
+  }
+
+  if (pos != end) {
+    // Either an invalid character was found or there were too many digits to
+    // accumulate exactly, both of which are rare enough to defer.
+    std::from_chars_result result =
+        std::from_chars(negative ? begin - 1 : begin, end, value);
+    if (result.ec == std::errc::invalid_argument || result.ptr != end) {
+      return std::errc::invalid_argument;
+    }
+    return result.ec;
+  }
+
+  uint64_t max_magnitude = static_cast<uint64_t>(std::numeric_limits<T>::max());
+  if (negative) {
+    max_magnitude += 1u;
+  }
+
+  if (magnitude > max_magnitude) {
+    return std::errc::result_out_of_range;
+  }
+
+  if (negative) {
+    value = static_cast<T>(-static_cast<int64_t>(magnitude));
+  } else {
+    value = static_cast<T>(magnitude);
+  }
+
+  return std::errc();
+}
+
+// The number of significant digits and decimal places for which a value in
+// fixed notation can be computed with a single correctly rounded division of
+// two exactly representable values.
+template <std::floating_point T>
+struct FastPathLimits;
+
+template <>
+struct FastPathLimits<float> {
+  static constexpr size_t kMaxDigits = 7u;
+  static constexpr size_t kMaxDecimalPlaces = 10u;
+};
+
+template <>
+struct FastPathLimits<double> {
+  static constexpr size_t kMaxDigits = 15u;
+  static constexpr size_t kMaxDecimalPlaces = 22u;
+};
+
+template <std::floating_point T>
+constexpr T kPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                              1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                              1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Parses values of the form [-]digits[.digits]. Returns false without
+// modifying `value` if the range is not of that form or if it has too many
+// digits to be computed exactly.
+template <std::floating_point T>
+bool ParseFixedNotation(const char* begin, const char* end, T& value) {
+  using Limits = FastPathLimits<T>;
+
+  // Intermediate results must be rounded to the precision of `T` for the
+  // division below to be correctly rounded.
+  if constexpr (FLT_EVAL_METHOD != 0) {
+    return false;
+  }
+
+  const char* pos = begin;
+  bool negative = pos != end && *pos == '-';
+  if (negative) {
+    pos += 1;
+  }
+
+  uint64_t mantissa = 0u;
+  size_t num_digits =
+      AccumulateDigits(pos, end, Limits::kMaxDigits + 1u, mantissa);
+  if (num_digits == 0u) {
+    return false;
+  }
+
+  size_t num_decimal_places = 0u;
+  if (pos != end && *pos == '.') {
+    pos += 1;
+    num_decimal_places = AccumulateDigits(
+        pos, end, Limits::kMaxDigits + 1u - num_digits, mantissa);
+    if (num_decimal_places == 0u) {
+      return false;
+    }
+    num_digits += num_decimal_places;
+  }
+
+  if (pos != end || num_digits > Limits::kMaxDigits ||
+      num_decimal_places > Limits::kMaxDecimalPlaces) {
+    return false;
+  }
+
+  T result = static_cast<T>(mantissa) / kPowersOfTen<T>[num_decimal_places];
+  value = negative ? -result : result;
+
+  return true;
+}
+
+template <std::floating_point T>
+std::errc ParseFloat(const char* begin, const char* end, T& value) {
+  if (ParseFixedNotation(begin, end, value)) {
+    return std::errc();
+  }
+
+  std::from_chars_result result = std::from_chars(begin, end, value);
+  if (result.ec == std::errc::invalid_argument || result.ptr != end) {
+    return std::errc::invalid_argument;
+  }
+
+  return result.ec;
+}
+
+}  // namespace
+
+std::errc ParseNumber(const char* begin, const char* end, int8_t& value) {
+  return ParseInteger(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, uint8_t& value) {
+  return ParseInteger(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, int16_t& value) {
+  return ParseInteger(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, uint16_t& value) {
+  return ParseInteger(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, int32_t& value) {
+  return ParseInteger(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, uint32_t& value) {
+  return ParseInteger(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, float& value) {
+  return ParseFloat(begin, end, value);
+}
+
+std::errc ParseNumber(const char* begin, const char* end, double& value) {
+  return ParseFloat(begin, end, value);
+}
+
+}  // namespace plyodine::internal
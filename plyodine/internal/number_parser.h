@@ -0,0 +1,30 @@
+#ifndef _PLYODINE_INTERNAL_NUMBER_PARSER_
+#define _PLYODINE_INTERNAL_NUMBER_PARSER_
+
+#include <cstdint>
+#include <system_error>
+
+namespace plyodine::internal {
+
+// Parses the entire range [`begin`, `end`) as a number of the type of `value`.
+// The accepted syntax and the resulting values are identical to those of
+// calling `std::from_chars` on the range and requiring that every character be
+// consumed. Returns `std::errc::invalid_argument` if the range is not a valid
+// number and `std::errc::result_out_of_range` if it is valid but cannot be
+// represented by the type. `value` is only modified on success.
+//
+// Integers are parsed eight digits at a time using SWAR arithmetic. Floating
+// point values written in short fixed notation are computed directly using
+// exact arithmetic and all others fall back to `std::from_chars`.
+std::errc ParseNumber(const char* begin, const char* end, int8_t& value);
+std::errc ParseNumber(const char* begin, const char* end, uint8_t& value);
+std::errc ParseNumber(const char* begin, const char* end, int16_t& value);
+std::errc ParseNumber(const char* begin, const char* end, uint16_t& value);
+std::errc ParseNumber(const char* begin, const char* end, int32_t& value);
+std::errc ParseNumber(const char* begin, const char* end, uint32_t& value);
+std::errc ParseNumber(const char* begin, const char* end, float& value);
+std::errc ParseNumber(const char* begin, const char* end, double& value);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_NUMBER_PARSER_
@@ -0,0 +1,199 @@
+#include "plyodine/internal/number_parser.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+template <typename T>
+std::errc ParseReference(const char* begin, const char* end, T& value) {
+  std::from_chars_result result = std::from_chars(begin, end, value);
+  if (result.ec == std::errc::invalid_argument || result.ptr != end) {
+    return std::errc::invalid_argument;
+  }
+  return result.ec;
+}
+
+template <typename T>
+void ExpectMatchesReference(const std::string& input) {
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+
+  T expected = static_cast<T>(123);
+  std::errc expected_result = ParseReference(begin, end, expected);
+
+  T actual = static_cast<T>(123);
+  std::errc actual_result = ParseNumber(begin, end, actual);
+
+  EXPECT_EQ(expected_result, actual_result) << "Input: '" << input << "'";
+  EXPECT_EQ(0, std::memcmp(&expected, &actual, sizeof(T)))
+      << "Input: '" << input << "' Expected: " << +expected
+      << " Actual: " << +actual;
+}
+
+void ExpectAllMatchReference(const std::string& input) {
+  ExpectMatchesReference<int8_t>(input);
+  ExpectMatchesReference<uint8_t>(input);
+  ExpectMatchesReference<int16_t>(input);
+  ExpectMatchesReference<uint16_t>(input);
+  ExpectMatchesReference<int32_t>(input);
+  ExpectMatchesReference<uint32_t>(input);
+  ExpectMatchesReference<float>(input);
+  ExpectMatchesReference<double>(input);
+}
+
+template <typename T>
+void AddBoundaries(std::vector<std::string>& inputs) {
+  for (int64_t offset = -2; offset <= 2; offset++) {
+    int64_t min = static_cast<int64_t>(std::numeric_limits<T>::min());
+    int64_t max = static_cast<int64_t>(std::numeric_limits<T>::max());
+    inputs.push_back(std::to_string(min + offset));
+    inputs.push_back(std::to_string(max + offset));
+  }
+}
+
+TEST(ParseNumber, Special) {
+  std::vector<std::string> inputs = {"",
+                                     "-",
+                                     "+",
+                                     "+1",
+                                     "--1",
+                                     "-0",
+                                     "0",
+                                     "00000000",
+                                     "000000000000000000000000000001",
+                                     "99999999999999999999999999999",
+                                     "-99999999999999999999999999999",
+                                     "12345678",
+                                     "123456789",
+                                     "1234567a",
+                                     "12345678a",
+                                     "a12345678",
+                                     " 1",
+                                     "1 ",
+                                     "1.",
+                                     ".1",
+                                     "-.1",
+                                     "1.5",
+                                     "-1.5",
+                                     "1.5.5",
+                                     "1..5",
+                                     "1e5",
+                                     "1E5",
+                                     "1e",
+                                     "1e+",
+                                     "1e-5",
+                                     "1e400",
+                                     "-1e400",
+                                     "1e-400",
+                                     "1e-40",
+                                     "0x10",
+                                     "inf",
+                                     "-inf",
+                                     "infinity",
+                                     "nan",
+                                     "-nan",
+                                     "nan(1)",
+                                     "0.1",
+                                     "0.2",
+                                     "0.3",
+                                     "3.4028235e38",
+                                     "3.4028236e38",
+                                     "340282350000000000000000000000000000000",
+                                     "0.000000000000000000001",
+                                     "0.0000000000000000000001",
+                                     "0.00000000001",
+                                     "0.0000000001",
+                                     "9007199254740993",
+                                     "900719925474099.3",
+                                     "16777217",
+                                     "1677721.7",
+                                     "9999999.5",
+                                     "999999.95",
+                                     "123456789012345",
+                                     "1234567890123456",
+                                     "1234567.89012345",
+                                     "0.123456789012345",
+                                     "-0.0",
+                                     "-0.000"};
+
+  AddBoundaries<int8_t>(inputs);
+  AddBoundaries<uint8_t>(inputs);
+  AddBoundaries<int16_t>(inputs);
+  AddBoundaries<uint16_t>(inputs);
+  AddBoundaries<int32_t>(inputs);
+  AddBoundaries<uint32_t>(inputs);
+
+  for (const auto& input : inputs) {
+    ExpectAllMatchReference(input);
+  }
+}
+
+TEST(ParseNumber, RandomStrings) {
+  static constexpr char kAlphabet[] =
+      "0123456789012345678901234567890123456789-.e";
+
+  std::mt19937 generator(1234u);
+  std::uniform_int_distribution<size_t> length_distribution(0u, 24u);
+  std::uniform_int_distribution<size_t> char_distribution(
+      0u, sizeof(kAlphabet) - 2u);
+
+  for (size_t i = 0; i < 100000u; i++) {
+    std::string input;
+    for (size_t length = length_distribution(generator); length > 0u;
+         length--) {
+      input.push_back(kAlphabet[char_distribution(generator)]);
+    }
+    ExpectAllMatchReference(input);
+  }
+}
+
+TEST(ParseNumber, RandomIntegers) {
+  std::mt19937_64 generator(1234u);
+  std::uniform_int_distribution<int> shift_distribution(1, 63);
+
+  for (size_t i = 0; i < 100000u; i++) {
+    int64_t value = static_cast<int64_t>(generator() >>
+                                         shift_distribution(generator));
+    ExpectAllMatchReference(std::to_string(value));
+    ExpectAllMatchReference(std::to_string(-value));
+  }
+}
+
+TEST(ParseNumber, RandomFloats) {
+  std::mt19937_64 generator(1234u);
+  std::uniform_real_distribution<double> mantissa_distribution(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent_distribution(-12, 12);
+  std::uniform_int_distribution<int> precision_distribution(0, 20);
+
+  for (size_t i = 0; i < 100000u; i++) {
+    double value = mantissa_distribution(generator) *
+                   std::pow(10.0, exponent_distribution(generator));
+
+    char buffer[512];
+    std::snprintf(buffer, sizeof(buffer), "%.*f",
+                  precision_distribution(generator), value);
+    ExpectAllMatchReference(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "%.*g",
+                  precision_distribution(generator), value);
+    ExpectAllMatchReference(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<float>(value));
+    ExpectAllMatchReference(buffer);
+  }
+}
+
+}  // namespace
+}  // namespace plyodine::internal
@@ -0,0 +1,145 @@
+#include "plyodine/internal/parallel_file_writer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#define PLYODINE_HAS_PWRITE 1
+#endif
+
+namespace plyodine::internal {
+
+std::expected<std::unique_ptr<ParallelFileWriter>, std::error_code>
+ParallelFileWriter::Open(const std::filesystem::path& path,
+                         size_t num_threads) {
+#ifdef PLYODINE_HAS_PWRITE
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (fd < 0) {
+    return std::unexpected(std::error_code(errno, std::generic_category()));
+  }
+
+  return std::unique_ptr<ParallelFileWriter>(
+      new ParallelFileWriter(fd, std::max(num_threads, size_t(1u))));
+#else
+  return std::unexpected(
+      std::make_error_code(std::errc::function_not_supported));
+#endif  // PLYODINE_HAS_PWRITE
+}
+
+ParallelFileWriter::ParallelFileWriter(int fd, size_t num_threads)
+    : fd_(fd), pool_(num_threads) {}
+
+ParallelFileWriter::~ParallelFileWriter() {
+  pool_.Wait();
+
+#ifdef PLYODINE_HAS_PWRITE
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+#endif  // PLYODINE_HAS_PWRITE
+}
+
+bool ParallelFileWriter::Append(const char* data, size_t size) {
+  if (pool_.error()) {
+    return false;
+  }
+
+  pending_.insert(pending_.end(), data, data + size);
+  end_ += size;
+
+  if (pending_.size() >= kBlockSize) {
+    Dispatch();
+  }
+
+  return true;
+}
+
+uint64_t ParallelFileWriter::Reserve(uint64_t size) {
+  Dispatch();
+
+  uint64_t offset = end_;
+  end_ += size;
+  pending_offset_ = end_;
+
+#if defined(PLYODINE_HAS_PWRITE) && defined(__linux__)
+  if (size != 0u) {
+    posix_fallocate(fd_, static_cast<off_t>(offset), static_cast<off_t>(size));
+  }
+#endif
+
+  return offset;
+}
+
+void ParallelFileWriter::Submit(Job job) { pool_.Submit(std::move(job)); }
+
+std::error_code ParallelFileWriter::WriteAt(const char* data, size_t size,
+                                            uint64_t offset) const {
+#ifdef PLYODINE_HAS_PWRITE
+  while (size != 0u) {
+    ssize_t written = pwrite(fd_, data, size, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return std::error_code(errno, std::generic_category());
+    }
+
+    data += written;
+    size -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+
+  return std::error_code();
+#else
+  return std::make_error_code(std::errc::function_not_supported);
+#endif  // PLYODINE_HAS_PWRITE
+}
+
+std::error_code ParallelFileWriter::Wait() { return pool_.Wait(); }
+
+std::error_code ParallelFileWriter::Finish() {
+  Dispatch();
+
+  std::error_code error = Wait();
+
+#ifdef PLYODINE_HAS_PWRITE
+  if (!error && ftruncate(fd_, static_cast<off_t>(end_)) != 0) {
+    error = std::error_code(errno, std::generic_category());
+  }
+
+  if (close(fd_) != 0 && !error) {
+    error = std::error_code(errno, std::generic_category());
+  }
+  fd_ = -1;
+#endif  // PLYODINE_HAS_PWRITE
+
+  return error;
+}
+
+void ParallelFileWriter::Dispatch() {
+  if (pending_.empty()) {
+    return;
+  }
+
+  Submit([this, data = std::move(pending_), offset = pending_offset_]() {
+    return WriteAt(data.data(), data.size(), offset);
+  });
+
+  pending_ = std::vector<char>();
+  pending_offset_ = end_;
+}
+
+}  // namespace plyodine::internal
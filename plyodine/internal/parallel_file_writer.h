@@ -0,0 +1,92 @@
+#ifndef _PLYODINE_INTERNAL_PARALLEL_FILE_WRITER_
+#define _PLYODINE_INTERNAL_PARALLEL_FILE_WRITER_
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include "plyodine/internal/thread_pool.h"
+
+namespace plyodine::internal {
+
+// Writes a file from a pool of threads that each write disjoint ranges of the
+// file using positional writes, so that several writes are in flight at once.
+//
+// The output is laid out from the calling thread, which either appends bytes
+// to the end of the output or reserves a range of it to be filled in by a job
+// run on the pool. Jobs are run by a `ThreadPool` and once a job fails, no
+// further bytes may be appended.
+class ParallelFileWriter final {
+ public:
+  // A job run on one of the threads of the pool. Returns an `std::error_code`
+  // containing a non-zero value on failure.
+  using Job = ThreadPool::Job;
+
+  // Creates or truncates the file at `path` and starts `num_threads` threads,
+  // at least one of which is always started. Errors are reported using
+  // `std::generic_category`. Where positional writes are not supported,
+  // returns `std::errc::function_not_supported`.
+  static std::expected<std::unique_ptr<ParallelFileWriter>, std::error_code>
+  Open(const std::filesystem::path& path, size_t num_threads);
+
+  // Waits for any submitted jobs before closing the file.
+  ~ParallelFileWriter();
+
+  ParallelFileWriter(const ParallelFileWriter&) = delete;
+  ParallelFileWriter& operator=(const ParallelFileWriter&) = delete;
+
+  // Copies `size` bytes from `data` to the end of the output. Appended bytes
+  // are gathered into large blocks that are each written by a job. Returns
+  // false if a job has failed.
+  bool Append(const char* data, size_t size);
+
+  // Reserves the next `size` bytes of the output, which are to be written by
+  // the caller's jobs using `WriteAt`, and returns the offset of the first.
+  // Where supported, the storage of the reserved bytes is allocated up front
+  // so that the jobs writing them do not each extend the file. This is only a
+  // hint and errors allocating storage are ignored.
+  uint64_t Reserve(uint64_t size);
+
+  // Queues `job` to be run on the pool, first waiting for the queue to drain
+  // if too many jobs are already queued.
+  void Submit(Job job);
+
+  // Writes `size` bytes from `data` at `offset`. May be called concurrently.
+  std::error_code WriteAt(const char* data, size_t size, uint64_t offset) const;
+
+  // Waits for every job submitted so far to complete. Returns the error of the
+  // first job that failed, if any.
+  std::error_code Wait();
+
+  // Writes any appended bytes, waits for every job to complete, sets the size
+  // of the file to the size of the output, and closes it. Returns the first
+  // error that occurred. No other functions may be called afterwards.
+  std::error_code Finish();
+
+  // The size of the output, including bytes that have not yet been written.
+  uint64_t size() const { return end_; }
+
+ private:
+  static constexpr size_t kBlockSize = 1024u * 1024u;
+
+  ParallelFileWriter(int fd, size_t num_threads);
+
+  void Dispatch();
+
+  int fd_;
+  std::vector<char> pending_;
+  uint64_t pending_offset_ = 0u;
+  uint64_t end_ = 0u;
+
+  // Declared last so that the threads are joined before the rest of the
+  // writer is destroyed
+  ThreadPool pool_;
+};
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_PARALLEL_FILE_WRITER_
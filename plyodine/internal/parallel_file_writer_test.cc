@@ -0,0 +1,127 @@
+#include "plyodine/internal/parallel_file_writer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+std::filesystem::path MakePath(const std::string& name) {
+  return std::filesystem::path(testing::TempDir()) / name;
+}
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream input(path, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(input), {});
+}
+
+TEST(ParallelFileWriter, Empty) {
+  std::filesystem::path path = MakePath("parallel_file_writer_empty");
+  auto file = ParallelFileWriter::Open(path, 4u);
+  ASSERT_TRUE(file);
+  EXPECT_EQ(0, (*file)->Finish().value());
+  EXPECT_EQ("", ReadFile(path));
+}
+
+TEST(ParallelFileWriter, Append) {
+  std::string expected;
+  for (size_t i = 0; i < 3000000u; i++) {
+    expected.push_back(static_cast<char>(i * 13u));
+  }
+
+  std::filesystem::path path = MakePath("parallel_file_writer_append");
+  for (size_t num_threads : {1u, 2u, 8u}) {
+    auto file = ParallelFileWriter::Open(path, num_threads);
+    ASSERT_TRUE(file);
+
+    for (size_t offset = 0u; offset < expected.size(); offset += 1000u) {
+      size_t size = std::min<size_t>(1000u, expected.size() - offset);
+      ASSERT_TRUE((*file)->Append(expected.data() + offset, size));
+    }
+
+    EXPECT_EQ(expected.size(), (*file)->size());
+    EXPECT_EQ(0, (*file)->Finish().value());
+    EXPECT_EQ(expected, ReadFile(path));
+  }
+}
+
+TEST(ParallelFileWriter, Reserve) {
+  std::filesystem::path path = MakePath("parallel_file_writer_reserve");
+  auto file = ParallelFileWriter::Open(path, 3u);
+  ASSERT_TRUE(file);
+
+  ASSERT_TRUE((*file)->Append("abc", 3u));
+  uint64_t offset = (*file)->Reserve(26u);
+  EXPECT_EQ(3u, offset);
+  ASSERT_TRUE((*file)->Append("xyz", 3u));
+  EXPECT_EQ(32u, (*file)->size());
+
+  // The reserved range is filled in backwards, one byte per job
+  for (char c = 'Z'; c >= 'A'; c--) {
+    (*file)->Submit([&file, c, offset]() {
+      return (*file)->WriteAt(&c, 1u, offset + static_cast<uint64_t>(c - 'A'));
+    });
+  }
+
+  EXPECT_EQ(0, (*file)->Wait().value());
+  EXPECT_EQ(0, (*file)->Finish().value());
+  EXPECT_EQ("abcABCDEFGHIJKLMNOPQRSTUVWXYZxyz", ReadFile(path));
+}
+
+TEST(ParallelFileWriter, ReserveUnwritten) {
+  std::filesystem::path path = MakePath("parallel_file_writer_unwritten");
+  auto file = ParallelFileWriter::Open(path, 2u);
+  ASSERT_TRUE(file);
+
+  ASSERT_TRUE((*file)->Append("abc", 3u));
+  EXPECT_EQ(3u, (*file)->Reserve(1000000u));
+  EXPECT_EQ(0, (*file)->Finish().value());
+  EXPECT_EQ(1000003u, std::filesystem::file_size(path));
+}
+
+TEST(ParallelFileWriter, JobFails) {
+  std::filesystem::path path = MakePath("parallel_file_writer_job_fails");
+  auto file = ParallelFileWriter::Open(path, 2u);
+  ASSERT_TRUE(file);
+
+  (*file)->Submit([]() { return std::error_code(5, std::generic_category()); });
+  EXPECT_EQ(std::error_code(5, std::generic_category()), (*file)->Wait());
+
+  bool ran = false;
+  (*file)->Submit([&ran]() {
+    ran = true;
+    return std::error_code();
+  });
+  EXPECT_EQ(std::error_code(5, std::generic_category()), (*file)->Wait());
+  EXPECT_FALSE(ran);
+
+  EXPECT_FALSE((*file)->Append("abc", 3u));
+  EXPECT_EQ(std::error_code(5, std::generic_category()), (*file)->Finish());
+}
+
+TEST(ParallelFileWriter, DestroyedWithoutFinish) {
+  std::filesystem::path path = MakePath("parallel_file_writer_destroyed");
+  {
+    auto file = ParallelFileWriter::Open(path, 2u);
+    ASSERT_TRUE(file);
+    (*file)->Submit([&file]() { return (*file)->WriteAt("abc", 3u, 0u); });
+  }
+
+  EXPECT_EQ("abc", ReadFile(path));
+}
+
+TEST(ParallelFileWriter, OpenFails) {
+  auto file = ParallelFileWriter::Open(MakePath("missing") / "file", 2u);
+  ASSERT_FALSE(file);
+  EXPECT_EQ(std::errc::no_such_file_or_directory, file.error());
+}
+
+}  // namespace
+}  // namespace plyodine::internal
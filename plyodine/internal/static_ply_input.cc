@@ -0,0 +1,318 @@
+#include "plyodine/internal/static_ply_input.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "plyodine/internal/ascii_scanner.h"
+#include "plyodine/internal/binary_layout.h"
+#include "plyodine/internal/number_parser.h"
+#include "plyodine/ply_header_reader.h"
+
+namespace {
+
+using ::plyodine::internal::StaticPlyError;
+
+static class ErrorCategory final : public std::error_category {
+  const char* name() const noexcept override;
+  std::string message(int condition) const override;
+  std::error_condition default_error_condition(
+      int value) const noexcept override;
+} kErrorCategory;
+
+const char* ErrorCategory::name() const noexcept {
+  return "plyodine::StaticPlyReader";
+}
+
+std::string ErrorCategory::message(int condition) const {
+  StaticPlyError error{condition};
+  switch (error) {
+    case StaticPlyError::MISSING_ELEMENT:
+      return "The input did not contain an element required by the schema";
+    case StaticPlyError::MISMATCHED_PROPERTIES:
+      return "The properties of an element of the input did not match the "
+             "schema";
+    case StaticPlyError::UNEXPECTED_EOF:
+      return "The input ended earlier than expected";
+    case StaticPlyError::NEGATIVE_LIST_SIZE:
+      return "The input contained a property list with a negative size";
+    case StaticPlyError::MISMATCHED_LINE_ENDINGS:
+      return "The input contained mismatched line endings";
+    case StaticPlyError::INVALID_CHARACTER:
+      return "The input contained an invalid character";
+    case StaticPlyError::MISSING_TOKEN:
+      return "The input contained a line with too few tokens";
+    case StaticPlyError::UNUSED_TOKEN:
+      return "The input contained a line with too many tokens";
+    case StaticPlyError::FAILED_TO_PARSE:
+      return "The input contained a token that could not be parsed";
+    case StaticPlyError::OUT_OF_RANGE:
+      return "The input contained a token that was out of range for its type";
+  };
+
+  return "Unknown Error";
+}
+
+std::error_condition ErrorCategory::default_error_condition(
+    int value) const noexcept {
+  if (value < static_cast<int>(StaticPlyError::MIN_VALUE) ||
+      value > static_cast<int>(StaticPlyError::MAX_VALUE)) {
+    return std::error_condition(value, *this);
+  }
+
+  return std::make_error_condition(std::errc::invalid_argument);
+}
+
+}  // namespace
+
+namespace plyodine::internal {
+namespace {
+
+// Parses `token` as a list size of integral `type`.
+std::error_code ParseListSize(std::string_view token,
+                              PlyHeader::Property::Type type,
+                              uintmax_t& size) {
+  auto parse = [&](auto value) {
+    if (std::error_code error = ParseToken(token, value); error) {
+      return error;
+    }
+
+    if constexpr (std::is_signed_v<decltype(value)>) {
+      if (value < 0) {
+        return MakeStaticPlyError(StaticPlyError::NEGATIVE_LIST_SIZE);
+      }
+    }
+
+    size = static_cast<uintmax_t>(value);
+
+    return std::error_code();
+  };
+
+  switch (type) {
+    case PlyHeader::Property::Type::CHAR:
+      return parse(int8_t());
+    case PlyHeader::Property::Type::UCHAR:
+      return parse(uint8_t());
+    case PlyHeader::Property::Type::SHORT:
+      return parse(int16_t());
+    case PlyHeader::Property::Type::USHORT:
+      return parse(uint16_t());
+    case PlyHeader::Property::Type::INT:
+      return parse(int32_t());
+    default:
+      return parse(uint32_t());
+  }
+}
+
+}  // namespace
+
+std::error_code MakeStaticPlyError(StaticPlyError error) {
+  return std::error_code(static_cast<int>(error), kErrorCategory);
+}
+
+std::error_code StaticPlyInput::NextLine() {
+  if (eof_ || next_ == end_) {
+    return MakeStaticPlyError(StaticPlyError::UNEXPECTED_EOF);
+  }
+
+  bool has_tabs = false;
+  const char* position = FindLineEnd(next_, end_, has_tabs);
+
+  line_ = std::string_view(next_, position);
+
+  // The last line of the input is not required to be terminated
+  if (position == end_) {
+    eof_ = true;
+    next_ = end_;
+
+    if (line_.find_first_not_of(" \t") == std::string_view::npos) {
+      return MakeStaticPlyError(StaticPlyError::UNEXPECTED_EOF);
+    }
+
+    return std::error_code();
+  }
+
+  if (*position != line_ending_[0]) {
+    if (*position == '\r' || *position == '\n') {
+      return MakeStaticPlyError(StaticPlyError::MISMATCHED_LINE_ENDINGS);
+    }
+
+    return MakeStaticPlyError(StaticPlyError::INVALID_CHARACTER);
+  }
+
+  position += 1;
+
+  if (line_ending_.size() > 1u) {
+    if (position == end_ || *position != line_ending_[1]) {
+      return MakeStaticPlyError(StaticPlyError::MISMATCHED_LINE_ENDINGS);
+    }
+
+    position += 1;
+  }
+
+  next_ = position;
+
+  return std::error_code();
+}
+
+std::error_code StaticPlyInput::NextToken(std::string_view& token) {
+  token = internal::NextToken(line_);
+  if (token.empty()) {
+    return MakeStaticPlyError(eof_ ? StaticPlyError::UNEXPECTED_EOF
+                                   : StaticPlyError::MISSING_TOKEN);
+  }
+
+  return std::error_code();
+}
+
+std::error_code StaticPlyInput::EndLine() const {
+  std::string_view rest = line_;
+  if (!internal::NextToken(rest).empty()) {
+    return MakeStaticPlyError(StaticPlyError::UNUSED_TOKEN);
+  }
+
+  return std::error_code();
+}
+
+std::error_code StaticPlyInput::SkipElement(PlyHeader::Format format,
+                                            const PlyHeader::Element& element) {
+  if (format == PlyHeader::Format::ASCII) {
+    for (uintmax_t instance = 0; instance < element.instance_count;
+         instance++) {
+      if (std::error_code error = SkipASCIIInstance(element); error) {
+        return error;
+      }
+    }
+
+    return std::error_code();
+  }
+
+  bool fixed_size = true;
+  uintmax_t instance_size = 0u;
+  for (const PlyHeader::Property& property : element.properties) {
+    fixed_size &= !property.list_type.has_value();
+    instance_size += GetBinarySize(property.data_type);
+  }
+
+  if (fixed_size) {
+    if (!Take(SaturatingMultiply(element.instance_count, instance_size))) {
+      return MakeStaticPlyError(StaticPlyError::UNEXPECTED_EOF);
+    }
+
+    return std::error_code();
+  }
+
+  for (uintmax_t instance = 0; instance < element.instance_count;
+       instance++) {
+    if (std::error_code error = SkipBinaryInstance(format, element); error) {
+      return error;
+    }
+  }
+
+  return std::error_code();
+}
+
+std::error_code StaticPlyInput::SkipASCIIInstance(
+    const PlyHeader::Element& element) {
+  if (std::error_code error = NextLine(); error) {
+    return error;
+  }
+
+  // As with `PlyReader`, skipped values are not parsed but each line must
+  // still contain exactly the tokens described by its element
+  for (const PlyHeader::Property& property : element.properties) {
+    std::string_view token;
+    if (std::error_code error = NextToken(token); error) {
+      return error;
+    }
+
+    if (!property.list_type) {
+      continue;
+    }
+
+    uintmax_t list_size = 0u;
+    if (std::error_code error =
+            ParseListSize(token, *property.list_type, list_size);
+        error) {
+      return error;
+    }
+
+    for (uintmax_t i = 0; i < list_size; i++) {
+      if (std::error_code error = NextToken(token); error) {
+        return error;
+      }
+    }
+  }
+
+  return EndLine();
+}
+
+std::error_code StaticPlyInput::SkipBinaryInstance(
+    PlyHeader::Format format, const PlyHeader::Element& element) {
+  bool swap = (format == PlyHeader::Format::BINARY_BIG_ENDIAN) !=
+              (std::endian::native == std::endian::big);
+
+  for (const PlyHeader::Property& property : element.properties) {
+    uintmax_t size = GetBinarySize(property.data_type);
+
+    if (property.list_type) {
+      const char* bytes = Take(GetBinarySize(*property.list_type));
+      if (!bytes) {
+        return MakeStaticPlyError(StaticPlyError::UNEXPECTED_EOF);
+      }
+
+      uintmax_t list_size;
+      if (!ReadListSize(reinterpret_cast<const std::byte*>(bytes),
+                        *property.list_type, swap, list_size)) {
+        return MakeStaticPlyError(StaticPlyError::NEGATIVE_LIST_SIZE);
+      }
+
+      size = SaturatingMultiply(list_size, size);
+    }
+
+    if (!Take(size)) {
+      return MakeStaticPlyError(StaticPlyError::UNEXPECTED_EOF);
+    }
+  }
+
+  return std::error_code();
+}
+
+template <typename T>
+std::error_code ParseToken(std::string_view token, T& value) {
+  const char* start = token.data();
+  const char* end = start + token.size();
+
+  bool out_of_range = false;
+  if constexpr (std::is_unsigned_v<T>) {
+    out_of_range = start != end && start[0] == '-';
+    if (out_of_range) {
+      start += 1;
+    }
+  }
+
+  std::errc result = ParseNumber(start, end, value);
+  if (result == std::errc::invalid_argument) {
+    return MakeStaticPlyError(StaticPlyError::FAILED_TO_PARSE);
+  } else if (result == std::errc::result_out_of_range || out_of_range) {
+    return MakeStaticPlyError(StaticPlyError::OUT_OF_RANGE);
+  }
+
+  return std::error_code();
+}
+
+template std::error_code ParseToken(std::string_view, int8_t&);
+template std::error_code ParseToken(std::string_view, uint8_t&);
+template std::error_code ParseToken(std::string_view, int16_t&);
+template std::error_code ParseToken(std::string_view, uint16_t&);
+template std::error_code ParseToken(std::string_view, int32_t&);
+template std::error_code ParseToken(std::string_view, uint32_t&);
+template std::error_code ParseToken(std::string_view, float&);
+template std::error_code ParseToken(std::string_view, double&);
+
+}  // namespace plyodine::internal
@@ -0,0 +1,89 @@
+#ifndef _PLYODINE_INTERNAL_STATIC_PLY_INPUT_
+#define _PLYODINE_INTERNAL_STATIC_PLY_INPUT_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine::internal {
+
+// The errors reported by `StaticPlyReader`.
+enum class StaticPlyError {
+  MIN_VALUE = 1,
+  MISSING_ELEMENT = 1,
+  MISMATCHED_PROPERTIES = 2,
+  UNEXPECTED_EOF = 3,
+  NEGATIVE_LIST_SIZE = 4,
+  MISMATCHED_LINE_ENDINGS = 5,
+  INVALID_CHARACTER = 6,
+  MISSING_TOKEN = 7,
+  UNUSED_TOKEN = 8,
+  FAILED_TO_PARSE = 9,
+  OUT_OF_RANGE = 10,
+  MAX_VALUE = 10,
+};
+
+std::error_code MakeStaticPlyError(StaticPlyError error);
+
+// A cursor over the data section of a PLY input held in memory. Binary values
+// are consumed as raw bytes while ASCII values are consumed one line and one
+// token at a time.
+class StaticPlyInput final {
+ public:
+  StaticPlyInput(std::span<const std::byte> data, std::string_view line_ending)
+      : next_(reinterpret_cast<const char*>(data.data())),
+        end_(next_ + data.size()),
+        line_ending_(line_ending) {}
+
+  // Returns the next `size` bytes of the input and advances past them. Returns
+  // nullptr without consuming any input if fewer than `size` bytes remain.
+  const char* Take(uintmax_t size) {
+    if (static_cast<uintmax_t>(end_ - next_) < size) {
+      return nullptr;
+    }
+
+    const char* result = next_;
+    next_ += size;
+
+    return result;
+  }
+
+  // Returns the number of bytes of input remaining.
+  size_t remaining() const { return static_cast<size_t>(end_ - next_); }
+
+  // Advances to the next line of an ASCII input.
+  std::error_code NextLine();
+
+  // Sets `token` to the next token of the current line of an ASCII input.
+  std::error_code NextToken(std::string_view& token);
+
+  // Checks that every token of the current line of an ASCII input was used.
+  std::error_code EndLine() const;
+
+  // Advances past every instance of `element` without decoding them.
+  std::error_code SkipElement(PlyHeader::Format format,
+                              const PlyHeader::Element& element);
+
+ private:
+  std::error_code SkipASCIIInstance(const PlyHeader::Element& element);
+  std::error_code SkipBinaryInstance(PlyHeader::Format format,
+                                     const PlyHeader::Element& element);
+
+  const char* next_;
+  const char* end_;
+  std::string_view line_ending_;
+  std::string_view line_;
+  bool eof_ = false;
+};
+
+// Parses the entire token as a value of the type of `value`.
+template <typename T>
+std::error_code ParseToken(std::string_view token, T& value);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_STATIC_PLY_INPUT_
@@ -0,0 +1,79 @@
+#include "plyodine/internal/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace plyodine::internal {
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : max_queued_(2u * std::max(num_threads, size_t(1u))) {
+  for (size_t i = 0; i < std::max(num_threads, size_t(1u)); i++) {
+    threads_.emplace_back(
+        [this](std::stop_token stop_token) { Run(stop_token); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  Wait();
+
+  for (std::jthread& thread : threads_) {
+    thread.request_stop();
+  }
+  threads_.clear();
+}
+
+void ThreadPool::Submit(Job job) {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [&] { return jobs_.size() < max_queued_; });
+  jobs_.push_back(std::move(job));
+  condition_.notify_all();
+}
+
+std::error_code ThreadPool::Wait() {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [&] { return jobs_.empty() && running_ == 0u; });
+  return error_;
+}
+
+std::error_code ThreadPool::error() {
+  std::lock_guard lock(mutex_);
+  return error_;
+}
+
+void ThreadPool::Run(std::stop_token stop_token) {
+  for (;;) {
+    Job job;
+    bool skip;
+    {
+      std::unique_lock lock(mutex_);
+      if (!condition_.wait(lock, stop_token, [&] { return !jobs_.empty(); })) {
+        return;
+      }
+
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      running_ += 1u;
+      skip = static_cast<bool>(error_);
+      condition_.notify_all();
+    }
+
+    std::error_code error;
+    if (!skip) {
+      error = job();
+    }
+
+    std::lock_guard lock(mutex_);
+    running_ -= 1u;
+    if (error && !error_) {
+      error_ = error;
+    }
+    condition_.notify_all();
+  }
+}
+
+}  // namespace plyodine::internal
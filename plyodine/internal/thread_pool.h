@@ -0,0 +1,70 @@
+#ifndef _PLYODINE_INTERNAL_THREAD_POOL_
+#define _PLYODINE_INTERNAL_THREAD_POOL_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace plyodine::internal {
+
+// A fixed set of threads that run jobs submitted from a single thread. The
+// threads are started once and reused for every job, so a pool should be kept
+// for as long as there is work for it.
+//
+// Jobs run in no particular order. Once a job fails, the jobs that have not yet
+// started are skipped.
+class ThreadPool final {
+ public:
+  // A job run on one of the threads of the pool. Returns an `std::error_code`
+  // containing a non-zero value on failure.
+  using Job = std::move_only_function<std::error_code()>;
+
+  // Starts `num_threads` threads, at least one of which is always started.
+  explicit ThreadPool(size_t num_threads);
+
+  // Waits for any submitted jobs before stopping the threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Queues `job` to be run on the pool, first waiting for the queue to drain
+  // if too many jobs are already queued.
+  void Submit(Job job);
+
+  // Waits for every job submitted so far to complete. Returns the error of the
+  // first job that failed, if any.
+  std::error_code Wait();
+
+  // Returns the error of the first job that failed so far, if any, without
+  // waiting for the jobs that are still queued or running.
+  std::error_code error();
+
+  // The number of threads in the pool.
+  size_t num_threads() const { return threads_.size(); }
+
+ private:
+  void Run(std::stop_token stop_token);
+
+  size_t max_queued_;
+
+  std::mutex mutex_;
+  std::condition_variable_any condition_;
+  std::deque<Job> jobs_;
+  size_t running_ = 0u;
+  std::error_code error_;
+
+  // Declared last so that the threads are joined before the rest of the pool
+  // is destroyed
+  std::vector<std::jthread> threads_;
+};
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_THREAD_POOL_
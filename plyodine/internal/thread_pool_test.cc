@@ -0,0 +1,76 @@
+#include "plyodine/internal/thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <system_error>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+TEST(ThreadPool, NumThreads) {
+  EXPECT_EQ(1u, ThreadPool(0u).num_threads());
+  EXPECT_EQ(3u, ThreadPool(3u).num_threads());
+}
+
+TEST(ThreadPool, RunsEveryJob) {
+  for (size_t num_threads : {1u, 2u, 8u}) {
+    ThreadPool pool(num_threads);
+
+    std::atomic<size_t> sum = 0u;
+    for (size_t i = 1u; i <= 1000u; i++) {
+      pool.Submit([&sum, i]() {
+        sum += i;
+        return std::error_code();
+      });
+    }
+
+    EXPECT_EQ(0, pool.Wait().value());
+    EXPECT_EQ(500500u, sum);
+
+    // The pool is reused once its jobs are done
+    pool.Submit([&sum]() {
+      sum = 0u;
+      return std::error_code();
+    });
+
+    EXPECT_EQ(0, pool.Wait().value());
+    EXPECT_EQ(0u, sum);
+  }
+}
+
+TEST(ThreadPool, JobFails) {
+  ThreadPool pool(2u);
+  EXPECT_EQ(0, pool.error().value());
+
+  pool.Submit([]() { return std::error_code(5, std::generic_category()); });
+  EXPECT_EQ(std::error_code(5, std::generic_category()), pool.Wait());
+  EXPECT_EQ(std::error_code(5, std::generic_category()), pool.error());
+
+  bool ran = false;
+  pool.Submit([&ran]() {
+    ran = true;
+    return std::error_code();
+  });
+  EXPECT_EQ(std::error_code(5, std::generic_category()), pool.Wait());
+  EXPECT_FALSE(ran);
+}
+
+TEST(ThreadPool, DestroyedWithoutWait) {
+  std::atomic<size_t> count = 0u;
+  {
+    ThreadPool pool(2u);
+    for (size_t i = 0u; i < 100u; i++) {
+      pool.Submit([&count]() {
+        count += 1u;
+        return std::error_code();
+      });
+    }
+  }
+
+  EXPECT_EQ(100u, count);
+}
+
+}  // namespace
+}  // namespace plyodine::internal
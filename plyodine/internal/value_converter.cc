@@ -0,0 +1,203 @@
+#include "plyodine/internal/value_converter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PLYODINE_VALUE_CONVERTER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PLYODINE_VALUE_CONVERTER_NEON
+#endif
+
+namespace plyodine::internal {
+namespace {
+
+// The number of values range checked together before any are converted.
+constexpr size_t kBlockSize = 64u;
+
+template <typename Source, typename Dest>
+bool OutOfRange(Source value) {
+  if constexpr (std::is_floating_point_v<Source>) {
+    if constexpr (sizeof(Dest) < sizeof(Source)) {
+      // Written without branches so that blocks of values can be vectorized
+      Source magnitude = value < 0 ? -value : value;
+      Source max = std::numeric_limits<Dest>::max();
+      return (magnitude > max) &
+             (magnitude < std::numeric_limits<Source>::infinity());
+    }
+  } else {
+    if constexpr (std::is_signed_v<Source> && !std::is_signed_v<Dest>) {
+      if constexpr (sizeof(Source) > sizeof(Dest)) {
+        return static_cast<std::make_unsigned_t<Source>>(value) >
+               std::numeric_limits<Dest>::max();
+      } else {
+        return value < 0;
+      }
+    } else if constexpr (std::is_signed_v<Source> && std::is_signed_v<Dest> &&
+                         sizeof(Dest) < sizeof(Source)) {
+      return (value < std::numeric_limits<Dest>::min()) |
+             (value > std::numeric_limits<Dest>::max());
+    } else if constexpr (sizeof(Source) > sizeof(Dest) ||
+                         (sizeof(Source) == sizeof(Dest) &&
+                          !std::is_signed_v<Source> &&
+                          std::is_signed_v<Dest>)) {
+      return value > static_cast<Source>(std::numeric_limits<Dest>::max());
+    }
+  }
+
+  return false;
+}
+
+template <typename Source, typename Dest>
+size_t ConvertBlocks(const Source* source, size_t count, Dest* dest) {
+  size_t converted = 0u;
+  while (count - converted >= kBlockSize) {
+    bool out_of_range = false;
+    for (size_t i = 0; i < kBlockSize; i++) {
+      out_of_range |= OutOfRange<Source, Dest>(source[converted + i]);
+    }
+
+    if (out_of_range) {
+      break;
+    }
+
+    for (size_t i = 0; i < kBlockSize; i++) {
+      dest[converted + i] = static_cast<Dest>(source[converted + i]);
+    }
+
+    converted += kBlockSize;
+  }
+
+  return converted;
+}
+
+#if defined(PLYODINE_VALUE_CONVERTER_SSE2)
+
+template <>
+size_t ConvertBlocks(const double* source, size_t count, float* dest) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d max = _mm_set1_pd(std::numeric_limits<float>::max());
+  const __m128d infinity =
+      _mm_set1_pd(std::numeric_limits<double>::infinity());
+
+  size_t converted = 0u;
+  while (count - converted >= 4u) {
+    __m128d low = _mm_loadu_pd(source + converted);
+    __m128d high = _mm_loadu_pd(source + converted + 2u);
+
+    __m128d low_magnitude = _mm_andnot_pd(sign, low);
+    __m128d high_magnitude = _mm_andnot_pd(sign, high);
+    __m128d out_of_range = _mm_or_pd(
+        _mm_and_pd(_mm_cmpgt_pd(low_magnitude, max),
+                   _mm_cmplt_pd(low_magnitude, infinity)),
+        _mm_and_pd(_mm_cmpgt_pd(high_magnitude, max),
+                   _mm_cmplt_pd(high_magnitude, infinity)));
+    if (_mm_movemask_pd(out_of_range) != 0) {
+      break;
+    }
+
+    _mm_storeu_ps(dest + converted,
+                  _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+    converted += 4u;
+  }
+
+  return converted;
+}
+
+#elif defined(PLYODINE_VALUE_CONVERTER_NEON)
+
+template <>
+size_t ConvertBlocks(const double* source, size_t count, float* dest) {
+  const float64x2_t max = vdupq_n_f64(std::numeric_limits<float>::max());
+  const float64x2_t infinity =
+      vdupq_n_f64(std::numeric_limits<double>::infinity());
+
+  size_t converted = 0u;
+  while (count - converted >= 4u) {
+    float64x2_t low = vld1q_f64(source + converted);
+    float64x2_t high = vld1q_f64(source + converted + 2u);
+
+    uint64x2_t out_of_range =
+        vorrq_u64(vandq_u64(vcagtq_f64(low, max), vcaltq_f64(low, infinity)),
+                  vandq_u64(vcagtq_f64(high, max), vcaltq_f64(high, infinity)));
+    if (vmaxvq_u32(vreinterpretq_u32_u64(out_of_range)) != 0u) {
+      break;
+    }
+
+    vst1q_f32(dest + converted,
+              vcombine_f32(vcvt_f32_f64(low), vcvt_f32_f64(high)));
+    converted += 4u;
+  }
+
+  return converted;
+}
+
+#endif
+
+}  // namespace
+
+template <typename Source, typename Dest>
+size_t ConvertValues(std::span<const Source> source, Dest* dest) {
+  static_assert(std::is_floating_point_v<Source> ==
+                std::is_floating_point_v<Dest>);
+
+  size_t converted = ConvertBlocks(source.data(), source.size(), dest);
+
+  for (; converted < source.size(); converted++) {
+    if (OutOfRange<Source, Dest>(source[converted])) {
+      break;
+    }
+
+    dest[converted] = static_cast<Dest>(source[converted]);
+  }
+
+  return converted;
+}
+
+template size_t ConvertValues(std::span<const int8_t>, int8_t*);
+template size_t ConvertValues(std::span<const int8_t>, uint8_t*);
+template size_t ConvertValues(std::span<const int8_t>, int16_t*);
+template size_t ConvertValues(std::span<const int8_t>, uint16_t*);
+template size_t ConvertValues(std::span<const int8_t>, int32_t*);
+template size_t ConvertValues(std::span<const int8_t>, uint32_t*);
+template size_t ConvertValues(std::span<const uint8_t>, int8_t*);
+template size_t ConvertValues(std::span<const uint8_t>, uint8_t*);
+template size_t ConvertValues(std::span<const uint8_t>, int16_t*);
+template size_t ConvertValues(std::span<const uint8_t>, uint16_t*);
+template size_t ConvertValues(std::span<const uint8_t>, int32_t*);
+template size_t ConvertValues(std::span<const uint8_t>, uint32_t*);
+template size_t ConvertValues(std::span<const int16_t>, int8_t*);
+template size_t ConvertValues(std::span<const int16_t>, uint8_t*);
+template size_t ConvertValues(std::span<const int16_t>, int16_t*);
+template size_t ConvertValues(std::span<const int16_t>, uint16_t*);
+template size_t ConvertValues(std::span<const int16_t>, int32_t*);
+template size_t ConvertValues(std::span<const int16_t>, uint32_t*);
+template size_t ConvertValues(std::span<const uint16_t>, int8_t*);
+template size_t ConvertValues(std::span<const uint16_t>, uint8_t*);
+template size_t ConvertValues(std::span<const uint16_t>, int16_t*);
+template size_t ConvertValues(std::span<const uint16_t>, uint16_t*);
+template size_t ConvertValues(std::span<const uint16_t>, int32_t*);
+template size_t ConvertValues(std::span<const uint16_t>, uint32_t*);
+template size_t ConvertValues(std::span<const int32_t>, int8_t*);
+template size_t ConvertValues(std::span<const int32_t>, uint8_t*);
+template size_t ConvertValues(std::span<const int32_t>, int16_t*);
+template size_t ConvertValues(std::span<const int32_t>, uint16_t*);
+template size_t ConvertValues(std::span<const int32_t>, int32_t*);
+template size_t ConvertValues(std::span<const int32_t>, uint32_t*);
+template size_t ConvertValues(std::span<const uint32_t>, int8_t*);
+template size_t ConvertValues(std::span<const uint32_t>, uint8_t*);
+template size_t ConvertValues(std::span<const uint32_t>, int16_t*);
+template size_t ConvertValues(std::span<const uint32_t>, uint16_t*);
+template size_t ConvertValues(std::span<const uint32_t>, int32_t*);
+template size_t ConvertValues(std::span<const uint32_t>, uint32_t*);
+template size_t ConvertValues(std::span<const float>, float*);
+template size_t ConvertValues(std::span<const float>, double*);
+template size_t ConvertValues(std::span<const double>, float*);
+template size_t ConvertValues(std::span<const double>, double*);
+
+}  // namespace plyodine::internal
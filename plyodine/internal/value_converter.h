@@ -0,0 +1,27 @@
+#ifndef _PLYODINE_INTERNAL_VALUE_CONVERTER_
+#define _PLYODINE_INTERNAL_VALUE_CONVERTER_
+
+#include <cstddef>
+#include <span>
+
+namespace plyodine::internal {
+
+// Converts the values of `source` to the type of `dest`, stopping at the first
+// value that is out of range for the destination type. Returns the number of
+// values converted, which is `source.size()` if every value was in range.
+// `dest` must have room for `source.size()` values.
+//
+// The values that are out of range are those for which `PlyReader` reports a
+// conversion failure: negative integers converted to unsigned types, integers
+// that do not fit in the destination type, and finite doubles that do not fit
+// in a float. Infinities and NaNs are converted as is.
+//
+// Values are range checked and converted in blocks using SIMD instructions
+// where supported. Only conversions between two integer types or between two
+// floating point types are provided.
+template <typename Source, typename Dest>
+size_t ConvertValues(std::span<const Source> source, Dest* dest);
+
+}  // namespace plyodine::internal
+
+#endif  // _PLYODINE_INTERNAL_VALUE_CONVERTER_
@@ -0,0 +1,156 @@
+#include "plyodine/internal/value_converter.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace plyodine::internal {
+namespace {
+
+template <typename Source, typename Dest>
+bool InRange(Source value) {
+  if constexpr (std::is_floating_point_v<Source>) {
+    return !std::isfinite(value) ||
+           std::abs(value) <= std::numeric_limits<Dest>::max();
+  } else {
+    return std::in_range<Dest>(value);
+  }
+}
+
+// Converts `values` and checks the result against converting each value one
+// at a time.
+template <typename Source, typename Dest>
+void ExpectMatchesReference(const std::vector<Source>& values) {
+  size_t expected_converted = 0u;
+  while (expected_converted < values.size() &&
+         InRange<Source, Dest>(values[expected_converted])) {
+    expected_converted += 1u;
+  }
+
+  std::vector<Dest> dest(values.size(), Dest(0));
+  ASSERT_EQ(expected_converted,
+            ConvertValues(std::span<const Source>(values), dest.data()));
+
+  for (size_t i = 0; i < expected_converted; i++) {
+    if constexpr (std::is_floating_point_v<Source>) {
+      if (std::isnan(values[i])) {
+        EXPECT_TRUE(std::isnan(dest[i]));
+        continue;
+      }
+    }
+
+    EXPECT_EQ(static_cast<Dest>(values[i]), dest[i]) << i;
+  }
+}
+
+// Checks the conversion of blocks of in range values with each of `limits`
+// placed at a range of positions, including positions that fall within and
+// after the vectorized blocks.
+template <typename Source, typename Dest>
+void ExpectConverts(const std::vector<Source>& limits) {
+  std::mt19937 engine(0u);
+  std::uniform_int_distribution<int> distribution(-100, 100);
+
+  for (size_t size : std::vector<size_t>{0u, 1u, 3u, 4u, 63u, 64u, 65u, 200u}) {
+    std::vector<Source> values;
+    for (size_t i = 0; i < size; i++) {
+      int value = distribution(engine);
+      if constexpr (std::is_unsigned_v<Source> || std::is_unsigned_v<Dest>) {
+        value = std::abs(value);
+      }
+
+      if constexpr (sizeof(Source) == 1u || sizeof(Dest) == 1u) {
+        value = value % 100;
+      }
+
+      values.push_back(static_cast<Source>(value));
+    }
+
+    ExpectMatchesReference<Source, Dest>(values);
+
+    for (Source limit : limits) {
+      for (size_t position : std::vector<size_t>{0u, size / 2u, size - 1u}) {
+        if (position >= size) {
+          continue;
+        }
+
+        std::vector<Source> with_limit = values;
+        with_limit[position] = limit;
+        ExpectMatchesReference<Source, Dest>(with_limit);
+      }
+    }
+  }
+}
+
+template <typename Source, typename Dest>
+void ExpectIntegersConvert() {
+  std::vector<Source> limits = {std::numeric_limits<Source>::min(),
+                                std::numeric_limits<Source>::max()};
+  if constexpr (sizeof(Dest) < sizeof(Source) || std::is_signed_v<Dest>) {
+    limits.push_back(static_cast<Source>(std::numeric_limits<Dest>::max()));
+    limits.push_back(
+        static_cast<Source>(std::numeric_limits<Dest>::max() + 1ll));
+  }
+  if constexpr (std::is_signed_v<Source>) {
+    limits.push_back(static_cast<Source>(-1));
+  }
+
+  ExpectConverts<Source, Dest>(limits);
+}
+
+template <typename Source>
+void ExpectIntegersConvert() {
+  ExpectIntegersConvert<Source, int8_t>();
+  ExpectIntegersConvert<Source, uint8_t>();
+  ExpectIntegersConvert<Source, int16_t>();
+  ExpectIntegersConvert<Source, uint16_t>();
+  ExpectIntegersConvert<Source, int32_t>();
+  ExpectIntegersConvert<Source, uint32_t>();
+}
+
+TEST(ConvertValues, Integers) {
+  ExpectIntegersConvert<int8_t>();
+  ExpectIntegersConvert<uint8_t>();
+  ExpectIntegersConvert<int16_t>();
+  ExpectIntegersConvert<uint16_t>();
+  ExpectIntegersConvert<int32_t>();
+  ExpectIntegersConvert<uint32_t>();
+}
+
+TEST(ConvertValues, FloatingPoint) {
+  double float_max = std::numeric_limits<float>::max();
+  std::vector<double> limits = {float_max,
+                                -float_max,
+                                std::nextafter(float_max, 0.0),
+                                std::nextafter(float_max, 1e300),
+                                -std::nextafter(float_max, 1e300),
+                                std::numeric_limits<double>::max(),
+                                std::numeric_limits<double>::lowest(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::denorm_min(),
+                                0.1,
+                                -0.0};
+
+  ExpectConverts<double, float>(limits);
+  ExpectConverts<double, double>(limits);
+
+  std::vector<float> float_limits = {
+      std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(),
+      std::numeric_limits<float>::infinity(),
+      std::numeric_limits<float>::quiet_NaN()};
+  ExpectConverts<float, double>(float_limits);
+  ExpectConverts<float, float>(float_limits);
+}
+
+}  // namespace
+}  // namespace plyodine::internal
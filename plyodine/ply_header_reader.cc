@@ -2,16 +2,19 @@
 
 #include <bit>
 #include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <expected>
 #include <ios>
 #include <istream>
 #include <limits>
 #include <optional>
+#include <span>
 #include <string>
 #include <system_error>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -186,8 +189,190 @@ struct is_error_code_enum<ErrorCode> : true_type {};
 namespace plyodine {
 namespace {
 
+// Wraps an `std::istream` in order to count the number of bytes consumed from
+// it.
+class CountingStream final {
+ public:
+  explicit CountingStream(std::istream& stream) : stream_(stream) {}
+
+  CountingStream& get(char& c) {
+    if (stream_.get(c)) {
+      consumed_ += 1u;
+    }
+
+    return *this;
+  }
+
+  int get() {
+    int c = stream_.get();
+    if (c != std::char_traits<char>::eof()) {
+      consumed_ += 1u;
+    }
+
+    return c;
+  }
+
+  int peek() { return stream_.peek(); }
+
+  bool eof() const { return stream_.eof(); }
+  bool fail() const { return stream_.fail(); }
+  explicit operator bool() const { return !stream_.fail(); }
+
+  // Returns the number of bytes that have been consumed from the stream.
+  uintmax_t consumed() const { return consumed_; }
+
+ private:
+  std::istream& stream_;
+  uintmax_t consumed_ = 0u;
+};
+
+// A minimal stand-in for `std::istream` that reads directly from a span of
+// memory without copying.
+class SpanStream final {
+ public:
+  explicit SpanStream(std::span<const std::byte> data)
+      : next_(reinterpret_cast<const char*>(data.data())),
+        end_(next_ + data.size()) {}
+
+  SpanStream& get(char& c) {
+    if (next_ == end_) {
+      eof_ = true;
+      exhausted_ = true;
+    } else {
+      c = *next_++;
+    }
+
+    return *this;
+  }
+
+  int get() {
+    if (next_ == end_) {
+      eof_ = true;
+      exhausted_ = true;
+      return std::char_traits<char>::eof();
+    }
+
+    return std::char_traits<char>::to_int_type(*next_++);
+  }
+
+  int peek() {
+    if (next_ == end_) {
+      exhausted_ = true;
+      return std::char_traits<char>::eof();
+    }
+
+    return std::char_traits<char>::to_int_type(*next_);
+  }
+
+  bool eof() const { return eof_; }
+  bool fail() const { return eof_; }
+  explicit operator bool() const { return !eof_; }
+
+  // Returns true if the end of the span was reached by any read or peek, in
+  // which case the result of parsing may depend on the bytes that follow it.
+  bool exhausted() const { return exhausted_; }
+
+  // Returns the number of bytes that have been consumed from `data`.
+  size_t consumed(std::span<const std::byte> data) const {
+    return static_cast<size_t>(next_ -
+                               reinterpret_cast<const char*>(data.data()));
+  }
+
+ private:
+  const char* next_;
+  const char* end_;
+  bool eof_ = false;
+  bool exhausted_ = false;
+};
+
+// A minimal stand-in for `std::istream` that reads directly from the buffers
+// returned by a `ByteSource` without copying.
+class ByteSourceStream final {
+ public:
+  explicit ByteSourceStream(ByteSource& source) : source_(source) {}
+
+  ByteSourceStream& get(char& c) {
+    if (next_ == end_ && !Advance()) {
+      fail_ = true;
+    } else {
+      c = *next_++;
+      consumed_ += 1u;
+    }
+
+    return *this;
+  }
+
+  int get() {
+    if (next_ == end_ && !Advance()) {
+      fail_ = true;
+      return std::char_traits<char>::eof();
+    }
+
+    consumed_ += 1u;
+    return std::char_traits<char>::to_int_type(*next_++);
+  }
+
+  int peek() {
+    if (next_ == end_ && !Advance()) {
+      return std::char_traits<char>::eof();
+    }
+
+    return std::char_traits<char>::to_int_type(*next_);
+  }
+
+  bool eof() const { return eof_; }
+  bool fail() const { return fail_; }
+  explicit operator bool() const { return !fail_; }
+
+  // Returns the number of bytes that have been consumed from the source.
+  uintmax_t consumed() const { return consumed_; }
+
+  // Returns the error reported by the source, if any.
+  std::error_code error() const { return error_; }
+
+  // Returns the unconsumed bytes of the current buffer to the source.
+  void BackUp() {
+    if (next_ != end_) {
+      source_.BackUp(static_cast<size_t>(end_ - next_));
+      next_ = end_;
+    }
+  }
+
+ private:
+  bool Advance() {
+    if (eof_ || error_) {
+      return false;
+    }
+
+    auto buffer = source_.Next();
+    if (!buffer) {
+      error_ = buffer.error();
+      return false;
+    }
+
+    if (buffer->empty()) {
+      eof_ = true;
+      return false;
+    }
+
+    next_ = reinterpret_cast<const char*>(buffer->data());
+    end_ = next_ + buffer->size();
+
+    return true;
+  }
+
+  ByteSource& source_;
+  const char* next_ = nullptr;
+  const char* end_ = nullptr;
+  uintmax_t consumed_ = 0u;
+  std::error_code error_;
+  bool eof_ = false;
+  bool fail_ = false;
+};
+
+template <typename Stream>
 std::expected<std::string_view, std::error_code> ReadNextLine(
-    std::istream& stream, std::string& storage, std::string_view line_ending) {
+    Stream& stream, std::string& storage, std::string_view line_ending) {
   storage.clear();
 
   char c;
@@ -247,8 +432,8 @@ std::optional<std::string_view> ReadNextToken(std::string_view& line) {
   return result;
 }
 
-std::expected<std::string, std::error_code> ParseMagicString(
-    std::istream& stream) {
+template <typename Stream>
+std::expected<std::string, std::error_code> ParseMagicString(Stream& stream) {
   char c = 0;
   while (stream.get(c)) {
     if (c != ' ' && c != '\t') {
@@ -325,9 +510,9 @@ bool CheckVersion(std::string_view version) {
   return true;
 }
 
+template <typename Stream>
 std::expected<PlyHeader::Format, std::error_code> ParseFormat(
-    std::istream& stream, std::string& storage,
-    const std::string& line_ending) {
+    Stream& stream, std::string& storage, const std::string& line_ending) {
   auto line = ReadNextLine(stream, storage, line_ending);
   if (!line) {
     return std::unexpected(line.error());
@@ -522,13 +707,8 @@ std::expected<PlyHeader::Property, std::error_code> ParseProperty(
   return PlyHeader::Property{std::move(str_name), *data_type};
 }
 
-}  // namespace
-
-std::expected<PlyHeader, std::error_code> ReadPlyHeader(std::istream& stream) {
-  if (!stream) {
-    return std::unexpected(ErrorCode::BAD_STREAM);
-  }
-
+template <typename Stream>
+std::expected<PlyHeader, std::error_code> ParseHeader(Stream& stream) {
   auto line_ending = ParseMagicString(stream);
   if (!line_ending) {
     return std::unexpected(line_ending.error());
@@ -612,7 +792,71 @@ std::expected<PlyHeader, std::error_code> ReadPlyHeader(std::istream& stream) {
                    0u,
                    std::move(comments),
                    std::move(object_info),
-                   std::move(elements)};
+                   std::move(elements),
+                   0u};
+}
+
+}  // namespace
+
+std::expected<PlyHeader, std::error_code> ReadPlyHeader(std::istream& stream) {
+  if (!stream) {
+    return std::unexpected(ErrorCode::BAD_STREAM);
+  }
+
+  CountingStream counting_stream(stream);
+
+  auto result = ParseHeader(counting_stream);
+  if (result) {
+    result->data_offset = counting_stream.consumed();
+  }
+
+  return result;
+}
+
+std::expected<PlyHeader, std::error_code> ReadPlyHeader(
+    std::span<const std::byte> data) {
+  SpanStream stream(data);
+
+  auto result = ParseHeader(stream);
+  if (result) {
+    result->data_offset = stream.consumed(data);
+  }
+
+  return result;
+}
+
+std::expected<std::optional<PlyHeader>, std::error_code> ReadPartialPlyHeader(
+    std::span<const std::byte> data) {
+  SpanStream stream(data);
+
+  auto result = ParseHeader(stream);
+  if (stream.exhausted()) {
+    return std::nullopt;
+  }
+
+  if (!result) {
+    return std::unexpected(result.error());
+  }
+
+  result->data_offset = stream.consumed(data);
+
+  return std::move(*result);
+}
+
+std::expected<PlyHeader, std::error_code> ReadPlyHeader(ByteSource& source) {
+  ByteSourceStream stream(source);
+
+  auto result = ParseHeader(stream);
+  if (stream.error()) {
+    return std::unexpected(stream.error());
+  }
+
+  if (result) {
+    result->data_offset = stream.consumed();
+    stream.BackUp();
+  }
+
+  return result;
 }
 
 }  // namespace plyodine
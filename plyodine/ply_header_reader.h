@@ -1,14 +1,18 @@
 #ifndef _PLYODINE_PLY_HEADER_
 #define _PLYODINE_PLY_HEADER_
 
+#include <cstddef>
 #include <cstdint>
 #include <expected>
 #include <istream>
 #include <optional>
+#include <span>
 #include <string>
 #include <system_error>
 #include <vector>
 
+#include "plyodine/byte_source.h"
+
 namespace plyodine {
 
 // A struct describing the contents of a PLY header.
@@ -75,6 +79,10 @@ struct PlyHeader final {
 
   // An ordered list of the elements described in the header.
   std::vector<Element> elements;
+
+  // The number of bytes of input taken by the header. This is the offset of
+  // the start of the data section from the start of the input.
+  uintmax_t data_offset = 0;
 };
 
 // Reads the PLY header from the input stream.
@@ -87,6 +95,34 @@ struct PlyHeader final {
 // NOTE: Behavior is undefined if `stream` is not a binary stream
 std::expected<PlyHeader, std::error_code> ReadPlyHeader(std::istream& stream);
 
+// Reads the PLY header from the start of a span of memory.
+//
+// On success, the function returns a struct describing the contents of the PLY
+// header, whose `data_offset` is the offset of the start of the data section
+// within `data`. On failure, returns an `std::error_code` containing a non-zero
+// value.
+std::expected<PlyHeader, std::error_code> ReadPlyHeader(
+    std::span<const std::byte> data);
+
+// Reads the PLY header from the start of a span of memory that holds only the
+// part of the input received so far.
+//
+// If the header may continue beyond the end of `data`, returns `std::nullopt`
+// and the header should be read again once more of the input has been
+// received. Otherwise, behaves the same as `ReadPlyHeader` does for a span of
+// memory.
+std::expected<std::optional<PlyHeader>, std::error_code> ReadPartialPlyHeader(
+    std::span<const std::byte> data);
+
+// Reads the PLY header from the buffers returned by `source`.
+//
+// On success, the function returns a struct describing the contents of the PLY
+// header and the bytes following the header are returned to `source` so that
+// the next call to `ByteSource::Next` starts at the data section. On failure,
+// returns an `std::error_code` containing a non-zero value and the source will
+// be left in an undefined state. If the source fails, its error is returned.
+std::expected<PlyHeader, std::error_code> ReadPlyHeader(ByteSource& source);
+
 }  // namespace plyodine
 
 #endif  // _PLYODINE_PLY_HEADER_
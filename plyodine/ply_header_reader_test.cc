@@ -1,13 +1,16 @@
 #include "plyodine/ply_header_reader.h"
 
+#include <cstddef>
 #include <fstream>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 #include <system_error>
 
 #include "googlemock/include/gmock/gmock.h"
 #include "googletest/include/gtest/gtest.h"
+#include "plyodine/byte_source.h"
 #include "tools/cpp/runfiles/runfiles.h"
 
 namespace plyodine {
@@ -635,5 +638,223 @@ TEST(ReadPlyHeader, InvalidCharacters) {
   }
 }
 
+TEST(ReadPlyHeader, Span) {
+  std::string files[] = {
+      "_main/plyodine/test_data/header_valid_mac.ply",
+      "_main/plyodine/test_data/header_valid_unix.ply",
+      "_main/plyodine/test_data/header_valid_windows.ply",
+      "_main/plyodine/test_data/header_valid_with_space.ply"};
+
+  for (const auto& file : files) {
+    std::ifstream input = OpenRunfile(file);
+
+    char c;
+    std::string contents;
+    while (input.get(c)) {
+      contents += c;
+    }
+    contents += "trailing";
+
+    std::stringstream stream(contents, std::ios::in | std::ios::binary);
+    auto expected = ReadPlyHeader(stream);
+    ASSERT_TRUE(expected);
+
+    auto result = ReadPlyHeader(
+        std::as_bytes(std::span(contents.data(), contents.size())));
+    ASSERT_TRUE(result);
+
+    EXPECT_EQ(expected->format, result->format);
+    EXPECT_EQ(expected->line_ending, result->line_ending);
+    EXPECT_EQ(expected->comments, result->comments);
+    EXPECT_EQ(expected->object_info, result->object_info);
+    ASSERT_EQ(expected->elements.size(), result->elements.size());
+    for (size_t i = 0; i < expected->elements.size(); i++) {
+      EXPECT_EQ(expected->elements[i].name, result->elements[i].name);
+      EXPECT_EQ(expected->elements[i].instance_count,
+                result->elements[i].instance_count);
+      EXPECT_EQ(expected->elements[i].properties.size(),
+                result->elements[i].properties.size());
+    }
+
+    EXPECT_EQ(static_cast<size_t>(stream.tellg()), expected->data_offset);
+    EXPECT_EQ(expected->data_offset, result->data_offset);
+    EXPECT_EQ("trailing", contents.substr(result->data_offset));
+  }
+}
+
+TEST(ReadPlyHeader, SpanTruncated) {
+  std::ifstream input =
+      OpenRunfile("_main/plyodine/test_data/header_valid_unix.ply");
+
+  char c;
+  std::string contents;
+  while (input.get(c)) {
+    contents += c;
+  }
+
+  for (size_t i = 0; i < contents.size(); i++) {
+    std::stringstream stream(contents.substr(0u, i),
+                             std::ios::in | std::ios::binary);
+    auto expected = ReadPlyHeader(stream);
+
+    auto result =
+        ReadPlyHeader(std::as_bytes(std::span(contents.data(), i)));
+    ASSERT_EQ(expected.has_value(), result.has_value());
+
+    if (expected) {
+      stream.clear();
+      EXPECT_EQ(static_cast<size_t>(stream.tellg()), expected->data_offset);
+      EXPECT_EQ(expected->data_offset, result->data_offset);
+    } else {
+      EXPECT_EQ(expected.error(), result.error());
+    }
+  }
+}
+
+TEST(ReadPartialPlyHeader, Prefixes) {
+  std::string files[] = {
+      "_main/plyodine/test_data/header_valid_mac.ply",
+      "_main/plyodine/test_data/header_valid_unix.ply",
+      "_main/plyodine/test_data/header_valid_windows.ply"};
+
+  for (const auto& file : files) {
+    std::ifstream input = OpenRunfile(file);
+
+    char c;
+    std::string contents;
+    while (input.get(c)) {
+      contents += c;
+    }
+
+    auto header = ReadPlyHeader(
+        std::as_bytes(std::span(contents.data(), contents.size())));
+    ASSERT_TRUE(header);
+
+    // The data section of a file with carriage return line endings could
+    // start with a line feed, so its header is only known to be complete once
+    // it is followed by anything else
+    contents += "x";
+
+    for (size_t i = 0; i < contents.size(); i++) {
+      auto result =
+          ReadPartialPlyHeader(std::as_bytes(std::span(contents.data(), i)));
+      ASSERT_TRUE(result);
+
+      if (i < header->data_offset) {
+        EXPECT_FALSE(*result);
+      } else {
+        ASSERT_TRUE(*result);
+        EXPECT_EQ(header->data_offset, (*result)->data_offset);
+        EXPECT_EQ(header->line_ending, (*result)->line_ending);
+        EXPECT_EQ(header->elements.size(), (*result)->elements.size());
+      }
+    }
+  }
+}
+
+TEST(ReadPartialPlyHeader, Errors) {
+  std::string contents = "ply\nformat bad 1.0\nelement vertex 1\n";
+
+  auto expected = ReadPlyHeader(
+      std::as_bytes(std::span(contents.data(), contents.size())));
+  ASSERT_FALSE(expected);
+
+  // The error is reported once the line containing it has ended
+  auto result =
+      ReadPartialPlyHeader(std::as_bytes(std::span(contents.data(), 15u)));
+  ASSERT_TRUE(result);
+  EXPECT_FALSE(*result);
+
+  for (size_t i = 20u; i < contents.size(); i++) {
+    result = ReadPartialPlyHeader(std::as_bytes(std::span(contents.data(), i)));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(expected.error(), result.error());
+  }
+}
+
+std::string ReadRemaining(ByteSource& source) {
+  std::string result;
+  for (;;) {
+    auto buffer = source.Next();
+    if (!buffer || buffer->empty()) {
+      return result;
+    }
+
+    result.append(reinterpret_cast<const char*>(buffer->data()),
+                  buffer->size());
+  }
+}
+
+TEST(ReadPlyHeader, ByteSource) {
+  std::ifstream input =
+      OpenRunfile("_main/plyodine/test_data/header_valid_windows.ply");
+
+  char c;
+  std::string contents;
+  while (input.get(c)) {
+    contents += c;
+  }
+  contents += "trailing";
+
+  std::span<const std::byte> data =
+      std::as_bytes(std::span(contents.data(), contents.size()));
+  auto expected = ReadPlyHeader(data);
+  ASSERT_TRUE(expected);
+
+  for (size_t block_size : {1u, 3u, 64u, 65536u}) {
+    std::stringstream stream(contents, std::ios::in | std::ios::binary);
+    StreamByteSource source(stream, block_size);
+
+    auto result = ReadPlyHeader(source);
+    ASSERT_TRUE(result);
+
+    EXPECT_EQ(expected->format, result->format);
+    EXPECT_EQ(expected->line_ending, result->line_ending);
+    EXPECT_EQ(expected->comments, result->comments);
+    EXPECT_EQ(expected->object_info, result->object_info);
+    ASSERT_EQ(expected->elements.size(), result->elements.size());
+    EXPECT_EQ(expected->data_offset, result->data_offset);
+    EXPECT_EQ(contents.substr(result->data_offset), ReadRemaining(source));
+  }
+}
+
+TEST(ReadPlyHeader, ByteSourceTruncated) {
+  std::ifstream input =
+      OpenRunfile("_main/plyodine/test_data/header_valid_unix.ply");
+
+  char c;
+  std::string contents;
+  while (input.get(c)) {
+    contents += c;
+  }
+
+  for (size_t i = 0; i < contents.size(); i++) {
+    std::span<const std::byte> data =
+        std::as_bytes(std::span(contents.data(), i));
+    auto expected = ReadPlyHeader(data);
+
+    SpanByteSource source(std::as_bytes(std::span(contents.data(), i)));
+    auto result = ReadPlyHeader(source);
+    ASSERT_EQ(expected.has_value(), result.has_value());
+
+    if (expected) {
+      EXPECT_EQ(expected->data_offset, result->data_offset);
+    } else {
+      EXPECT_EQ(expected.error(), result.error());
+    }
+  }
+}
+
+TEST(ReadPlyHeader, ByteSourceFails) {
+  std::stringstream stream("ply\nformat ascii 1.0\n",
+                           std::ios::in | std::ios::binary);
+  stream.setstate(std::ios::badbit);
+
+  StreamByteSource source(stream);
+  auto result = ReadPlyHeader(source);
+  ASSERT_FALSE(result);
+  EXPECT_EQ(std::io_errc::stream, result.error());
+}
+
 }  // namespace
 }  // namespace plyodine
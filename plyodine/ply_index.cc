@@ -0,0 +1,494 @@
+#include "plyodine/ply_index.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <spanstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "plyodine/internal/binary_layout.h"
+#include "plyodine/internal/mapped_file.h"
+#include "plyodine/ply_header_reader.h"
+
+namespace {
+
+enum class ErrorCode {
+  MIN_VALUE = 1,
+  BAD_STREAM = 1,
+  INVALID_STRIDE = 2,
+  UNEXPECTED_EOF = 3,
+  NEGATIVE_LIST_SIZE = 4,
+  MALFORMED_INDEX = 5,
+  MISMATCHED_INDEX = 6,
+  MAX_VALUE = 6,
+};
+
+static class ErrorCategory final : public std::error_category {
+  const char* name() const noexcept override;
+  std::string message(int condition) const override;
+  std::error_condition default_error_condition(
+      int value) const noexcept override;
+} kErrorCategory;
+
+const char* ErrorCategory::name() const noexcept {
+  return "plyodine::PlyIndex";
+}
+
+std::string ErrorCategory::message(int condition) const {
+  ErrorCode error_code{condition};
+  switch (error_code) {
+    case ErrorCode::BAD_STREAM:
+      return "The stream was not in 'good' state";
+    case ErrorCode::INVALID_STRIDE:
+      return "The stride of an index must be greater than zero";
+    case ErrorCode::UNEXPECTED_EOF:
+      return "The input ended earlier than expected";
+    case ErrorCode::NEGATIVE_LIST_SIZE:
+      return "The input contained a property list with a negative size";
+    case ErrorCode::MALFORMED_INDEX:
+      return "The index was malformed";
+    case ErrorCode::MISMATCHED_INDEX:
+      return "The index does not describe the input";
+  };
+
+  return "Unknown Error";
+}
+
+std::error_condition ErrorCategory::default_error_condition(
+    int value) const noexcept {
+  if (value < static_cast<int>(ErrorCode::MIN_VALUE) ||
+      value > static_cast<int>(ErrorCode::MAX_VALUE)) {
+    return std::error_condition(value, *this);
+  }
+
+  return std::make_error_condition(std::errc::invalid_argument);
+}
+
+std::error_code make_error_code(ErrorCode code) {
+  return std::error_code(static_cast<int>(code), kErrorCategory);
+}
+
+}  // namespace
+
+namespace std {
+
+template <>
+struct is_error_code_enum<ErrorCode> : true_type {};
+
+}  // namespace std
+
+namespace plyodine {
+namespace {
+
+constexpr std::string_view kMagicLine = "plyindex 1";
+
+// Returns the size of the smallest possible binary instance of `element`. If
+// `fixed_size` is set, every instance of `element` has this size.
+uintmax_t MinimumBinaryInstanceSize(const PlyHeader::Element& element,
+                                    bool& fixed_size) {
+  fixed_size = true;
+
+  uintmax_t result = 0u;
+  for (const PlyHeader::Property& property : element.properties) {
+    if (property.list_type) {
+      result += internal::GetBinarySize(*property.list_type);
+      fixed_size = false;
+    } else {
+      result += internal::GetBinarySize(property.data_type);
+    }
+  }
+
+  return result;
+}
+
+// The layout of a property of a binary element. For lists, `size` is the size
+// of each entry of the list.
+struct BinaryProperty final {
+  std::optional<PlyHeader::Property::Type> list_type;
+  uintmax_t list_size_size;
+  uintmax_t size;
+};
+
+std::error_code IndexBinaryElement(const PlyHeader::Element& element,
+                                   PlyHeader::Format format,
+                                   std::span<const std::byte> data,
+                                   uintmax_t stride, uintmax_t& offset,
+                                   PlyIndex::Element& result) {
+  bool fixed_size;
+  uintmax_t instance_size = MinimumBinaryInstanceSize(element, fixed_size);
+
+  if (fixed_size) {
+    uintmax_t element_size =
+        internal::SaturatingMultiply(element.instance_count, instance_size);
+    if (data.size() - offset < element_size) {
+      return ErrorCode::UNEXPECTED_EOF;
+    }
+
+    // Instances that take no bytes of the input are never checkpointed, which
+    // also bounds the number of checkpoints by the size of the input
+    if (instance_size != 0u && element.instance_count != 0u) {
+      uintmax_t checkpoint_size =
+          internal::SaturatingMultiply(stride, instance_size);
+      uintmax_t num_checkpoints = (element.instance_count - 1u) / stride;
+      for (uintmax_t i = 0; i < num_checkpoints; i++) {
+        offset += checkpoint_size;
+        result.checkpoints.push_back(offset);
+      }
+    }
+
+    offset = result.offset + element_size;
+
+    return std::error_code();
+  }
+
+  bool swap_bytes = (format == PlyHeader::Format::BINARY_BIG_ENDIAN) !=
+                    (std::endian::native == std::endian::big);
+
+  std::vector<BinaryProperty> properties;
+  for (const PlyHeader::Property& property : element.properties) {
+    properties.emplace_back(
+        property.list_type,
+        property.list_type ? internal::GetBinarySize(*property.list_type) : 0u,
+        internal::GetBinarySize(property.data_type));
+  }
+
+  for (uintmax_t instance = 0; instance < element.instance_count;
+       instance++) {
+    if (instance != 0u && instance % stride == 0u) {
+      result.checkpoints.push_back(offset);
+    }
+
+    for (const BinaryProperty& property : properties) {
+      uintmax_t size = property.size;
+      if (property.list_type) {
+        if (data.size() - offset < property.list_size_size) {
+          return ErrorCode::UNEXPECTED_EOF;
+        }
+
+        uintmax_t list_size;
+        if (!internal::ReadListSize(data.data() + offset, *property.list_type,
+                                    swap_bytes, list_size)) {
+          return ErrorCode::NEGATIVE_LIST_SIZE;
+        }
+
+        offset += property.list_size_size;
+        size = internal::SaturatingMultiply(list_size, size);
+      }
+
+      if (data.size() - offset < size) {
+        return ErrorCode::UNEXPECTED_EOF;
+      }
+
+      offset += size;
+    }
+  }
+
+  return std::error_code();
+}
+
+std::error_code IndexASCIIElement(const PlyHeader::Element& element,
+                                  char line_terminator,
+                                  std::span<const std::byte> data,
+                                  uintmax_t stride, uintmax_t& offset,
+                                  PlyIndex::Element& result) {
+  const char* begin = reinterpret_cast<const char*>(data.data());
+  for (uintmax_t instance = 0; instance < element.instance_count;
+       instance++) {
+    if (instance != 0u && instance % stride == 0u) {
+      result.checkpoints.push_back(offset);
+    }
+
+    if (offset == data.size()) {
+      return ErrorCode::UNEXPECTED_EOF;
+    }
+
+    // The last line of the input is not required to be terminated
+    const char* line_end = static_cast<const char*>(
+        std::memchr(begin + offset, line_terminator,
+                    static_cast<size_t>(data.size() - offset)));
+    if (!line_end) {
+      offset = data.size();
+    } else {
+      offset = static_cast<uintmax_t>(line_end - begin) + 1u;
+    }
+  }
+
+  return std::error_code();
+}
+
+template <std::unsigned_integral T>
+bool ParseValue(std::string_view token, T& value) {
+  const char* end = token.data() + token.size();
+  std::from_chars_result result = std::from_chars(token.data(), end, value);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+// Splits `line` into exactly `tokens.size()` space separated tokens.
+bool Tokenize(std::string_view line, std::span<std::string_view> tokens) {
+  for (std::string_view& token : tokens) {
+    size_t token_end = line.find(' ');
+    token = line.substr(0u, token_end);
+    if (token.empty()) {
+      return false;
+    }
+
+    line.remove_prefix(token.size());
+    if (!line.empty()) {
+      line.remove_prefix(1u);
+      if (line.empty()) {
+        return false;
+      }
+    }
+  }
+
+  return line.empty();
+}
+
+bool ReadField(std::istream& stream, std::string& line, std::string_view name,
+               uintmax_t& value) {
+  if (!std::getline(stream, line)) {
+    return false;
+  }
+
+  std::string_view tokens[2];
+  return Tokenize(line, tokens) && tokens[0] == name &&
+         ParseValue(tokens[1], value);
+}
+
+}  // namespace
+
+std::expected<PlyIndex, std::error_code> BuildPlyIndex(
+    std::span<const std::byte> data, uintmax_t stride) {
+  if (stride == 0u) {
+    return std::unexpected(ErrorCode::INVALID_STRIDE);
+  }
+
+  auto header = ReadPlyHeader(data);
+  if (!header) {
+    return std::unexpected(header.error());
+  }
+
+  PlyIndex index;
+  index.data_offset = header->data_offset;
+  index.stride = stride;
+
+  uintmax_t offset = header->data_offset;
+  for (const PlyHeader::Element& element : header->elements) {
+    PlyIndex::Element& result = index.elements.emplace_back();
+    result.name = element.name;
+    result.instance_count = element.instance_count;
+    result.offset = offset;
+
+    std::error_code error;
+    if (header->format == PlyHeader::Format::ASCII) {
+      error = IndexASCIIElement(element, header->line_ending.back(), data,
+                                stride, offset, result);
+    } else {
+      error = IndexBinaryElement(element, header->format, data, stride, offset,
+                                 result);
+    }
+
+    if (error) {
+      return std::unexpected(error);
+    }
+  }
+
+  index.end_offset = offset;
+
+  return index;
+}
+
+std::expected<PlyIndex, std::error_code> BuildPlyIndex(
+    const std::filesystem::path& path, uintmax_t stride) {
+  auto file = internal::MappedFile::Open(path);
+  if (!file) {
+    return std::unexpected(file.error());
+  }
+
+  return BuildPlyIndex(file->data(), stride);
+}
+
+std::error_code WritePlyIndex(const PlyIndex& index, std::ostream& stream) {
+  if (!stream) {
+    return std::io_errc::stream;
+  }
+
+  stream << kMagicLine << '\n';
+  stream << "data_offset " << index.data_offset << '\n';
+  stream << "end_offset " << index.end_offset << '\n';
+  stream << "stride " << index.stride << '\n';
+
+  for (const PlyIndex::Element& element : index.elements) {
+    stream << "element " << element.name << ' ' << element.instance_count
+           << ' ' << element.offset << ' ' << element.checkpoints.size()
+           << '\n';
+    for (uintmax_t checkpoint : element.checkpoints) {
+      stream << checkpoint << '\n';
+    }
+  }
+
+  if (!stream) {
+    return std::io_errc::stream;
+  }
+
+  return std::error_code();
+}
+
+std::error_code WritePlyIndex(const PlyIndex& index,
+                              const std::filesystem::path& path) {
+  // The reason a stream failed is unknown, so failures are reported as
+  // `std::errc::io_error`.
+  std::ofstream stream(path, std::ios::out | std::ios::binary);
+  if (WritePlyIndex(index, stream)) {
+    return std::make_error_code(std::errc::io_error);
+  }
+
+  stream.close();
+  if (!stream) {
+    return std::make_error_code(std::errc::io_error);
+  }
+
+  return std::error_code();
+}
+
+std::expected<PlyIndex, std::error_code> ReadPlyIndex(std::istream& stream) {
+  if (!stream) {
+    return std::unexpected(ErrorCode::BAD_STREAM);
+  }
+
+  PlyIndex index;
+
+  std::string line;
+  if (!std::getline(stream, line) || line != kMagicLine ||
+      !ReadField(stream, line, "data_offset", index.data_offset) ||
+      !ReadField(stream, line, "end_offset", index.end_offset) ||
+      !ReadField(stream, line, "stride", index.stride)) {
+    return std::unexpected(ErrorCode::MALFORMED_INDEX);
+  }
+
+  while (std::getline(stream, line)) {
+    std::string_view tokens[5];
+    if (!Tokenize(line, tokens) || tokens[0] != "element") {
+      return std::unexpected(ErrorCode::MALFORMED_INDEX);
+    }
+
+    PlyIndex::Element& element = index.elements.emplace_back();
+    element.name = tokens[1];
+
+    uintmax_t num_checkpoints;
+    if (!ParseValue(tokens[2], element.instance_count) ||
+        !ParseValue(tokens[3], element.offset) ||
+        !ParseValue(tokens[4], num_checkpoints)) {
+      return std::unexpected(ErrorCode::MALFORMED_INDEX);
+    }
+
+    for (uintmax_t i = 0; i < num_checkpoints; i++) {
+      uintmax_t& checkpoint = element.checkpoints.emplace_back();
+      if (!std::getline(stream, line) || !ParseValue(line, checkpoint)) {
+        return std::unexpected(ErrorCode::MALFORMED_INDEX);
+      }
+    }
+  }
+
+  if (!stream.eof()) {
+    return std::unexpected(ErrorCode::BAD_STREAM);
+  }
+
+  return index;
+}
+
+std::expected<PlyIndex, std::error_code> ReadPlyIndex(
+    const std::filesystem::path& path) {
+  auto file = internal::MappedFile::Open(path);
+  if (!file) {
+    return std::unexpected(file.error());
+  }
+
+  std::span<const std::byte> data = file->data();
+  std::ispanstream stream(std::span<const char>(
+      reinterpret_cast<const char*>(data.data()), data.size()));
+  return ReadPlyIndex(stream);
+}
+
+std::error_code ValidatePlyIndex(const PlyIndex& index, const PlyHeader& header,
+                                 uintmax_t input_size) {
+  if (index.stride == 0u) {
+    return ErrorCode::INVALID_STRIDE;
+  }
+
+  if (index.data_offset != header.data_offset ||
+      index.elements.size() != header.elements.size() ||
+      index.end_offset > input_size) {
+    return ErrorCode::MISMATCHED_INDEX;
+  }
+
+  uintmax_t offset = index.data_offset;
+  for (size_t i = 0; i < header.elements.size(); i++) {
+    const PlyHeader::Element& element = header.elements[i];
+    const PlyIndex::Element& indexed = index.elements[i];
+
+    // ASCII instances are only known to be non-empty if they are terminated
+    bool fixed_size = false;
+    uintmax_t instance_size = 0u;
+    if (header.format != PlyHeader::Format::ASCII) {
+      instance_size = MinimumBinaryInstanceSize(element, fixed_size);
+    }
+
+    uintmax_t num_checkpoints = 0u;
+    if (element.instance_count != 0u &&
+        (header.format == PlyHeader::Format::ASCII || instance_size != 0u)) {
+      num_checkpoints = (element.instance_count - 1u) / index.stride;
+    }
+
+    if (indexed.name != element.name ||
+        indexed.instance_count != element.instance_count ||
+        indexed.offset != offset ||
+        indexed.checkpoints.size() != num_checkpoints) {
+      return ErrorCode::MISMATCHED_INDEX;
+    }
+
+    uintmax_t next_offset =
+        (i + 1u < index.elements.size()) ? index.elements[i + 1u].offset
+                                         : index.end_offset;
+
+    uintmax_t remaining = element.instance_count;
+    for (size_t j = 0; j <= indexed.checkpoints.size(); j++) {
+      uintmax_t end = (j < indexed.checkpoints.size()) ? indexed.checkpoints[j]
+                                                       : next_offset;
+      uintmax_t num_instances = std::min(remaining, index.stride);
+      remaining -= num_instances;
+
+      uintmax_t min_size =
+          internal::SaturatingMultiply(num_instances, instance_size);
+      if (end < offset || end - offset < min_size ||
+          (fixed_size && end - offset != min_size)) {
+        return ErrorCode::MISMATCHED_INDEX;
+      }
+
+      offset = end;
+    }
+  }
+
+  if (offset != index.end_offset) {
+    return ErrorCode::MISMATCHED_INDEX;
+  }
+
+  return std::error_code();
+}
+
+}  // namespace plyodine
@@ -0,0 +1,103 @@
+#ifndef _PLYODINE_PLY_INDEX_
+#define _PLYODINE_PLY_INDEX_
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine {
+
+// A struct describing the locations of the elements in the data section of a
+// PLY input. An index allows the elements of an input to be located without
+// scanning the data that precedes them and allows elements containing
+// property lists to be parsed on multiple threads.
+//
+// All offsets are in bytes from the start of the input.
+struct PlyIndex final {
+  // A struct describing the location of an element.
+  struct Element final {
+    // The name of the element.
+    std::string name;
+
+    // The number of instances of the element.
+    uintmax_t instance_count;
+
+    // The offset of the first instance of the element.
+    uintmax_t offset;
+
+    // The offsets of instances `stride`, `2 * stride`, `3 * stride`, and so on
+    // of the element. Empty for binary elements with no properties, whose
+    // instances take no bytes of the input.
+    std::vector<uintmax_t> checkpoints;
+  };
+
+  // The offset of the start of the data section.
+  uintmax_t data_offset;
+
+  // The offset of the end of the last element of the data section.
+  uintmax_t end_offset;
+
+  // The number of instances between consecutive checkpoints.
+  uintmax_t stride;
+
+  // An ordered list of the elements of the input.
+  std::vector<Element> elements;
+};
+
+// Builds an index of the PLY input contained in `data` with a checkpoint every
+// `stride` instances of each element.
+//
+// The data section is only scanned for the structure of the input. For binary
+// inputs, this means the sizes of property lists are read but their values are
+// not and for ASCII inputs each line is assumed to contain one instance. As a
+// result, an input that can be indexed may still fail to parse.
+std::expected<PlyIndex, std::error_code> BuildPlyIndex(
+    std::span<const std::byte> data, uintmax_t stride = 65536u);
+
+// Builds an index of the PLY file at `path`. Where supported, the file is
+// memory mapped rather than read through a stream.
+//
+// Errors opening or reading the file are reported using `std::generic_category`
+// and are `std::errc::io_error` when the reason is unknown. This is also true
+// of the other overloads taking a path below.
+std::expected<PlyIndex, std::error_code> BuildPlyIndex(
+    const std::filesystem::path& path, uintmax_t stride = 65536u);
+
+// Serializes `index` to `stream` in a compact text format that can be read
+// back with `ReadPlyIndex`. On failure, returns an `std::error_code`
+// containing a non-zero value.
+std::error_code WritePlyIndex(const PlyIndex& index, std::ostream& stream);
+
+// Serializes `index` to the file at `path` which is typically stored alongside
+// the input it indexes. Errors are reported as for `BuildPlyIndex`.
+std::error_code WritePlyIndex(const PlyIndex& index,
+                              const std::filesystem::path& path);
+
+// Reads an index previously written by `WritePlyIndex`.
+std::expected<PlyIndex, std::error_code> ReadPlyIndex(std::istream& stream);
+
+// Reads an index previously written by `WritePlyIndex` from the file at
+// `path`. Errors opening or reading the file are reported as for
+// `BuildPlyIndex`.
+std::expected<PlyIndex, std::error_code> ReadPlyIndex(
+    const std::filesystem::path& path);
+
+// Checks that `index` is consistent with an input of `input_size` bytes
+// described by `header`. This catches indices that are malformed or that were
+// built from a different version of the input without scanning the data
+// section, but cannot detect every change to the contents of the input.
+std::error_code ValidatePlyIndex(const PlyIndex& index, const PlyHeader& header,
+                                 uintmax_t input_size);
+
+}  // namespace plyodine
+
+#endif  // _PLYODINE_PLY_INDEX_
@@ -0,0 +1,336 @@
+#include "plyodine/ply_index.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine {
+namespace {
+
+std::span<const std::byte> AsBytes(const std::string& data) {
+  return std::as_bytes(std::span(data.data(), data.size()));
+}
+
+template <typename T>
+void Append(std::string& output, T value, std::endian endianness) {
+  if (endianness != std::endian::native) {
+    if constexpr (sizeof(T) == 2u) {
+      value = std::bit_cast<T>(std::byteswap(std::bit_cast<uint16_t>(value)));
+    } else if constexpr (sizeof(T) == 4u) {
+      value = std::bit_cast<T>(std::byteswap(std::bit_cast<uint32_t>(value)));
+    }
+  }
+
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  output.append(bytes, sizeof(T));
+}
+
+// Returns a binary input with 10 vertices made of three floats followed by 7
+// faces with between zero and six vertex indices. The offsets of the faces are
+// appended to `face_offsets` along with the offset of the end of the data.
+std::string MakeBinaryInput(std::endian endianness,
+                            std::vector<uintmax_t>& face_offsets) {
+  std::string result = "ply\rformat ";
+  result += (endianness == std::endian::big) ? "binary_big_endian"
+                                             : "binary_little_endian";
+  result +=
+      " 1.0\relement vertex 10\rproperty float x\rproperty float y\r"
+      "property float z\relement face 7\rproperty ushort flags\r"
+      "property list short int vertex_indices\rend_header\r";
+
+  for (int i = 0; i < 30; i++) {
+    Append(result, static_cast<float>(i), endianness);
+  }
+
+  for (int16_t i = 0; i < 7; i++) {
+    face_offsets.push_back(result.size());
+    Append(result, static_cast<uint16_t>(i), endianness);
+    Append(result, i, endianness);
+    for (int32_t j = 0; j < i; j++) {
+      Append(result, j, endianness);
+    }
+  }
+
+  face_offsets.push_back(result.size());
+
+  return result;
+}
+
+void ExpectBinaryIndex(std::endian endianness) {
+  std::vector<uintmax_t> face_offsets;
+  std::string input = MakeBinaryInput(endianness, face_offsets);
+
+  auto index = BuildPlyIndex(AsBytes(input), 3u);
+  ASSERT_TRUE(index) << index.error().message();
+
+  uintmax_t data_offset = face_offsets.front() - 120u;
+  EXPECT_EQ(data_offset, index->data_offset);
+  EXPECT_EQ(input.size(), index->end_offset);
+  EXPECT_EQ(3u, index->stride);
+
+  ASSERT_EQ(2u, index->elements.size());
+  EXPECT_EQ("vertex", index->elements[0].name);
+  EXPECT_EQ(10u, index->elements[0].instance_count);
+  EXPECT_EQ(data_offset, index->elements[0].offset);
+  EXPECT_EQ(std::vector<uintmax_t>(
+                {data_offset + 36u, data_offset + 72u, data_offset + 108u}),
+            index->elements[0].checkpoints);
+
+  EXPECT_EQ("face", index->elements[1].name);
+  EXPECT_EQ(7u, index->elements[1].instance_count);
+  EXPECT_EQ(face_offsets[0], index->elements[1].offset);
+  EXPECT_EQ(std::vector<uintmax_t>({face_offsets[3], face_offsets[6]}),
+            index->elements[1].checkpoints);
+
+  auto header = ReadPlyHeader(AsBytes(input));
+  ASSERT_TRUE(header);
+  EXPECT_FALSE(ValidatePlyIndex(*index, *header, input.size()));
+}
+
+TEST(BuildPlyIndex, BigEndian) { ExpectBinaryIndex(std::endian::big); }
+
+TEST(BuildPlyIndex, LittleEndian) { ExpectBinaryIndex(std::endian::little); }
+
+TEST(BuildPlyIndex, ASCII) {
+  std::string header =
+      "ply\r\nformat ascii 1.0\r\nelement vertex 4\r\nproperty int x\r\n"
+      "element face 3\r\nproperty list uchar int vertex_indices\r\n"
+      "element empty 0\r\nend_header\r\n";
+  std::string input = header + "1\r\n2\r\n3\r\n4\r\n0\r\n1 1\r\n2 1 2";
+
+  auto index = BuildPlyIndex(AsBytes(input), 2u);
+  ASSERT_TRUE(index) << index.error().message();
+
+  EXPECT_EQ(header.size(), index->data_offset);
+  EXPECT_EQ(input.size(), index->end_offset);
+
+  ASSERT_EQ(3u, index->elements.size());
+  EXPECT_EQ(header.size(), index->elements[0].offset);
+  EXPECT_EQ(std::vector<uintmax_t>({header.size() + 6u}),
+            index->elements[0].checkpoints);
+  EXPECT_EQ(header.size() + 12u, index->elements[1].offset);
+  EXPECT_EQ(std::vector<uintmax_t>({header.size() + 20u}),
+            index->elements[1].checkpoints);
+  EXPECT_EQ(input.size(), index->elements[2].offset);
+  EXPECT_TRUE(index->elements[2].checkpoints.empty());
+}
+
+TEST(BuildPlyIndex, InvalidStride) {
+  std::string input =
+      "ply\nformat ascii 1.0\nelement vertex 1\nproperty int x\nend_header\n"
+      "1\n";
+  EXPECT_EQ("The stride of an index must be greater than zero",
+            BuildPlyIndex(AsBytes(input), 0u).error().message());
+}
+
+TEST(BuildPlyIndex, BadHeader) {
+  std::string input = "ply\nformat ascii 2.0\n";
+  std::span<const std::byte> data = AsBytes(input);
+  EXPECT_EQ(ReadPlyHeader(data).error(), BuildPlyIndex(data).error());
+}
+
+TEST(BuildPlyIndex, Truncated) {
+  std::vector<uintmax_t> face_offsets;
+  std::string input = MakeBinaryInput(std::endian::little, face_offsets);
+
+  for (size_t size = face_offsets.front() - 120u; size < input.size();
+       size++) {
+    EXPECT_EQ("The input ended earlier than expected",
+              BuildPlyIndex(AsBytes(input.substr(0u, size))).error().message());
+  }
+
+  std::string ascii =
+      "ply\nformat ascii 1.0\nelement vertex 2\nproperty int x\nend_header\n"
+      "1\n";
+  EXPECT_EQ("The input ended earlier than expected",
+            BuildPlyIndex(AsBytes(ascii)).error().message());
+}
+
+TEST(BuildPlyIndex, NegativeListSize) {
+  std::string input =
+      "ply\nformat binary_little_endian 1.0\nelement face 1\n"
+      "property list char int vertex_indices\nend_header\n\xff";
+  EXPECT_EQ("The input contained a property list with a negative size",
+            BuildPlyIndex(AsBytes(input)).error().message());
+}
+
+TEST(BuildPlyIndex, ElementWithNoProperties) {
+  for (const char* count : {"1000000000000", "18446744073709551615"}) {
+    std::string input = "ply\nformat binary_little_endian 1.0\nelement empty ";
+    input += count;
+    input += "\nelement vertex 2\nproperty uchar x\nend_header\n\x01\x02";
+
+    auto header = ReadPlyHeader(AsBytes(input));
+    ASSERT_TRUE(header);
+
+    for (uintmax_t stride : {uintmax_t(1u), uintmax_t(3u),
+                             std::numeric_limits<uintmax_t>::max()}) {
+      auto index = BuildPlyIndex(AsBytes(input), stride);
+      ASSERT_TRUE(index);
+      ASSERT_EQ(2u, index->elements.size());
+      EXPECT_TRUE(index->elements[0].checkpoints.empty());
+      EXPECT_EQ(header->data_offset, index->elements[1].offset);
+      EXPECT_EQ(input.size(), index->end_offset);
+      EXPECT_FALSE(ValidatePlyIndex(*index, *header, input.size()));
+    }
+  }
+}
+
+TEST(BuildPlyIndex, MissingFile) {
+  auto result = BuildPlyIndex(std::filesystem::path("/nonexistent/file.ply"));
+  ASSERT_FALSE(result);
+  EXPECT_EQ(std::errc::no_such_file_or_directory, result.error());
+  EXPECT_EQ(std::generic_category(), result.error().category());
+}
+
+TEST(WritePlyIndex, RoundTrip) {
+  std::vector<uintmax_t> face_offsets;
+  std::string input = MakeBinaryInput(std::endian::little, face_offsets);
+
+  auto index = BuildPlyIndex(AsBytes(input), 2u);
+  ASSERT_TRUE(index);
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  ASSERT_FALSE(WritePlyIndex(*index, stream));
+
+  auto result = ReadPlyIndex(stream);
+  ASSERT_TRUE(result) << result.error().message();
+  EXPECT_EQ(index->data_offset, result->data_offset);
+  EXPECT_EQ(index->end_offset, result->end_offset);
+  EXPECT_EQ(index->stride, result->stride);
+  ASSERT_EQ(index->elements.size(), result->elements.size());
+  for (size_t i = 0; i < index->elements.size(); i++) {
+    EXPECT_EQ(index->elements[i].name, result->elements[i].name);
+    EXPECT_EQ(index->elements[i].instance_count,
+              result->elements[i].instance_count);
+    EXPECT_EQ(index->elements[i].offset, result->elements[i].offset);
+    EXPECT_EQ(index->elements[i].checkpoints, result->elements[i].checkpoints);
+  }
+}
+
+TEST(WritePlyIndex, RoundTripFile) {
+  std::vector<uintmax_t> face_offsets;
+  std::string input = MakeBinaryInput(std::endian::little, face_offsets);
+
+  auto index = BuildPlyIndex(AsBytes(input), 2u);
+  ASSERT_TRUE(index);
+
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "round_trip.plyindex";
+  ASSERT_FALSE(WritePlyIndex(*index, path));
+
+  auto result = ReadPlyIndex(path);
+  ASSERT_TRUE(result) << result.error().message();
+  EXPECT_EQ(index->data_offset, result->data_offset);
+  EXPECT_EQ(index->end_offset, result->end_offset);
+  EXPECT_EQ(index->stride, result->stride);
+  ASSERT_EQ(index->elements.size(), result->elements.size());
+  for (size_t i = 0; i < index->elements.size(); i++) {
+    EXPECT_EQ(index->elements[i].checkpoints, result->elements[i].checkpoints);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(WritePlyIndex, BadStream) {
+  std::stringstream stream(std::ios::out | std::ios::binary);
+  stream.clear(std::ios::badbit);
+  EXPECT_EQ(std::io_errc::stream, WritePlyIndex(PlyIndex{}, stream));
+}
+
+TEST(WritePlyIndex, MissingDirectory) {
+  std::error_code error = WritePlyIndex(
+      PlyIndex{}, std::filesystem::path("/nonexistent/file.plyindex"));
+  EXPECT_EQ(std::errc::io_error, error);
+  EXPECT_EQ(std::generic_category(), error.category());
+}
+
+TEST(ReadPlyIndex, BadStream) {
+  std::stringstream stream(std::ios::in | std::ios::binary);
+  stream.clear(std::ios::badbit);
+  EXPECT_EQ("The stream was not in 'good' state",
+            ReadPlyIndex(stream).error().message());
+}
+
+TEST(ReadPlyIndex, Malformed) {
+  const std::string prefix =
+      "plyindex 1\ndata_offset 10\nend_offset 20\nstride 2\n";
+  for (const std::string& contents :
+       {std::string(""), std::string("plyindex 2\n"),
+        std::string("plyindex 1\ndata_offset 10\n"),
+        std::string("plyindex 1\ndata_offset -1\nend_offset 20\nstride 2\n"),
+        std::string("plyindex 1\ndata_offset 10 \nend_offset 20\nstride 2\n"),
+        std::string("plyindex 1\nend_offset 20\ndata_offset 10\nstride 2\n"),
+        prefix + "element vertex 3 10\n",
+        prefix + "element vertex 3 10 1\n",
+        prefix + "element vertex 3 10 1\nabc\n",
+        prefix + "element  vertex 3 10 0\n",
+        prefix + "vertex vertex 3 10 0\n",
+        prefix + "element vertex 3 10 0 0\n"}) {
+    std::stringstream stream(contents, std::ios::in | std::ios::binary);
+    EXPECT_EQ("The index was malformed", ReadPlyIndex(stream).error().message())
+        << contents;
+  }
+}
+
+TEST(ReadPlyIndex, MissingFile) {
+  auto result = ReadPlyIndex(std::filesystem::path("/nonexistent/file.plyindex"));
+  ASSERT_FALSE(result);
+  EXPECT_EQ(std::errc::no_such_file_or_directory, result.error());
+  EXPECT_EQ(std::generic_category(), result.error().category());
+}
+
+TEST(ValidatePlyIndex, Mismatched) {
+  std::vector<uintmax_t> face_offsets;
+  std::string input = MakeBinaryInput(std::endian::little, face_offsets);
+
+  auto header = ReadPlyHeader(AsBytes(input));
+  ASSERT_TRUE(header);
+
+  auto index = BuildPlyIndex(AsBytes(input), 3u);
+  ASSERT_TRUE(index);
+  ASSERT_FALSE(ValidatePlyIndex(*index, *header, input.size()));
+
+  PlyIndex zero_stride = *index;
+  zero_stride.stride = 0u;
+  EXPECT_EQ("The stride of an index must be greater than zero",
+            ValidatePlyIndex(zero_stride, *header, input.size()).message());
+
+  std::vector<PlyIndex> mismatched(11u, *index);
+  mismatched[0].data_offset += 1u;
+  mismatched[1].end_offset += 1u;
+  mismatched[2].stride = 2u;
+  mismatched[3].elements.pop_back();
+  mismatched[4].elements[0].name = "face";
+  mismatched[5].elements[1].instance_count += 1u;
+  mismatched[6].elements[1].offset -= 1u;
+  mismatched[7].elements[0].checkpoints[1] += 1u;
+  mismatched[8].elements[1].checkpoints.pop_back();
+  std::swap(mismatched[9].elements[1].checkpoints[0],
+            mismatched[9].elements[1].checkpoints[1]);
+  mismatched[10].elements[1].checkpoints[0] = face_offsets[0] + 1u;
+
+  for (const PlyIndex& index : mismatched) {
+    EXPECT_EQ("The index does not describe the input",
+              ValidatePlyIndex(index, *header, input.size()).message());
+  }
+
+  EXPECT_EQ("The index does not describe the input",
+            ValidatePlyIndex(*index, *header, input.size() - 1u).message());
+}
+
+}  // namespace
+}  // namespace plyodine
@@ -0,0 +1,64 @@
+#ifndef _PLYODINE_PLY_PUSH_READER_
+#define _PLYODINE_PLY_PUSH_READER_
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <system_error>
+
+#include "plyodine/ply_reader.h"
+
+namespace plyodine {
+
+// Reads a PLY file that arrives in pieces, such as from a socket, without
+// first buffering the entire input. Each piece is passed to `Feed` as it
+// arrives and `Finish` is called once the input has ended.
+//
+// The input is parsed with the same rules and dispatched to the same callbacks
+// of `reader` as `PlyReader::ReadFrom` would for the concatenation of every
+// chunk. Parsing never waits for more input. Instead, the push reader keeps its
+// place in the input between calls and holds on to only the bytes of the
+// header or of the instance that is still incomplete. Callbacks are invoked
+// from within `Feed` and `Finish` on the calling thread and the data section is
+// always parsed on that thread alone.
+//
+// Errors and exceptions thrown by callbacks propagate out of the call to `Feed`
+// or `Finish` that invoked them. After an exception, the push reader must not
+// be used for anything other than being destroyed.
+class PlyPushReader final {
+ public:
+  // `reader` must outlive the push reader and must not be used to read any
+  // other input until the push reader has finished or has been destroyed.
+  explicit PlyPushReader(PlyReader& reader);
+
+  // If `Finish` has not been called, abandons the input without invoking any
+  // further callbacks.
+  ~PlyPushReader();
+
+  PlyPushReader(const PlyPushReader&) = delete;
+  PlyPushReader& operator=(const PlyPushReader&) = delete;
+
+  // Parses the bytes of `chunk` as the continuation of the input. Returns once
+  // every byte of `chunk` has been parsed or copied, after which the caller may
+  // reuse its storage. Instances whose encoding extends into later chunks are
+  // dispatched by a later call to `Feed` or `Finish`.
+  //
+  // If parsing fails or the data section ends, returns the same
+  // `std::error_code` as `Finish` and any further input is ignored. Otherwise,
+  // returns an `std::error_code` containing a zero value.
+  std::error_code Feed(std::span<const std::byte> chunk);
+
+  // Signals the end of the input and parses whatever remains of it. Returns
+  // the same `std::error_code` as `PlyReader::ReadFrom` would have for the
+  // input fed so far, which is non-zero if the input ended before the end of
+  // its data section.
+  std::error_code Finish();
+
+ private:
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
+}  // namespace plyodine
+
+#endif  // _PLYODINE_PLY_PUSH_READER_
@@ -0,0 +1,277 @@
+#include "plyodine/ply_push_reader.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+#include "plyodine/ply_reader.h"
+
+namespace plyodine {
+namespace {
+
+class ValueCollectingPlyReader final : public PlyReader {
+ public:
+  std::vector<uint32_t> values;
+  std::vector<std::vector<uint16_t>> lists;
+  std::vector<std::thread::id> threads;
+  std::optional<uint32_t> throw_on;
+
+ private:
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    callbacks["vertex"]["a"] = UIntPropertyCallback([this](uint32_t value) {
+      if (value == throw_on) {
+        throw std::runtime_error("callback failed");
+      }
+
+      values.push_back(value);
+      threads.push_back(std::this_thread::get_id());
+      return std::error_code();
+    });
+    callbacks["vertex"]["b"] =
+        UShortPropertyListCallback([this](std::span<const uint16_t> value) {
+          lists.emplace_back(value.begin(), value.end());
+          return std::error_code();
+        });
+    return std::error_code();
+  }
+};
+
+std::string MakeInput(const std::string& format, uint32_t num_instances,
+                      bool has_lists = true) {
+  std::string result = "ply\nformat " + format + " 1.0\nelement vertex " +
+                       std::to_string(num_instances) + "\nproperty uint a\n";
+  if (has_lists) {
+    result += "property list uchar ushort b\n";
+  }
+  result += "end_header\n";
+
+  std::endian endianness =
+      format == "binary_big_endian" ? std::endian::big : std::endian::little;
+  auto append = [&](auto value) {
+    if (format == "ascii") {
+      result += std::to_string(value) + " ";
+      return;
+    }
+
+    if (endianness != std::endian::native) {
+      value = std::byteswap(value);
+    }
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  for (uint32_t i = 0; i < num_instances; i++) {
+    append(i);
+    if (has_lists) {
+      append(static_cast<uint8_t>(i % 7u));
+      for (uint32_t j = 0; j < i % 7u; j++) {
+        append(static_cast<uint16_t>(i + j));
+      }
+    }
+
+    if (format == "ascii") {
+      result.back() = '\n';
+    }
+  }
+
+  return result;
+}
+
+std::span<const std::byte> AsBytes(const std::string& string) {
+  return std::as_bytes(std::span(string.data(), string.size()));
+}
+
+// Feeds `input` in chunks of `chunk_size` bytes, returning the first error
+// returned by `Feed` or the result of `Finish`
+std::error_code FeedInChunks(PlyReader& reader, const std::string& input,
+                             size_t chunk_size) {
+  PlyPushReader push_reader(reader);
+
+  std::span<const std::byte> bytes = AsBytes(input);
+  for (size_t offset = 0u; offset < bytes.size(); offset += chunk_size) {
+    size_t size = std::min(chunk_size, bytes.size() - offset);
+    if (std::error_code error = push_reader.Feed(bytes.subspan(offset, size));
+        error) {
+      EXPECT_EQ(error, push_reader.Finish());
+      return error;
+    }
+  }
+
+  return push_reader.Finish();
+}
+
+TEST(PlyPushReader, MatchesReadFrom) {
+  for (const char* format :
+       {"ascii", "binary_big_endian", "binary_little_endian"}) {
+    std::string input = MakeInput(format, 2000u);
+
+    ValueCollectingPlyReader expected;
+    ASSERT_EQ(0, expected.ReadFrom(AsBytes(input)).value());
+
+    for (size_t chunk_size : {1u, 3u, 64u, 4096u, 100000u, 10000000u}) {
+      ValueCollectingPlyReader actual;
+      EXPECT_EQ(0, FeedInChunks(actual, input, chunk_size).value());
+      EXPECT_EQ(expected.values, actual.values);
+      EXPECT_EQ(expected.lists, actual.lists);
+    }
+  }
+}
+
+TEST(PlyPushReader, MatchesReadFromFixedSize) {
+  for (const char* format : {"binary_big_endian", "binary_little_endian"}) {
+    std::string input = MakeInput(format, 2000u, /*has_lists=*/false);
+
+    ValueCollectingPlyReader expected;
+    ASSERT_EQ(0, expected.ReadFrom(AsBytes(input)).value());
+
+    for (size_t chunk_size : {1u, 3u, 4u, 4096u, 10000000u}) {
+      ValueCollectingPlyReader actual;
+      EXPECT_EQ(0, FeedInChunks(actual, input, chunk_size).value());
+      EXPECT_EQ(expected.values, actual.values);
+    }
+  }
+}
+
+TEST(PlyPushReader, LineEndings) {
+  for (const char* line_ending : {"\r", "\r\n"}) {
+    std::string input;
+    for (char c : MakeInput("ascii", 200u)) {
+      if (c == '\n') {
+        input += line_ending;
+      } else {
+        input += c;
+      }
+    }
+
+    ValueCollectingPlyReader expected;
+    ASSERT_EQ(0, expected.ReadFrom(AsBytes(input)).value());
+
+    for (size_t chunk_size : {1u, 2u, 3u, 64u, 10000000u}) {
+      ValueCollectingPlyReader actual;
+      EXPECT_EQ(0, FeedInChunks(actual, input, chunk_size).value());
+      EXPECT_EQ(expected.values, actual.values);
+      EXPECT_EQ(expected.lists, actual.lists);
+    }
+  }
+}
+
+TEST(PlyPushReader, Truncated) {
+  for (const char* format :
+       {"ascii", "binary_big_endian", "binary_little_endian"}) {
+    std::string input = MakeInput(format, 1000u);
+
+    for (size_t size : {0u, 5u, 60u, 100u, 1000u, 2000u}) {
+      std::string truncated = input.substr(0u, size);
+
+      ValueCollectingPlyReader expected;
+      std::error_code expected_error = expected.ReadFrom(AsBytes(truncated));
+      ASSERT_NE(0, expected_error.value());
+
+      for (size_t chunk_size : {1u, 7u, 4096u}) {
+        ValueCollectingPlyReader actual;
+        EXPECT_EQ(expected_error, FeedInChunks(actual, truncated, chunk_size));
+        EXPECT_EQ(expected.values, actual.values);
+        EXPECT_EQ(expected.lists, actual.lists);
+      }
+    }
+  }
+}
+
+TEST(PlyPushReader, FeedReturnsErrors) {
+  std::string input = "ply\nformat bad 1.0\nend_header\n";
+
+  ValueCollectingPlyReader expected;
+  std::error_code expected_error = expected.ReadFrom(AsBytes(input));
+  ASSERT_NE(0, expected_error.value());
+
+  ValueCollectingPlyReader reader;
+  PlyPushReader push_reader(reader);
+  EXPECT_EQ(expected_error, push_reader.Feed(AsBytes(input)));
+  EXPECT_EQ(expected_error, push_reader.Feed(AsBytes(input)));
+  EXPECT_EQ(expected_error, push_reader.Finish());
+  EXPECT_EQ(expected_error, push_reader.Feed(AsBytes(input)));
+}
+
+TEST(PlyPushReader, IgnoresTrailingInput) {
+  std::string input = MakeInput("binary_little_endian", 100u);
+
+  ValueCollectingPlyReader reader;
+  PlyPushReader push_reader(reader);
+  EXPECT_EQ(0, push_reader.Feed(AsBytes(input)).value());
+  EXPECT_EQ(100u, reader.values.size());
+
+  EXPECT_EQ(0, push_reader.Feed(AsBytes(std::string("trailing"))).value());
+  EXPECT_EQ(0, push_reader.Finish().value());
+  EXPECT_EQ(100u, reader.values.size());
+}
+
+TEST(PlyPushReader, ParsesAsInputArrives) {
+  for (const char* format :
+       {"ascii", "binary_big_endian", "binary_little_endian"}) {
+    std::string input = MakeInput(format, 1000u);
+    size_t half = input.size() / 2u;
+
+    ValueCollectingPlyReader reader;
+    PlyPushReader push_reader(reader);
+    EXPECT_EQ(0, push_reader.Feed(AsBytes(input.substr(0u, half))).value());
+
+    size_t num_values = reader.values.size();
+    EXPECT_LT(0u, num_values);
+    EXPECT_GT(1000u, num_values);
+
+    EXPECT_EQ(0, push_reader.Feed(AsBytes(input.substr(half))).value());
+    EXPECT_EQ(0, push_reader.Finish().value());
+    EXPECT_EQ(1000u, reader.values.size());
+
+    // Callbacks run on the thread feeding the input
+    for (const std::thread::id& thread : reader.threads) {
+      EXPECT_EQ(std::this_thread::get_id(), thread);
+    }
+  }
+}
+
+TEST(PlyPushReader, CallbackThrows) {
+  std::string input = MakeInput("binary_little_endian", 100u);
+
+  ValueCollectingPlyReader reader;
+  reader.throw_on = 50u;
+  {
+    PlyPushReader push_reader(reader);
+    EXPECT_THROW(push_reader.Feed(AsBytes(input)), std::runtime_error);
+  }
+
+  EXPECT_EQ(50u, reader.values.size());
+
+  // The reader can be used again once the push reader is destroyed
+  reader.throw_on.reset();
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  EXPECT_EQ(150u, reader.values.size());
+}
+
+TEST(PlyPushReader, DestroyedWithoutFinish) {
+  std::string input = MakeInput("ascii", 100u);
+
+  ValueCollectingPlyReader reader;
+  {
+    PlyPushReader push_reader(reader);
+    EXPECT_EQ(0, push_reader.Feed(AsBytes(input.substr(0u, 200u))).value());
+  }
+
+  EXPECT_LT(reader.values.size(), 100u);
+}
+
+}  // namespace
+}  // namespace plyodine
@@ -1,13 +1,20 @@
 #include "plyodine/ply_reader.h"
 
+#include <algorithm>
 #include <array>
 #include <bit>
-#include <charconv>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <format>
+#include <functional>
 #include <ios>
+#include <istream>
+#include <limits>
 #include <map>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
@@ -15,10 +22,21 @@
 #include <system_error>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "plyodine/byte_source.h"
+#include "plyodine/internal/ascii_scanner.h"
+#include "plyodine/internal/binary_layout.h"
+#include "plyodine/internal/byte_swap.h"
+#include "plyodine/internal/mapped_file.h"
+#include "plyodine/internal/number_parser.h"
+#include "plyodine/internal/thread_pool.h"
+#include "plyodine/internal/value_converter.h"
 #include "plyodine/ply_header_reader.h"
+#include "plyodine/ply_index.h"
+#include "plyodine/ply_push_reader.h"
 
 namespace plyodine {
 namespace {
@@ -42,9 +60,20 @@ enum class ErrorType : uint8_t {
   OUT_OF_RANGE = 9,
   OVERFLOW = 10,
   UNDERFLOW = 11,
-  MAX_VALUE = 11,
+  MISMATCHED_INDEX = 12,
+  MAX_VALUE = 12,
 };
 
+// Maps the index of a batch callback in PropertyCallback to the index of the
+// non-list callback of the same type. Other indices are returned unchanged.
+size_t ToNonBatchIndex(size_t callback_index) {
+  if (callback_index >= 16u) {
+    return 2u * (callback_index - 16u);
+  }
+
+  return callback_index;
+}
+
 bool IsInvalidConversion(size_t source, size_t dest) {
   return (source & 0x1u) != (dest & 0x1u) ||
          ((source >> 1u) < 6 && (dest >> 1u) >= 6) ||
@@ -230,6 +259,11 @@ std::optional<std::pair<ErrorType, uint8_t>> DecodeError(int error) {
         return std::nullopt;
       }
       break;
+    case ErrorType::MISMATCHED_INDEX:
+      if (payload != 0) {
+        return std::nullopt;
+      }
+      break;
     default:
       return std::nullopt;
   }
@@ -484,6 +518,9 @@ std::string ErrorCategory::message(int condition) const {
       case ErrorType::UNDERFLOW:
         return OverflowedUnderflowedMessage("underflowed",
                                             std::get<1>(*decoded));
+      case ErrorType::MISMATCHED_INDEX:
+        return "The data section of the input did not match the offsets "
+               "recorded in its index";
     }
   }
 
@@ -521,6 +558,20 @@ std::error_code MakeUnexpectedEofNoProperties() {
   return std::error_code(value, kErrorCategory);
 }
 
+// Returns the error for an input that ends before an instance of `element`.
+std::error_code MakeUnexpectedEof(const PlyHeader::Element& element) {
+  if (element.properties.empty()) {
+    return MakeUnexpectedEofNoProperties();
+  }
+
+  const PlyHeader::Property& property = element.properties.front();
+  if (property.list_type) {
+    return MakeUnexpectedEof(EntryType::LIST_SIZE, *property.list_type);
+  }
+
+  return MakeUnexpectedEof(EntryType::VALUE, property.data_type);
+}
+
 std::error_code MakeMismatchedLineEndings() {
   int value = EncodeError(ErrorType::MISMATCHED_LINE_ENDINGS, 0);
   return std::error_code(value, kErrorCategory);
@@ -539,6 +590,11 @@ std::error_code MakeMissingToken(EntryType entry_type,
   return std::error_code(value, kErrorCategory);
 }
 
+std::error_code MakeMismatchedIndex() {
+  int value = EncodeError(ErrorType::MISMATCHED_INDEX, 0);
+  return std::error_code(value, kErrorCategory);
+}
+
 std::error_code MakeUnusedToken() {
   int value = EncodeError(ErrorType::UNUSED_TOKEN, 0);
   return std::error_code(value, kErrorCategory);
@@ -600,14 +656,65 @@ PlyHeader::Property::Type GetDataType() {
   }
 }
 
+// Returns the smallest number of bytes that the data section of a binary input
+// described by `header` can contain (the size of the data section if every
+// property list in the input were to be empty).
+uintmax_t MinimumBinaryDataSize(const PlyHeader& header) {
+  uintmax_t result = 0;
+  for (const PlyHeader::Element& element : header.elements) {
+    uintmax_t instance_size = 0;
+    for (const PlyHeader::Property& property : element.properties) {
+      instance_size += internal::GetBinarySize(
+          property.list_type.value_or(property.data_type));
+    }
+
+    result = internal::SaturatingAdd(
+        result,
+        internal::SaturatingMultiply(instance_size, element.instance_count));
+  }
+
+  return result;
+}
+
+// Returns the smallest number of bytes that an instance of `element` can
+// occupy in an ASCII input including its line ending. Each property requires
+// at least one character and a separator.
+uintmax_t MinimumASCIIInstanceSize(const PlyHeader::Element& element,
+                                   std::string_view line_ending) {
+  uintmax_t num_properties = element.properties.size();
+  return line_ending.size() + (num_properties ? 2u * num_properties - 1u : 0u);
+}
+
+// Returns the smallest number of bytes that the data section of an ASCII input
+// described by `header` can contain.
+uintmax_t MinimumASCIIDataSize(const PlyHeader& header) {
+  uintmax_t result = 0;
+  for (const PlyHeader::Element& element : header.elements) {
+    result = internal::SaturatingAdd(
+        result,
+        internal::SaturatingMultiply(
+            MinimumASCIIInstanceSize(element, header.line_ending),
+            element.instance_count));
+  }
+
+  // The final line of the input may omit its line ending
+  return result - std::min<uintmax_t>(result, header.line_ending.size());
+}
+
 using ContextData =
     std::tuple<int8_t, std::vector<int8_t>, uint8_t, std::vector<uint8_t>,
                int16_t, std::vector<int16_t>, uint16_t, std::vector<uint16_t>,
                int32_t, std::vector<int32_t>, uint32_t, std::vector<uint32_t>,
                float, std::vector<float>, double, std::vector<double>>;
 
+using ValueLists =
+    std::tuple<std::vector<int8_t>, std::vector<uint8_t>, std::vector<int16_t>,
+               std::vector<uint16_t>, std::vector<int32_t>,
+               std::vector<uint32_t>, std::vector<float>, std::vector<double>>;
+
 struct Context final {
   ContextData data;
+  ValueLists unconverted;
   std::string_view line_ending;
   std::string storage;
   std::string_view line;
@@ -615,67 +722,468 @@ struct Context final {
   bool eof = false;
 };
 
-using AppendFunc = void (*)(Context&);
+// The values of consecutive element instances that have been read and
+// converted ahead of being handled. Values and list entries are stored in input
+// order in the vector for their destination type.
+struct ParsedValues final {
+  ValueLists values;
+  std::vector<uint32_t> list_sizes;
+
+  void clear() {
+    std::apply([](auto&... vectors) { (vectors.clear(), ...); }, values);
+    list_sizes.clear();
+  }
+};
+
+// The position of the next value to restore from a `ParsedValues`.
+struct ParsedValuesCursor final {
+  std::array<size_t, 8> values = {};
+  size_t list_sizes = 0u;
+};
+
+// A buffer over the data section of the input. When reading from a stream, the
+// data is read in large blocks instead of one value at a time and in order to
+// leave the stream positioned at the end of the data section once parsing
+// completes, the buffer never requests more bytes from the stream than the
+// data section is known to still contain. When reading from memory, the data
+// is decoded in place. When reading from a `ByteSource`, the data is decoded in
+// place from each buffer returned by the source and only the bytes of values
+// that straddle two buffers are copied.
+class InputBuffer final {
+ public:
+  InputBuffer(std::istream& stream, uintmax_t min_bytes_remaining)
+      : stream_(&stream), min_bytes_remaining_(min_bytes_remaining) {}
+
+  explicit InputBuffer(std::span<const std::byte> data)
+      : next_(reinterpret_cast<const char*>(data.data())),
+        end_(next_ + data.size()) {}
+
+  explicit InputBuffer(ByteSource& source) : source_(&source) {}
+
+  // Informs the buffer that the data section contains at least `num_bytes`
+  // more bytes than was previously known.
+  void Expect(uintmax_t num_bytes) {
+    min_bytes_remaining_ =
+        internal::SaturatingAdd(min_bytes_remaining_, num_bytes);
+  }
+
+  // Informs the buffer that the data section contains at least `num_bytes`
+  // more bytes starting from the current position of the input.
+  void ExpectAtLeast(uintmax_t num_bytes) {
+    size_t buffered = static_cast<size_t>(end_ - next_);
+    if (num_bytes > buffered) {
+      min_bytes_remaining_ =
+          std::max(min_bytes_remaining_, num_bytes - buffered);
+    }
+  }
+
+  // Returns the bytes of the input that are currently buffered. The view
+  // remains valid until the next non-const call on the buffer.
+  std::string_view Peek() const {
+    return std::string_view(next_, static_cast<size_t>(end_ - next_));
+  }
+
+  // Advances the input by `size` bytes. `size` must not exceed the number of
+  // bytes currently buffered.
+  void Skip(size_t size) { next_ += size; }
+
+  // Advances the input by `size` bytes without copying them. Returns false if
+  // the input ended first in which case `eof` indicates the reason for the
+  // failure.
+  bool Discard(uintmax_t size);
+
+  // Reads from the stream until at least `size` bytes are buffered. Returns
+  // false if the bytes could not be read in which case `eof` indicates the
+  // reason for the failure. Any bytes already buffered are retained even if
+  // this fails.
+  bool Fill(size_t size);
+
+  // Copies the next `size` bytes of the input into `dest`. Returns false if
+  // the bytes could not be read in which case `eof` indicates the reason for
+  // the failure.
+  bool Read(void* dest, size_t size) {
+    if (static_cast<size_t>(end_ - next_) < size) {
+      return Refill(dest, size);
+    }
+
+    std::memcpy(dest, next_, size);
+    next_ += size;
+
+    return true;
+  }
+
+  // Copies up to `size` bytes of the input into `dest` and returns the number
+  // of bytes copied. Fewer than `size` bytes are copied only if the input
+  // could not be read in which case `eof` indicates the reason for the
+  // failure.
+  size_t ReadSome(void* dest, size_t size) {
+    if (static_cast<size_t>(end_ - next_) < size) {
+      Fill(size);
+    }
+
+    size_t available = std::min(size, static_cast<size_t>(end_ - next_));
+    std::memcpy(dest, next_, available);
+    next_ += available;
+
+    return available;
+  }
+
+  // Returns a pointer to the next `size` bytes of the input and advances past
+  // them. The pointer remains valid until the next call on the buffer. Returns
+  // nullptr if fewer than `size` bytes could be read in which case no input is
+  // consumed.
+  const char* ReadInPlace(size_t size) {
+    if (static_cast<size_t>(end_ - next_) < size && !Fill(size)) {
+      return nullptr;
+    }
+
+    const char* result = next_;
+    next_ += size;
+
+    return result;
+  }
+
+  // Returns true if the input is read from memory rather than a stream.
+  bool in_memory() const { return !stream_ && !source_; }
+
+  // Returns true if the end of the input has been reached. If a read fails
+  // and this returns false, the underlying stream encountered an error.
+  bool eof() const {
+    if (source_) {
+      return !source_error_;
+    }
+
+    return !stream_ || stream_->eof();
+  }
+
+  // Returns the error reported by the byte source, if any.
+  std::error_code source_error() const { return source_error_; }
+
+  // Returns the bytes taken from the byte source but not yet consumed to the
+  // source so that it is left positioned after the consumed input.
+  void BackUpSource();
+
+ private:
+  bool Refill(void* dest, size_t size);
+  bool FillFromSource(size_t size);
+  bool DiscardFromSource(uintmax_t size);
+  bool NextBuffer();
+
+  static constexpr size_t kBlockSize = 64u * 1024u;
+
+  std::istream* stream_ = nullptr;
+  std::vector<char> storage_;
+  const char* next_ = nullptr;
+  const char* end_ = nullptr;
+  uintmax_t min_bytes_remaining_ = 0;
+
+  // When reading from a byte source, the buffer most recently returned by the
+  // source and the number of its bytes that have been taken. While
+  // `in_place_` is false, `next_` and `end_` point into `storage_`, the last
+  // `copied_from_buffer_` bytes of which are copies of the bytes of `buffer_`
+  // that precede `buffer_offset_`.
+  ByteSource* source_ = nullptr;
+  std::span<const std::byte> buffer_;
+  size_t buffer_offset_ = 0u;
+  size_t copied_from_buffer_ = 0u;
+  bool in_place_ = true;
+  std::error_code source_error_;
+};
+
+bool InputBuffer::Fill(size_t size) {
+  if (source_) {
+    return FillFromSource(size);
+  }
+
+  if (!stream_) {
+    return false;
+  }
+
+  size_t buffered = static_cast<size_t>(end_ - next_);
+  if (buffered != 0 && next_ != storage_.data()) {
+    std::memmove(storage_.data(), next_, buffered);
+  }
+
+  size_t needed = size - buffered;
+
+  size_t block_size = kBlockSize;
+  if (min_bytes_remaining_ < block_size) {
+    block_size = static_cast<size_t>(min_bytes_remaining_);
+  }
+
+  if (block_size < needed) {
+    block_size = needed;
+  }
+
+  if (storage_.size() < buffered + block_size) {
+    storage_.resize(buffered + block_size);
+  }
+
+  stream_->read(storage_.data() + buffered,
+                static_cast<std::streamsize>(block_size));
+  size_t bytes_read = static_cast<size_t>(stream_->gcount());
+
+  if (bytes_read < min_bytes_remaining_) {
+    min_bytes_remaining_ -= bytes_read;
+  } else {
+    min_bytes_remaining_ = 0;
+  }
+
+  next_ = storage_.data();
+  end_ = next_ + buffered + bytes_read;
+
+  return bytes_read >= needed;
+}
+
+bool InputBuffer::Discard(uintmax_t size) {
+  size_t buffered = static_cast<size_t>(end_ - next_);
+  if (size <= buffered) {
+    next_ += size;
+    return true;
+  }
+
+  next_ = end_;
+  size -= buffered;
+
+  if (source_) {
+    return DiscardFromSource(size);
+  }
+
+  if (!stream_) {
+    return false;
+  }
+
+  stream_->ignore(static_cast<std::streamsize>(size));
+  uintmax_t bytes_ignored = static_cast<uintmax_t>(stream_->gcount());
+
+  if (bytes_ignored < min_bytes_remaining_) {
+    min_bytes_remaining_ -= bytes_ignored;
+  } else {
+    min_bytes_remaining_ = 0;
+  }
+
+  return bytes_ignored == size;
+}
+
+bool InputBuffer::Refill(void* dest, size_t size) {
+  if (!Fill(size)) {
+    next_ = end_;
+    return false;
+  }
+
+  std::memcpy(dest, next_, size);
+  next_ += size;
+
+  return true;
+}
+
+bool InputBuffer::FillFromSource(size_t size) {
+  size_t buffered = static_cast<size_t>(end_ - next_);
+
+  // Once each byte copied from an earlier buffer has been consumed, reading
+  // returns to the current buffer of the source
+  if (!in_place_ && buffered <= copied_from_buffer_) {
+    const char* buffer = reinterpret_cast<const char*>(buffer_.data());
+    next_ = buffer + buffer_offset_ - buffered;
+    end_ = buffer + buffer_.size();
+    buffer_offset_ = buffer_.size();
+    in_place_ = true;
+
+    buffered = static_cast<size_t>(end_ - next_);
+    if (buffered >= size) {
+      return true;
+    }
+  }
+
+  if (in_place_) {
+    if (buffered == 0u) {
+      if (!NextBuffer()) {
+        return false;
+      }
+
+      next_ = reinterpret_cast<const char*>(buffer_.data());
+      end_ = next_ + buffer_.size();
+      buffer_offset_ = buffer_.size();
+
+      buffered = buffer_.size();
+      if (buffered >= size) {
+        return true;
+      }
+    }
+
+    storage_.assign(next_, end_);
+    copied_from_buffer_ = buffered;
+    in_place_ = false;
+  } else if (next_ != storage_.data()) {
+    storage_.erase(storage_.begin(),
+                   storage_.begin() + (next_ - storage_.data()));
+  }
+
+  // At least as many bytes as are already buffered are taken from each buffer
+  // so that searching for the end of a long line copies each of its bytes only
+  // a bounded number of times
+  bool filled = true;
+  while (storage_.size() < size) {
+    if (buffer_offset_ == buffer_.size() && !NextBuffer()) {
+      filled = false;
+      break;
+    }
+
+    size_t available = buffer_.size() - buffer_offset_;
+    size_t count =
+        std::min(available, std::max(size - storage_.size(), storage_.size()));
+
+    const char* begin =
+        reinterpret_cast<const char*>(buffer_.data()) + buffer_offset_;
+    storage_.insert(storage_.end(), begin, begin + count);
+    buffer_offset_ += count;
+    copied_from_buffer_ += count;
+  }
+
+  next_ = storage_.data();
+  end_ = next_ + storage_.size();
+
+  return filled;
+}
+
+bool InputBuffer::DiscardFromSource(uintmax_t size) {
+  for (;;) {
+    size_t available = buffer_.size() - buffer_offset_;
+    if (size <= available) {
+      const char* buffer = reinterpret_cast<const char*>(buffer_.data());
+      next_ = buffer + buffer_offset_ + size;
+      end_ = buffer + buffer_.size();
+      buffer_offset_ = buffer_.size();
+      in_place_ = true;
+      return true;
+    }
+
+    size -= available;
+
+    if (!NextBuffer()) {
+      return false;
+    }
+  }
+}
+
+bool InputBuffer::NextBuffer() {
+  // The previous buffer is invalidated by the call to `Next`
+  buffer_ = std::span<const std::byte>();
+  buffer_offset_ = 0u;
+  copied_from_buffer_ = 0u;
+
+  if (source_error_) {
+    return false;
+  }
+
+  auto buffer = source_->Next();
+  if (!buffer) {
+    source_error_ = buffer.error();
+    return false;
+  }
+
+  buffer_ = *buffer;
+
+  return !buffer_.empty();
+}
+
+void InputBuffer::BackUpSource() {
+  size_t buffered = static_cast<size_t>(end_ - next_);
+
+  size_t unconsumed = buffer_.size() - buffer_offset_;
+  if (in_place_ || buffered <= copied_from_buffer_) {
+    unconsumed += buffered;
+  }
+
+  if (unconsumed != 0u) {
+    source_->BackUp(unconsumed);
+  }
+}
+
+using ColumnConvertFunc = std::error_code (*)(const char*, size_t, size_t,
+                                               Context&, ParsedValues&,
+                                               size_t&);
 using ConvertFunc = std::error_code (*)(Context&, EntryType);
+using ColumnHandler = std::move_only_function<std::error_code(
+    uintmax_t, const ParsedValues&, size_t, size_t)>;
 using Handler = std::move_only_function<std::error_code(Context&)>;
 using OnConversionErrorFunc = std::move_only_function<std::error_code(
     const std::string&, const std::string&, std::error_code)>;
-using ReadFunc = std::error_code (*)(std::istream&, Context&, EntryType);
+using ParseFunc = std::error_code (*)(InputBuffer&, Context&, uint32_t, bool&);
+using ReadFunc = std::error_code (*)(InputBuffer&, Context&, EntryType);
+using RestoreFunc = void (*)(const ParsedValues&, bool, ParsedValuesCursor&,
+                             Context&);
+using SaveFunc = void (*)(Context&, bool, ParsedValues&);
 
-std::error_code ReadNextLine(std::istream& stream, Context& context,
+std::error_code ReadNextLine(InputBuffer& input, Context& context,
                              std::error_code end_of_file_error) {
   std::string_view line_ending = context.line_ending;
 
-  context.storage.clear();
-  context.eof = true;
+  // The number of characters of the line known to be printable or tabs
+  size_t length = 0;
+  bool has_tabs = false;
+  context.eof = false;
 
-  char c;
-  while (stream.get(c)) {
-    if (c == line_ending[0]) {
-      line_ending.remove_prefix(1);
+  for (;;) {
+    std::string_view buffered = input.Peek();
 
-      while (!line_ending.empty()) {
-        if (!stream.get(c) || c != line_ending[0]) {
-          return MakeMismatchedLineEndings();
-        }
+    const char* end = buffered.data() + buffered.size();
+    const char* position =
+        internal::FindLineEnd(buffered.data() + length, end, has_tabs);
 
-        line_ending.remove_prefix(1);
+    length = static_cast<size_t>(position - buffered.data());
+
+    if (position == end) {
+      if (input.Fill(buffered.size() + 1u)) {
+        continue;
       }
 
-      context.eof = false;
-      break;
-    }
+      if (!input.eof()) {
+        return std::io_errc::stream;
+      }
 
-    if (c == '\r' || c == '\n') {
-      return MakeMismatchedLineEndings();
+      context.eof = true;
+      break;
     }
 
-    if (c == '\t') {
-      c = ' ';
-    }
+    if (*position != line_ending[0]) {
+      if (*position == '\r' || *position == '\n') {
+        return MakeMismatchedLineEndings();
+      }
 
-    if (!std::isprint(c)) {
       return MakeInvalidCharacter();
     }
 
-    if (c == ' ') {
-      if (context.storage.empty() || context.storage.back() == ' ') {
-        continue;
+    if (line_ending.size() > 1u) {
+      if (length + 1u == buffered.size() && !input.Fill(buffered.size() + 1u)) {
+        return MakeMismatchedLineEndings();
+      }
+
+      if (input.Peek()[length + 1u] != line_ending[1]) {
+        return MakeMismatchedLineEndings();
       }
     }
 
-    context.storage.push_back(c);
+    break;
   }
 
-  if (stream.fail() && !stream.eof()) {
-    return std::io_errc::stream;
+  context.line = input.Peek().substr(0u, length);
+  if (has_tabs) {
+    context.storage = context.line;
+    for (char& c : context.storage) {
+      if (c == '\t') {
+        c = ' ';
+      }
+    }
+
+    context.line = context.storage;
   }
 
-  if (context.storage.empty() && context.eof) {
+  if (context.eof && context.line.find_first_not_of(' ') == std::string::npos) {
     return end_of_file_error;
   }
 
-  context.line = context.storage;
+  input.Skip(context.eof ? length : length + line_ending.size());
 
   return std::error_code();
 }
@@ -683,27 +1191,17 @@ std::error_code ReadNextLine(std::istream& stream, Context& context,
 std::error_code ReadNextToken(Context& context, bool is_float,
                               std::error_code missing_token_error,
                               std::error_code end_of_line_error) {
-  size_t prefix_length = context.line.find_first_not_of(' ');
-  if (prefix_length == std::string_view::npos) {
+  context.token = internal::NextToken(context.line);
+  if (context.token.empty()) {
     return context.eof ? end_of_line_error : missing_token_error;
   }
 
-  context.line.remove_prefix(prefix_length);
-
-  size_t token_length = context.line.find(' ');
-  if (token_length == std::string::npos) {
-    token_length = context.line.length();
-  }
-
-  context.token = context.line.substr(0u, token_length);
-  context.line.remove_prefix(token_length);
-
   return std::error_code();
 }
 
 template <typename T>
-std::error_code ReadASCII(std::istream& input, Context& context,
-                          EntryType entry_type) {
+std::error_code ReadASCII(InputBuffer& input, Context& context,
+                          EntryType entry_type, T& value) {
   if (std::error_code error =
           ReadNextToken(context, std::is_floating_point_v<T>,
                         MakeMissingToken(entry_type, GetDataType<T>()),
@@ -723,11 +1221,10 @@ std::error_code ReadASCII(std::istream& input, Context& context,
     }
   }
 
-  T value{};
-  std::from_chars_result result = std::from_chars(start, end, value);
-  if (result.ec == std::errc::invalid_argument || result.ptr != end) {
+  std::errc result = internal::ParseNumber(start, end, value);
+  if (result == std::errc::invalid_argument) {
     return MakeFailedToParse(entry_type, GetDataType<T>());
-  } else if (result.ec == std::errc::result_out_of_range || out_of_range) {
+  } else if (result == std::errc::result_out_of_range || out_of_range) {
     return MakeOutOfRange(entry_type, GetDataType<T>());
   }
 
@@ -735,18 +1232,19 @@ std::error_code ReadASCII(std::istream& input, Context& context,
     return MakeOutOfRange(EntryType::LIST_SIZE, GetDataType<T>());
   }
 
-  std::get<T>(context.data) = value;
-
   return std::error_code();
 }
 
+template <typename T>
+std::error_code ReadASCII(InputBuffer& input, Context& context,
+                          EntryType entry_type) {
+  return ReadASCII(input, context, entry_type, std::get<T>(context.data));
+}
+
 template <std::endian Endianness, std::integral T>
-std::error_code ReadBinary(std::istream& stream, Context& context,
-                           EntryType entry_type) {
-  T value{};
-  stream.read(reinterpret_cast<char*>(&value), sizeof(T));
-  if (stream.fail()) {
-    if (stream.eof()) {
+std::error_code ReadBinary(InputBuffer& input, EntryType entry_type, T& value) {
+  if (!input.Read(&value, sizeof(T))) {
+    if (input.eof()) {
       return MakeUnexpectedEof(entry_type, GetDataType<T>());
     }
     return std::io_errc::stream;
@@ -760,19 +1258,16 @@ std::error_code ReadBinary(std::istream& stream, Context& context,
     return MakeOutOfRange(EntryType::LIST_SIZE, GetDataType<T>());
   }
 
-  std::get<T>(context.data) = value;
-
   return std::error_code();
 }
 
 template <std::endian Endianness, std::floating_point T>
-std::error_code ReadBinary(std::istream& stream, Context& context,
-                           EntryType entry_type) {
+std::error_code ReadBinary(InputBuffer& input, EntryType entry_type,
+                           T& result) {
   std::conditional_t<std::is_same_v<T, float>, uint32_t, uint64_t> value{};
 
-  stream.read(reinterpret_cast<char*>(&value), sizeof(value));
-  if (stream.fail()) {
-    if (stream.eof()) {
+  if (!input.Read(&value, sizeof(value))) {
+    if (input.eof()) {
       return MakeUnexpectedEof(entry_type, GetDataType<T>());
     }
     return std::io_errc::stream;
@@ -786,11 +1281,17 @@ std::error_code ReadBinary(std::istream& stream, Context& context,
     return MakeOutOfRange(EntryType::LIST_SIZE, GetDataType<T>());
   }
 
-  std::get<T>(context.data) = std::bit_cast<T>(value);
+  result = std::bit_cast<T>(value);
 
   return std::error_code();
 }
 
+template <std::endian Endianness, typename T>
+std::error_code ReadBinary(InputBuffer& input, Context& context,
+                           EntryType entry_type) {
+  return ReadBinary<Endianness>(input, entry_type, std::get<T>(context.data));
+}
+
 ReadFunc GetReadFunc(PlyHeader::Format format, PlyHeader::Property::Type type) {
   static constexpr ReadFunc ascii_read_funcs[8] = {
       ReadASCII<std::tuple_element_t<0, ContextData>>,
@@ -837,22 +1338,20 @@ ReadFunc GetReadFunc(PlyHeader::Format format, PlyHeader::Property::Type type) {
 }
 
 template <typename Source, typename Dest>
-std::error_code Convert(Context& context, EntryType entry_type) {
+std::error_code Convert(Source source, Dest& dest, EntryType entry_type) {
   static_assert(std::is_floating_point_v<Source> ==
                 std::is_floating_point_v<Dest>);
 
   if constexpr (!std::is_same_v<Source, Dest>) {
     if constexpr (std::is_floating_point_v<Source>) {
       if constexpr (sizeof(Dest) < sizeof(Source)) {
-        if (std::isfinite(std::get<Source>(context.data))) {
-          if (std::get<Source>(context.data) <
-              std::numeric_limits<Dest>::lowest()) {
+        if (std::isfinite(source)) {
+          if (source < std::numeric_limits<Dest>::lowest()) {
             return MakeUnderflowed(GetDataType<Source>(), GetDataType<Dest>(),
                                    entry_type == EntryType::LIST_VALUE);
           }
 
-          if (std::get<Source>(context.data) >
-              std::numeric_limits<Dest>::max()) {
+          if (source > std::numeric_limits<Dest>::max()) {
             return MakeOverflowed(GetDataType<Source>(), GetDataType<Dest>(),
                                   entry_type == EntryType::LIST_VALUE);
           }
@@ -860,13 +1359,13 @@ std::error_code Convert(Context& context, EntryType entry_type) {
       }
     } else {
       if constexpr (std::is_signed_v<Source> && !std::is_signed_v<Dest>) {
-        if (std::get<Source>(context.data) < 0) {
+        if (source < 0) {
           return MakeUnderflowed(GetDataType<Source>(), GetDataType<Dest>(),
                                  entry_type == EntryType::LIST_VALUE);
         }
       } else if constexpr (std::is_signed_v<Source> && std::is_signed_v<Dest> &&
                            sizeof(Dest) < sizeof(Source)) {
-        if (std::get<Source>(context.data) < std::numeric_limits<Dest>::min()) {
+        if (source < std::numeric_limits<Dest>::min()) {
           return MakeUnderflowed(GetDataType<Source>(), GetDataType<Dest>(),
                                  entry_type == EntryType::LIST_VALUE);
         }
@@ -875,21 +1374,31 @@ std::error_code Convert(Context& context, EntryType entry_type) {
       if constexpr (sizeof(Source) > sizeof(Dest) ||
                     (sizeof(Source) == sizeof(Dest) &&
                      !std::is_signed_v<Source> && std::is_signed_v<Dest>)) {
-        if (std::get<Source>(context.data) >
-            static_cast<Source>(std::numeric_limits<Dest>::max())) {
+        if (source > static_cast<Source>(std::numeric_limits<Dest>::max())) {
           return MakeOverflowed(GetDataType<Source>(), GetDataType<Dest>(),
                                 entry_type == EntryType::LIST_VALUE);
         }
       }
     }
 
-    std::get<Dest>(context.data) =
-        static_cast<Dest>(std::get<Source>(context.data));
+    dest = static_cast<Dest>(source);
+  } else {
+    dest = source;
   }
 
   return std::error_code();
 }
 
+template <typename Source, typename Dest>
+std::error_code Convert(Context& context, EntryType entry_type) {
+  if constexpr (std::is_same_v<Source, Dest>) {
+    return std::error_code();
+  } else {
+    return Convert(std::get<Source>(context.data), std::get<Dest>(context.data),
+                   entry_type);
+  }
+}
+
 template <PlyHeader::Property::Type Source, PlyHeader::Property::Type Dest>
 consteval ConvertFunc GetConvertFunc() {
   using SourceType =
@@ -936,162 +1445,2019 @@ ConvertFunc GetConvertFunc(PlyHeader::Property::Type source,
                          [static_cast<size_t>(dest)];
 }
 
-template <size_t Index>
-void Append(Context& context) {
-  std::get<2 * Index + 1>(context.data)
-      .push_back(std::get<2 * Index>(context.data));
+template <PlyHeader::Format Format, typename T>
+std::error_code Read(InputBuffer& input, Context& context, EntryType entry_type,
+                     T& value) {
+  if constexpr (Format == PlyHeader::Format::ASCII) {
+    return ReadASCII(input, context, entry_type, value);
+  } else if constexpr (Format == PlyHeader::Format::BINARY_BIG_ENDIAN) {
+    return ReadBinary<std::endian::big>(input, entry_type, value);
+  } else {
+    return ReadBinary<std::endian::little>(input, entry_type, value);
+  }
 }
 
-AppendFunc GetAppendFunc(PlyHeader::Property::Type dest_type) {
-  static constexpr AppendFunc append_funcs[8] = {
-      Append<0>, Append<1>, Append<2>, Append<3>,
-      Append<4>, Append<5>, Append<6>, Append<7>,
-  };
+// Converts `values` onto the end of `list`. On failure, the values preceding
+// the one that failed are still appended.
+template <typename Source, typename Dest>
+std::error_code ConvertList(std::span<const Source> values,
+                            std::vector<Dest>& list, EntryType entry_type) {
+  size_t offset = list.size();
+  list.resize(offset + values.size());
+
+  size_t num_converted = internal::ConvertValues(values, list.data() + offset);
+  if (num_converted == values.size()) {
+    return std::error_code();
+  }
 
-  return append_funcs[static_cast<size_t>(dest_type)];
-}
+  list.resize(offset + num_converted);
 
-template <typename T>
-Handler MakeHandler(std::move_only_function<std::error_code(T)> callback) {
-  return [actual = std::move(callback)](Context& context) mutable {
-    return actual(std::get<T>(context.data));
-  };
+  Dest unused;
+  return Convert(values[num_converted], unused, entry_type);
 }
 
-template <typename T>
-Handler MakeHandler(
-    std::move_only_function<std::error_code(std::span<const T>)> callback) {
-  return [actual = std::move(callback)](Context& context) mutable {
-    auto& data = std::get<std::vector<T>>(context.data);
-    std::error_code result = actual(data);
-    data.clear();
-    return result;
-  };
-}
+// Reads the `length` entries of a list from a binary input with bulk copies
+// onto the end of the list for `Source` in `context` and then byte swaps them
+// in place. If the entries must be converted, they are read into the
+// unconverted entries of `context` and then converted onto the end of the
+// list for `Dest`.
+template <std::endian Endianness, typename Source, typename Dest>
+std::error_code ParseBinaryList(InputBuffer& input, Context& context,
+                                uint32_t length, bool& conversion_failed) {
+  // The number of bytes past those already buffered that the list is grown by
+  // at a time. This bounds the memory allocated for a corrupt list size.
+  static constexpr size_t kMinBlockSize = 64u * 1024u;
+
+  auto& entries = std::is_same_v<Source, Dest>
+                      ? std::get<std::vector<Source>>(context.data)
+                      : std::get<std::vector<Source>>(context.unconverted);
+  if constexpr (!std::is_same_v<Source, Dest>) {
+    entries.clear();
+  }
 
-template <typename PropertyCallback>
-Handler MakeHandler(PropertyCallback callback) {
-  return std::visit(
-      [](auto true_callback) -> Handler {
-        if (!true_callback) {
-          return Handler();
-        }
+  size_t offset = entries.size();
+  size_t num_read = 0u;
+  std::error_code read_error;
+  while (num_read < length) {
+    size_t count = std::min<size_t>(
+        length - num_read,
+        std::max(input.Peek().size(), kMinBlockSize) / sizeof(Source));
+    entries.resize(offset + num_read + count);
+
+    size_t num_bytes = input.ReadSome(entries.data() + offset + num_read,
+                                      count * sizeof(Source));
+    num_read += num_bytes / sizeof(Source);
+
+    if (num_bytes != count * sizeof(Source)) {
+      entries.resize(offset + num_read);
+      if (input.eof()) {
+        read_error =
+            MakeUnexpectedEof(EntryType::LIST_VALUE, GetDataType<Source>());
+      } else {
+        read_error = std::make_error_code(std::io_errc::stream);
+      }
+      break;
+    }
+  }
 
-        return MakeHandler(std::move(true_callback));
-      },
-      std::move(callback));
+  if constexpr (Endianness != std::endian::native && sizeof(Source) != 1u) {
+    internal::ByteSwap(reinterpret_cast<char*>(entries.data() + offset),
+                       sizeof(Source), num_read);
+  }
+
+  if constexpr (!std::is_same_v<Source, Dest>) {
+    // Conversion failures of the entries preceding a read error take priority
+    if (std::error_code error = ConvertList<Source>(
+            entries, std::get<std::vector<Dest>>(context.data),
+            EntryType::LIST_VALUE);
+        error) {
+      conversion_failed = true;
+      return error;
+    }
+  }
+
+  return read_error;
 }
 
-class PropertyParser {
- public:
-  PropertyParser(PlyHeader::Format format,
-                 std::optional<PlyHeader::Property::Type> list_type,
-                 PlyHeader::Property::Type source_type,
-                 PlyHeader::Property::Type dest_type, Handler handler,
-                 OnConversionErrorFunc on_conversion_error,
-                 const std::string& element_name,
-                 const std::string& property_name);
+// Reads, converts, and stores `length` values of a property in a single loop.
+// The values of lists are appended to the list for `Dest` in `context`. When
+// the entries of a list must be converted, they are all read before being
+// converted together.
+template <PlyHeader::Format Format, typename Source, typename Dest, bool IsList>
+std::error_code ParseValues(InputBuffer& input, Context& context,
+                            uint32_t length, bool& conversion_failed) {
+  if constexpr (IsList && Format == PlyHeader::Format::BINARY_BIG_ENDIAN) {
+    return ParseBinaryList<std::endian::big, Source, Dest>(
+        input, context, length, conversion_failed);
+  } else if constexpr (IsList &&
+                       Format == PlyHeader::Format::BINARY_LITTLE_ENDIAN) {
+    return ParseBinaryList<std::endian::little, Source, Dest>(
+        input, context, length, conversion_failed);
+  } else if constexpr (IsList && !std::is_same_v<Source, Dest>) {
+    auto& unconverted = std::get<std::vector<Source>>(context.unconverted);
+    unconverted.clear();
+
+    std::error_code read_error;
+    for (uint32_t i = 0; i < length; i++) {
+      Source value{};
+      if (read_error =
+              Read<Format>(input, context, EntryType::LIST_VALUE, value);
+          read_error) {
+        break;
+      }
 
-  std::error_code Parse(std::istream& stream, Context& context) const;
+      unconverted.push_back(value);
+    }
 
- private:
-  const std::string& element_name_;
-  const std::string& property_name_;
-  ReadFunc read_length_;
-  ConvertFunc convert_length_;
-  ReadFunc read_;
-  ConvertFunc convert_;
-  AppendFunc append_to_list_;
-  mutable OnConversionErrorFunc on_conversion_error_;
+    // Conversion failures of the entries preceding a read error take priority
+    if (std::error_code error =
+            ConvertList<Source>(unconverted,
+                                std::get<std::vector<Dest>>(context.data),
+                                EntryType::LIST_VALUE);
+        error) {
+      conversion_failed = true;
+      return error;
+    }
+
+    return read_error;
+  } else {
+    constexpr EntryType entry_type =
+        IsList ? EntryType::LIST_VALUE : EntryType::VALUE;
+
+    for (uint32_t i = 0; i < length; i++) {
+      Source value{};
+      if (std::error_code error =
+              Read<Format>(input, context, entry_type, value);
+          error) {
+        return error;
+      }
+
+      Dest& dest = std::get<Dest>(context.data);
+      if (std::error_code error = Convert(value, dest, entry_type); error) {
+        conversion_failed = true;
+        return error;
+      }
+
+      if constexpr (IsList) {
+        std::get<std::vector<Dest>>(context.data).push_back(dest);
+      }
+    }
+
+    return std::error_code();
+  }
+}
+
+template <PlyHeader::Format Format, bool IsList,
+          PlyHeader::Property::Type Source, PlyHeader::Property::Type Dest>
+consteval ParseFunc GetParseFunc() {
+  using SourceType =
+      std::tuple_element_t<static_cast<size_t>(Source) * 2, ContextData>;
+  using DestType =
+      std::tuple_element_t<static_cast<size_t>(Dest) * 2, ContextData>;
+
+  if constexpr (std::is_floating_point_v<SourceType> ==
+                std::is_floating_point_v<DestType>) {
+    return ParseValues<Format, SourceType, DestType, IsList>;
+  }
+
+  return nullptr;
+}
+
+template <PlyHeader::Format Format, bool IsList,
+          PlyHeader::Property::Type Source>
+consteval std::array<ParseFunc, 8> GetParseFuncs() {
+  return {
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::CHAR>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::UCHAR>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::SHORT>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::USHORT>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::INT>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::UINT>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::FLOAT>(),
+      GetParseFunc<Format, IsList, Source, PlyHeader::Property::Type::DOUBLE>(),
+  };
+}
+
+template <PlyHeader::Format Format, bool IsList>
+consteval std::array<std::array<ParseFunc, 8>, 8> GetParseFuncs() {
+  return {
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::CHAR>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::UCHAR>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::SHORT>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::USHORT>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::INT>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::UINT>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::FLOAT>(),
+      GetParseFuncs<Format, IsList, PlyHeader::Property::Type::DOUBLE>(),
+  };
+}
+
+// Returns the kernel that parses the values of a property with values of type
+// `source` in the input that are delivered as `dest`.
+ParseFunc GetParseFunc(PlyHeader::Format format, bool is_list,
+                       PlyHeader::Property::Type source,
+                       PlyHeader::Property::Type dest) {
+  static constexpr std::array<std::array<ParseFunc, 8>, 8> parse_funcs[3][2] = {
+      {GetParseFuncs<PlyHeader::Format::ASCII, false>(),
+       GetParseFuncs<PlyHeader::Format::ASCII, true>()},
+      {GetParseFuncs<PlyHeader::Format::BINARY_BIG_ENDIAN, false>(),
+       GetParseFuncs<PlyHeader::Format::BINARY_BIG_ENDIAN, true>()},
+      {GetParseFuncs<PlyHeader::Format::BINARY_LITTLE_ENDIAN, false>(),
+       GetParseFuncs<PlyHeader::Format::BINARY_LITTLE_ENDIAN, true>()},
+  };
+
+  return parse_funcs[static_cast<size_t>(format)][is_list]
+                    [static_cast<size_t>(source)][static_cast<size_t>(dest)];
+}
+
+// Converts `count` native order values of type `Source` spaced `stride` bytes
+// apart starting at `data` onto the end of the values of `column`. Sets
+// `num_converted` to the number of values converted, which is less than
+// `count` only if an error is returned.
+template <typename Source, typename Dest>
+std::error_code ConvertColumn(const char* data, size_t stride, size_t count,
+                              Context& context, ParsedValues& column,
+                              size_t& num_converted) {
+  auto& unconverted = std::get<std::vector<Source>>(context.unconverted);
+  unconverted.resize(count);
+
+  for (size_t i = 0; i < count; i++) {
+    std::memcpy(&unconverted[i], data + i * stride, sizeof(Source));
+  }
+
+  auto& values = std::get<std::vector<Dest>>(column.values);
+  size_t offset = values.size();
+
+  std::error_code error =
+      ConvertList<Source>(unconverted, values, EntryType::VALUE);
+  num_converted = values.size() - offset;
+
+  return error;
+}
+
+template <PlyHeader::Property::Type Source, PlyHeader::Property::Type Dest>
+consteval ColumnConvertFunc GetColumnConvertFunc() {
+  using SourceType =
+      std::tuple_element_t<static_cast<size_t>(Source) * 2, ContextData>;
+  using DestType =
+      std::tuple_element_t<static_cast<size_t>(Dest) * 2, ContextData>;
+
+  if constexpr (std::is_floating_point_v<SourceType> ==
+                std::is_floating_point_v<DestType>) {
+    return ConvertColumn<SourceType, DestType>;
+  }
+
+  return nullptr;
+}
+
+template <PlyHeader::Property::Type Source>
+consteval std::array<ColumnConvertFunc, 8> GetColumnConvertFuncs() {
+  return {
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::CHAR>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::UCHAR>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::SHORT>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::USHORT>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::INT>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::UINT>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::FLOAT>(),
+      GetColumnConvertFunc<Source, PlyHeader::Property::Type::DOUBLE>(),
+  };
+}
+
+ColumnConvertFunc GetColumnConvertFunc(PlyHeader::Property::Type source,
+                                       PlyHeader::Property::Type dest) {
+  static constexpr std::array<ColumnConvertFunc, 8> column_convert_funcs[8] = {
+      GetColumnConvertFuncs<PlyHeader::Property::Type::CHAR>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::UCHAR>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::SHORT>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::USHORT>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::INT>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::UINT>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::FLOAT>(),
+      GetColumnConvertFuncs<PlyHeader::Property::Type::DOUBLE>(),
+  };
+
+  return column_convert_funcs[static_cast<size_t>(source)]
+                             [static_cast<size_t>(dest)];
+}
+
+template <size_t Index>
+void Save(Context& context, bool is_list, ParsedValues& parsed) {
+  auto& values = std::get<Index>(parsed.values);
+  if (is_list) {
+    auto& list = std::get<2 * Index + 1>(context.data);
+    parsed.list_sizes.push_back(static_cast<uint32_t>(list.size()));
+    values.insert(values.end(), list.begin(), list.end());
+    list.clear();
+  } else {
+    values.push_back(std::get<2 * Index>(context.data));
+  }
+}
+
+SaveFunc GetSaveFunc(PlyHeader::Property::Type dest_type) {
+  static constexpr SaveFunc save_funcs[8] = {
+      Save<0>, Save<1>, Save<2>, Save<3>, Save<4>, Save<5>, Save<6>, Save<7>,
+  };
+
+  return save_funcs[static_cast<size_t>(dest_type)];
+}
+
+template <size_t Index>
+void Restore(const ParsedValues& parsed, bool is_list,
+             ParsedValuesCursor& cursor, Context& context) {
+  const auto& values = std::get<Index>(parsed.values);
+  size_t& position = cursor.values[Index];
+  if (is_list) {
+    size_t size = parsed.list_sizes[cursor.list_sizes++];
+    std::get<2 * Index + 1>(context.data)
+        .assign(values.begin() + position, values.begin() + position + size);
+    position += size;
+  } else {
+    std::get<2 * Index>(context.data) = values[position++];
+  }
+}
+
+RestoreFunc GetRestoreFunc(PlyHeader::Property::Type dest_type) {
+  static constexpr RestoreFunc restore_funcs[8] = {
+      Restore<0>, Restore<1>, Restore<2>, Restore<3>,
+      Restore<4>, Restore<5>, Restore<6>, Restore<7>,
+  };
+
+  return restore_funcs[static_cast<size_t>(dest_type)];
+}
+
+template <typename T>
+Handler MakeHandler(std::move_only_function<std::error_code(T)> callback,
+                    size_t batch_size, uintmax_t num_instances) {
+  return [actual = std::move(callback)](Context& context) mutable {
+    return actual(std::get<T>(context.data));
+  };
+}
+
+template <typename T>
+Handler MakeHandler(
+    std::move_only_function<std::error_code(std::span<const T>)> callback,
+    size_t batch_size, uintmax_t num_instances) {
+  return [actual = std::move(callback)](Context& context) mutable {
+    auto& data = std::get<std::vector<T>>(context.data);
+    std::error_code result = actual(data);
+    data.clear();
+    return result;
+  };
+}
+
+template <typename T>
+Handler MakeHandler(
+    std::move_only_function<std::error_code(uintmax_t, std::span<const T>)>
+        callback,
+    size_t batch_size, uintmax_t num_instances) {
+  batch_size = std::max(batch_size, size_t(1u));
+
+  std::vector<T> values;
+  values.reserve(
+      static_cast<size_t>(std::min<uintmax_t>(batch_size, num_instances)));
+
+  return [actual = std::move(callback), values = std::move(values), batch_size,
+          num_remaining = num_instances,
+          first_instance = uintmax_t(0u)](Context& context) mutable {
+    values.push_back(std::get<T>(context.data));
+    num_remaining -= 1u;
+
+    if (values.size() < batch_size && num_remaining != 0u) {
+      return std::error_code();
+    }
+
+    std::error_code result = actual(first_instance, values);
+    first_instance += values.size();
+    values.clear();
+    return result;
+  };
+}
+
+template <typename PropertyCallback>
+Handler MakeHandler(PropertyCallback callback, size_t batch_size,
+                    uintmax_t num_instances) {
+  return std::visit(
+      [&](auto true_callback) -> Handler {
+        if (!true_callback) {
+          return Handler();
+        }
+
+        return MakeHandler(std::move(true_callback), batch_size,
+                           num_instances);
+      },
+      std::move(callback));
+}
+
+// Returns a handler that passes `count` values of `column` starting from
+// `offset` directly to the batch callback as a single batch, bypassing the
+// buffering done by the `Handler` for the callback. `callback` is replaced with
+// a callback forwarding to the same target so that it can still be used to
+// make a `Handler`.
+template <typename T>
+ColumnHandler MakeColumnHandler(
+    std::move_only_function<std::error_code(uintmax_t, std::span<const T>)>&
+        callback) {
+  using Callback =
+      std::move_only_function<std::error_code(uintmax_t, std::span<const T>)>;
+
+  if (!callback) {
+    return ColumnHandler();
+  }
+
+  auto shared = std::make_shared<Callback>(std::move(callback));
+  callback = [shared](uintmax_t first_instance, std::span<const T> values) {
+    return (*shared)(first_instance, values);
+  };
+
+  return [shared](uintmax_t first_instance, const ParsedValues& column,
+                  size_t offset, size_t count) {
+    std::span<const T> values = std::get<std::vector<T>>(column.values);
+    return (*shared)(first_instance, values.subspan(offset, count));
+  };
+}
+
+template <typename Callback>
+ColumnHandler MakeColumnHandler(Callback& callback) {
+  return ColumnHandler();
+}
+
+template <typename... Callbacks>
+ColumnHandler MakeColumnHandler(std::variant<Callbacks...>& callback) {
+  return std::visit(
+      [](auto& true_callback) { return MakeColumnHandler(true_callback); },
+      callback);
+}
+
+// Parses the values of a property. A parser is constructed once per schema and
+// then bound to the callback of each read, which sets the type its values are
+// converted to and the handler they are passed to. An unbound parser keeps the
+// type of the property and has no handler.
+class PropertyParser {
+ public:
+  PropertyParser(PlyHeader::Format format,
+                 std::optional<PlyHeader::Property::Type> list_type,
+                 PlyHeader::Property::Type source_type,
+                 OnConversionErrorFunc on_conversion_error,
+                 const std::string& element_name,
+                 const std::string& property_name);
+
+  // Converts the values of the property to `dest_type` and passes them to
+  // `handler` and `column_handler` until the parser is bound again.
+  void Bind(PlyHeader::Property::Type dest_type, Handler handler,
+            ColumnHandler column_handler);
+
+  // Releases the handlers of the property, restoring its unbound state.
+  void Unbind() { Bind(source_type_, Handler(), ColumnHandler()); }
+
+  std::error_code Parse(InputBuffer& input, Context& context) const;
+
+  // Converts `count` native order values of a non-list property spaced
+  // `stride` bytes apart starting at `data` onto the end of `column` without
+  // handling them. Sets `num_converted` to the number of values converted
+  // before the first failure. Any error returned has not yet been passed to
+  // `OnConversionFailure`. May be called concurrently.
+  std::error_code ConvertColumn(const char* data, size_t stride, size_t count,
+                                Context& context, ParsedValues& column,
+                                size_t& num_converted) const;
+
+  // Reads and converts the next value of the property into `context` without
+  // handling it. Sets `conversion_failed` if the returned error is from the
+  // conversion, in which case it has not yet been passed to
+  // `OnConversionFailure`. If the property is a no-op, the value is skipped
+  // instead. Unlike `Parse`, this may be called concurrently.
+  std::error_code Read(InputBuffer& input, Context& context,
+                       bool& conversion_failed) const;
+
+  // Invokes the handler of the property on the value in `context`.
+  std::error_code Handle(Context& context) const;
+
+  // Returns the error to report for a conversion failure of the property.
+  std::error_code OnConversionFailure(std::error_code error) const;
+
+  // Moves the value read by `Read` out of `context` onto the end of `parsed`
+  // so that it can later be handled by `Restore` and `Handle`. Does nothing if
+  // the property has no handler. May be called concurrently.
+  void Save(Context& context, ParsedValues& parsed) const;
+
+  // Loads the next value saved to `parsed` by `Save` back into `context`.
+  void Restore(const ParsedValues& parsed, ParsedValuesCursor& cursor,
+               Context& context) const;
+
+  // Passes `count` values saved to `column` starting from `offset` to the
+  // handler of the property as a single batch. Must only be called if
+  // `HandlesColumns` returns true.
+  std::error_code HandleColumn(uintmax_t first_instance,
+                               const ParsedValues& column, size_t offset,
+                               size_t count) const;
+
+  // Returns true if parsing the property has no effect other than advancing
+  // the input. The values of these properties are skipped over rather than
+  // decoded, including the entries of lists and the tokens of ASCII inputs.
+  bool IsNoOp() const { return is_no_op_; }
+
+  // Returns true if the property either has no handler or has a handler that
+  // can receive columns of values through `HandleColumn`.
+  bool HandlesColumns() const { return !handler_ || column_handler_; }
+
+ private:
+  std::error_code Skip(InputBuffer& input, Context& context) const;
+
+  const std::string& element_name_;
+  const std::string& property_name_;
+  bool is_no_op_;
+  PlyHeader::Format format_;
+  PlyHeader::Property::Type source_type_;
+  size_t list_entry_size_;
+  ReadFunc read_length_;
+  ConvertFunc convert_length_;
+  ParseFunc parse_;
+  ColumnConvertFunc convert_column_;
+  SaveFunc save_;
+  RestoreFunc restore_;
+  mutable OnConversionErrorFunc on_conversion_error_;
   mutable Handler handler_;
+  mutable ColumnHandler column_handler_;
+};
+
+PropertyParser::PropertyParser(
+    PlyHeader::Format format,
+    std::optional<PlyHeader::Property::Type> list_type,
+    PlyHeader::Property::Type source_type,
+    OnConversionErrorFunc on_conversion_error, const std::string& element_name,
+    const std::string& property_name)
+    : element_name_(element_name),
+      property_name_(property_name),
+      format_(format),
+      source_type_(source_type),
+      list_entry_size_(format != PlyHeader::Format::ASCII
+                           ? internal::GetBinarySize(source_type)
+                           : 0u),
+      read_length_(list_type ? GetReadFunc(format, *list_type) : nullptr),
+      convert_length_(
+          list_type
+              ? GetConvertFunc(*list_type, PlyHeader::Property::Type::UINT)
+              : nullptr),
+      on_conversion_error_(std::move(on_conversion_error)) {
+  Unbind();
+}
+
+void PropertyParser::Bind(PlyHeader::Property::Type dest_type, Handler handler,
+                          ColumnHandler column_handler) {
+  is_no_op_ = !handler && source_type_ == dest_type;
+  parse_ = GetParseFunc(format_, read_length_ != nullptr, source_type_,
+                        dest_type);
+  convert_column_ = GetColumnConvertFunc(source_type_, dest_type);
+  save_ = GetSaveFunc(dest_type);
+  restore_ = GetRestoreFunc(dest_type);
+  handler_ = std::move(handler);
+  column_handler_ = std::move(column_handler);
+}
+
+std::error_code PropertyParser::Parse(InputBuffer& input,
+                                      Context& context) const {
+  bool conversion_failed = false;
+  if (std::error_code error = Read(input, context, conversion_failed); error) {
+    return conversion_failed ? OnConversionFailure(error) : error;
+  }
+
+  return Handle(context);
+}
+
+std::error_code PropertyParser::Read(InputBuffer& input, Context& context,
+                                     bool& conversion_failed) const {
+  if (is_no_op_) {
+    return Skip(input, context);
+  }
+
+  uint32_t length = 1;
+  if (read_length_) {
+    if (std::error_code error =
+            read_length_(input, context, EntryType::LIST_SIZE);
+        error) {
+      return error;
+    }
+
+    convert_length_(context, EntryType::LIST_SIZE);
+
+    length = std::get<uint32_t>(context.data);
+    input.Expect(static_cast<uintmax_t>(length) * list_entry_size_);
+  }
+
+  return parse_(input, context, length, conversion_failed);
+}
+
+std::error_code PropertyParser::Skip(InputBuffer& input,
+                                     Context& context) const {
+  EntryType entry_type = EntryType::VALUE;
+  uintmax_t length = 1u;
+  if (read_length_) {
+    if (std::error_code error =
+            read_length_(input, context, EntryType::LIST_SIZE);
+        error) {
+      return error;
+    }
+
+    convert_length_(context, EntryType::LIST_SIZE);
+
+    entry_type = EntryType::LIST_VALUE;
+    length = std::get<uint32_t>(context.data);
+  }
+
+  // ASCII tokens are skipped without being parsed
+  if (list_entry_size_ == 0u) {
+    for (uintmax_t i = 0; i < length; i++) {
+      if (std::error_code error =
+              ReadNextToken(context, false,
+                            MakeMissingToken(entry_type, source_type_),
+                            MakeUnexpectedEof(entry_type, source_type_));
+          error) {
+        return error;
+      }
+    }
+
+    return std::error_code();
+  }
+
+  uintmax_t num_bytes = length * list_entry_size_;
+  if (read_length_) {
+    input.Expect(num_bytes);
+  }
+
+  if (!input.Discard(num_bytes)) {
+    if (input.eof()) {
+      return MakeUnexpectedEof(entry_type, source_type_);
+    }
+    return std::io_errc::stream;
+  }
+
+  return std::error_code();
+}
+
+std::error_code PropertyParser::Handle(Context& context) const {
+  if (handler_) {
+    return handler_(context);
+  }
+
+  return std::error_code();
+}
+
+std::error_code PropertyParser::OnConversionFailure(
+    std::error_code error) const {
+  return on_conversion_error_(element_name_, property_name_, error);
+}
+
+void PropertyParser::Save(Context& context, ParsedValues& parsed) const {
+  if (handler_) {
+    save_(context, read_length_ != nullptr, parsed);
+  }
+}
+
+void PropertyParser::Restore(const ParsedValues& parsed,
+                             ParsedValuesCursor& cursor,
+                             Context& context) const {
+  if (handler_) {
+    restore_(parsed, read_length_ != nullptr, cursor, context);
+  }
+}
+
+std::error_code PropertyParser::ConvertColumn(const char* data, size_t stride,
+                                              size_t count, Context& context,
+                                              ParsedValues& column,
+                                              size_t& num_converted) const {
+  return convert_column_(data, stride, count, context, column, num_converted);
+}
+
+std::error_code PropertyParser::HandleColumn(uintmax_t first_instance,
+                                             const ParsedValues& column,
+                                             size_t offset,
+                                             size_t count) const {
+  if (column_handler_) {
+    return column_handler_(first_instance, column, offset, count);
+  }
+
+  return std::error_code();
+}
+
+// Parses the instances of an element of a binary input that contains no
+// property lists. Since every instance of such an element has the same size,
+// the instances are decoded in batches directly from the input using the
+// offset of each property within an instance rather than being read one
+// property at a time. If the input is not in native byte order, each batch is
+// first copied and byte swapped as a whole. Each batch is converted one
+// property at a time so that the range checks of the conversions can be
+// vectorized.
+class RecordParser {
+ public:
+  // `byte_swapper` must be null if the input is in native byte order and must
+  // otherwise swap the properties of `element`. `parsers` must outlive the
+  // record parser.
+  RecordParser(const PlyHeader::Element& element,
+               const std::vector<PropertyParser>& parsers,
+               const internal::RecordByteSwapper* byte_swapper);
+
+  // Updates the fields decoded from each instance to match the current
+  // bindings of the property parsers. Must be called after the property
+  // parsers are bound or unbound.
+  void Bind();
+
+  // Parses instances of the element until `num_parsed` equals
+  // `num_instances`. If the input ends early, returns without an error leaving
+  // the remaining instances unparsed so that the error can be reported by the
+  // property parsers.
+  std::error_code Parse(InputBuffer& input, Context& context,
+                        uintmax_t num_instances, uintmax_t& num_parsed) const;
+
+  // Parses every instance of the element using the threads of `thread_pool`
+  // and sets `num_parsed` to `num_instances`. Each thread decodes and converts
+  // a range of instances made up of whole batches of `batch_size` instances,
+  // after which the batches are passed to the batch callbacks on the calling
+  // thread in input order. Returns without parsing any instances unless the
+  // input is in memory and contains every instance and each property either
+  // has no handler or has a batch callback. Must be called before `Parse`.
+  std::error_code ParseInParallel(InputBuffer& input,
+                                  internal::ThreadPool& thread_pool,
+                                  size_t batch_size, uintmax_t num_instances,
+                                  uintmax_t& num_parsed) const;
+
+ private:
+  static constexpr size_t kBatchSize = 64u * 1024u;
+  static constexpr size_t kRangeSize = 1024u * 1024u;
+
+  struct Field {
+    size_t offset;
+    const PropertyParser* parser;
+  };
+
+  // A range of instances decoded by a single thread. `columns` holds the
+  // converted values of each field.
+  struct Range {
+    const char* data;
+    uintmax_t first_instance;
+    size_t num_instances;
+    std::vector<ParsedValues> columns;
+    size_t num_decoded;
+    std::error_code error;
+    size_t error_field;
+  };
+
+  // Converts the values of each field of the `count` native order instances
+  // at `data` onto the end of `columns`. Returns the number of instances
+  // converted before the first conversion failure in input order, in which
+  // case `error` and `error_field` are set to the failure.
+  size_t ConvertBatch(const char* data, size_t count, Context& context,
+                      std::vector<ParsedValues>& columns,
+                      std::error_code& error, size_t& error_field) const;
+  void DecodeRange(Range& range) const;
+  std::error_code HandleRange(const Range& range, size_t batch_size) const;
+
+  size_t record_size_ = 0u;
+  std::vector<Field> properties_;
+  std::vector<Field> fields_;
+  bool handles_columns_ = true;
+  const internal::RecordByteSwapper* byte_swapper_;
+  mutable std::vector<char> swapped_;
+  mutable std::vector<ParsedValues> columns_;
+  mutable std::vector<ParsedValuesCursor> cursors_;
 };
 
-PropertyParser::PropertyParser(
-    PlyHeader::Format format,
-    std::optional<PlyHeader::Property::Type> list_type,
-    PlyHeader::Property::Type source_type, PlyHeader::Property::Type dest_type,
-    Handler handler, OnConversionErrorFunc on_conversion_error,
-    const std::string& element_name, const std::string& property_name)
-    : element_name_(element_name),
-      property_name_(property_name),
-      read_length_(list_type ? GetReadFunc(format, *list_type) : nullptr),
-      convert_length_(
-          list_type
-              ? GetConvertFunc(*list_type, PlyHeader::Property::Type::UINT)
-              : nullptr),
-      read_(GetReadFunc(format, source_type)),
-      convert_(GetConvertFunc(source_type, dest_type)),
-      append_to_list_(list_type ? GetAppendFunc(dest_type) : nullptr),
-      on_conversion_error_(std::move(on_conversion_error)),
-      handler_(std::move(handler)) {}
+RecordParser::RecordParser(const PlyHeader::Element& element,
+                           const std::vector<PropertyParser>& parsers,
+                           const internal::RecordByteSwapper* byte_swapper)
+    : byte_swapper_(byte_swapper) {
+  for (size_t i = 0; i < element.properties.size(); i++) {
+    properties_.emplace_back(record_size_, &parsers[i]);
+    record_size_ += internal::GetBinarySize(element.properties[i].data_type);
+  }
+
+  Bind();
+}
+
+void RecordParser::Bind() {
+  fields_.clear();
+  handles_columns_ = true;
+  for (const Field& property : properties_) {
+    if (!property.parser->IsNoOp()) {
+      fields_.push_back(property);
+      handles_columns_ &= property.parser->HandlesColumns();
+    }
+  }
+}
+
+std::error_code RecordParser::Parse(InputBuffer& input, Context& context,
+                                    uintmax_t num_instances,
+                                    uintmax_t& num_parsed) const {
+  size_t max_batch_size = std::max(kBatchSize / record_size_, size_t(1u));
+
+  while (num_parsed < num_instances) {
+    size_t batch_size = static_cast<size_t>(
+        std::min<uintmax_t>(max_batch_size, num_instances - num_parsed));
+
+    const char* data = input.ReadInPlace(batch_size * record_size_);
+    if (!data) {
+      break;
+    }
+
+    // Elements with no values requested are only advanced past
+    if (fields_.empty()) {
+      num_parsed += batch_size;
+      continue;
+    }
+
+    if (byte_swapper_) {
+      swapped_.assign(data, data + batch_size * record_size_);
+      byte_swapper_->Swap(swapped_.data(), batch_size);
+      data = swapped_.data();
+    }
+
+    columns_.resize(fields_.size());
+    for (ParsedValues& column : columns_) {
+      column.clear();
+    }
+
+    std::error_code conversion_error;
+    size_t error_field = 0u;
+    size_t num_converted = ConvertBatch(data, batch_size, context, columns_,
+                                        conversion_error, error_field);
+
+    cursors_.assign(fields_.size(), ParsedValuesCursor());
+    for (size_t i = 0; i < num_converted; i++) {
+      for (size_t j = 0; j < fields_.size(); j++) {
+        fields_[j].parser->Restore(columns_[j], cursors_[j], context);
+        if (std::error_code error = fields_[j].parser->Handle(context);
+            error) {
+          return error;
+        }
+      }
+    }
+
+    if (conversion_error) {
+      for (size_t j = 0; j < error_field; j++) {
+        fields_[j].parser->Restore(columns_[j], cursors_[j], context);
+        if (std::error_code error = fields_[j].parser->Handle(context);
+            error) {
+          return error;
+        }
+      }
+
+      return fields_[error_field].parser->OnConversionFailure(
+          conversion_error);
+    }
+
+    num_parsed += batch_size;
+  }
+
+  return std::error_code();
+}
+
+size_t RecordParser::ConvertBatch(const char* data, size_t count,
+                                  Context& context,
+                                  std::vector<ParsedValues>& columns,
+                                  std::error_code& error,
+                                  size_t& error_field) const {
+  size_t num_converted = count;
+  for (size_t j = 0; j < fields_.size(); j++) {
+    // The values following the earliest failure so far are left unconverted
+    size_t num_to_convert = error ? num_converted + 1u : count;
+
+    size_t field_converted;
+    if (std::error_code field_error = fields_[j].parser->ConvertColumn(
+            data + fields_[j].offset, record_size_, num_to_convert, context,
+            columns[j], field_converted);
+        field_error && field_converted < num_converted) {
+      num_converted = field_converted;
+      error = field_error;
+      error_field = j;
+    }
+  }
+
+  return num_converted;
+}
+
+std::error_code RecordParser::ParseInParallel(InputBuffer& input,
+                                              internal::ThreadPool& thread_pool,
+                                              size_t batch_size,
+                                              uintmax_t num_instances,
+                                              uintmax_t& num_parsed) const {
+  if (fields_.empty() || !handles_columns_ || !input.in_memory() ||
+      internal::SaturatingMultiply(num_instances, record_size_) >
+          input.Peek().size()) {
+    return std::error_code();
+  }
+
+  const char* data =
+      input.ReadInPlace(static_cast<size_t>(num_instances * record_size_));
+
+  batch_size = static_cast<size_t>(std::clamp<uintmax_t>(
+      batch_size, 1u, std::max(num_instances, uintmax_t(1u))));
+
+  size_t range_size = std::max(kRangeSize / record_size_, size_t(1u));
+  range_size = (range_size + batch_size - 1u) / batch_size * batch_size;
+
+  std::vector<Range> ranges(thread_pool.num_threads());
+  uintmax_t instance = 0u;
+  while (instance < num_instances) {
+    size_t num_ranges = 0u;
+    for (; num_ranges < ranges.size() && instance < num_instances;
+         num_ranges++) {
+      Range& range = ranges[num_ranges];
+      range.data = data + instance * record_size_;
+      range.first_instance = instance;
+      range.num_instances = static_cast<size_t>(
+          std::min<uintmax_t>(range_size, num_instances - instance));
+      instance += range.num_instances;
+    }
+
+    for (size_t i = 0; i < num_ranges; i++) {
+      thread_pool.Submit([this, &range = ranges[i]]() {
+        DecodeRange(range);
+        return std::error_code();
+      });
+    }
+
+    thread_pool.Wait();
+
+    for (size_t i = 0; i < num_ranges; i++) {
+      if (std::error_code error = HandleRange(ranges[i], batch_size); error) {
+        return error;
+      }
+    }
+  }
+
+  num_parsed = num_instances;
+
+  return std::error_code();
+}
+
+void RecordParser::DecodeRange(Range& range) const {
+  range.columns.resize(fields_.size());
+  for (ParsedValues& column : range.columns) {
+    column.clear();
+  }
+
+  range.num_decoded = 0u;
+  range.error = std::error_code();
+
+  size_t max_block_size = std::max(kBatchSize / record_size_, size_t(1u));
+
+  Context context;
+  std::vector<char> swapped;
+  while (range.num_decoded < range.num_instances) {
+    size_t block_size =
+        std::min(max_block_size, range.num_instances - range.num_decoded);
+
+    const char* data = range.data + range.num_decoded * record_size_;
+    if (byte_swapper_) {
+      swapped.assign(data, data + block_size * record_size_);
+      byte_swapper_->Swap(swapped.data(), block_size);
+      data = swapped.data();
+    }
+
+    range.num_decoded += ConvertBatch(data, block_size, context,
+                                      range.columns, range.error,
+                                      range.error_field);
+    if (range.error) {
+      return;
+    }
+  }
+}
+
+std::error_code RecordParser::HandleRange(const Range& range,
+                                          size_t batch_size) const {
+  for (size_t start = 0; start < range.num_instances; start += batch_size) {
+    size_t count = std::min(batch_size, range.num_instances - start);
+
+    // The batches of the fields preceding the one that failed are still
+    // handled if the failure occurred on the final instance of the batch
+    size_t num_fields = fields_.size();
+    if (range.error && start + count > range.num_decoded) {
+      if (start + count != range.num_decoded + 1u) {
+        break;
+      }
+
+      num_fields = range.error_field;
+    }
+
+    for (size_t i = 0; i < num_fields; i++) {
+      if (std::error_code error = fields_[i].parser->HandleColumn(
+              range.first_instance + start, range.columns[i], start, count);
+          error) {
+        return error;
+      }
+    }
+  }
+
+  if (range.error) {
+    return fields_[range.error_field].parser->OnConversionFailure(range.error);
+  }
+
+  return std::error_code();
+}
+
+// Parses the next instance of an element from `input` and passes its values to
+// the handler of each of its properties. For ASCII inputs, the line containing
+// the instance is read first and `end_of_file_error` is returned if the input
+// has no lines remaining.
+std::error_code ParseInstance(const std::vector<PropertyParser>& parsers,
+                              bool is_ascii, InputBuffer& input,
+                              Context& context,
+                              std::error_code end_of_file_error) {
+  if (is_ascii) {
+    if (std::error_code error = ReadNextLine(input, context, end_of_file_error);
+        error) {
+      return error;
+    }
+  }
+
+  for (const PropertyParser& parser : parsers) {
+    if (std::error_code error = parser.Parse(input, context); error) {
+      return error;
+    }
+  }
+
+  if (is_ascii &&
+      !ReadNextToken(context, false, MakeUnusedToken(), MakeUnusedToken())) {
+    return MakeUnusedToken();
+  }
+
+  return std::error_code();
+}
+
+// The values of a run of consecutive instances of an element that were read
+// and converted ahead of being handled, along with the error that ended the
+// run if there was one.
+struct ParsedInstances final {
+  ParsedValues parsed;
+  size_t num_parsed = 0u;
+  std::error_code error;
+  size_t error_property = 0u;
+  bool conversion_failed = false;
+
+  void clear() {
+    parsed.clear();
+    num_parsed = 0u;
+    error = std::error_code();
+  }
+};
+
+// Reads and converts the next instance of an element onto the end of
+// `instances`. For ASCII inputs, the line containing the instance must already
+// be in `context`. Returns false if the instance could not be read in which
+// case the error is recorded in `instances`. May be called concurrently.
+bool ReadInstance(const std::vector<PropertyParser>& parsers, bool is_ascii,
+                  InputBuffer& input, Context& context,
+                  ParsedInstances& instances) {
+  for (size_t i = 0; i < parsers.size(); i++) {
+    bool conversion_failed = false;
+    if (std::error_code error =
+            parsers[i].Read(input, context, conversion_failed);
+        error) {
+      instances.error = error;
+      instances.error_property = i;
+      instances.conversion_failed = conversion_failed;
+      return false;
+    }
+
+    parsers[i].Save(context, instances.parsed);
+  }
+
+  if (is_ascii &&
+      !ReadNextToken(context, false, MakeUnusedToken(), MakeUnusedToken())) {
+    instances.error = MakeUnusedToken();
+    instances.error_property = parsers.size();
+    instances.conversion_failed = false;
+    return false;
+  }
+
+  instances.num_parsed += 1u;
+
+  return true;
+}
+
+// Handles the values of `instances` on the calling thread followed by the
+// values of the instance that failed to be read if there was one. Returns the
+// same error as parsing the instances one at a time would have.
+std::error_code HandleParsedInstances(
+    const std::vector<PropertyParser>& parsers,
+    const ParsedInstances& instances, Context& context) {
+  ParsedValuesCursor cursor;
+  for (size_t instance = 0; instance < instances.num_parsed; instance++) {
+    for (const PropertyParser& parser : parsers) {
+      parser.Restore(instances.parsed, cursor, context);
+      if (std::error_code error = parser.Handle(context); error) {
+        return error;
+      }
+    }
+  }
+
+  if (!instances.error) {
+    return std::error_code();
+  }
+
+  for (size_t i = 0; i < instances.error_property; i++) {
+    parsers[i].Restore(instances.parsed, cursor, context);
+    if (std::error_code error = parsers[i].Handle(context); error) {
+      return error;
+    }
+  }
+
+  if (instances.conversion_failed) {
+    return parsers[instances.error_property].OnConversionFailure(
+        instances.error);
+  }
+
+  return instances.error;
+}
+
+// Parses the instances of an element of an ASCII input using the threads of a
+// thread pool. Lines are split from the input on the calling thread and
+// gathered into one chunk per thread, after which the lines of each chunk are
+// tokenized and converted on a thread of the pool. The converted values are
+// then handled on the calling thread in input order so that the callbacks
+// observe the same values and errors as when parsing on a single thread.
+class ParallelASCIIParser {
+ public:
+  // `thread_pool` must outlive the parser.
+  explicit ParallelASCIIParser(internal::ThreadPool& thread_pool)
+      : thread_pool_(thread_pool), chunks_(thread_pool.num_threads()) {}
+
+  // Parses the `num_instances` instances of an element. `min_instance_size`
+  // and `min_bytes_remaining` are the lower bounds on the size of an instance
+  // and of the rest of the data section used to buffer the input.
+  std::error_code Parse(InputBuffer& input, Context& context,
+                        const std::vector<PropertyParser>& parsers,
+                        uintmax_t num_instances,
+                        std::error_code end_of_file_error,
+                        uintmax_t min_instance_size,
+                        uintmax_t& min_bytes_remaining);
+
+ private:
+  static constexpr size_t kChunkSize = 1024u * 1024u;
+
+  struct Chunk {
+    std::string text;
+    std::vector<size_t> line_ends;
+    bool ends_at_eof = false;
+    ParsedInstances instances;
+  };
+
+  static void ParseChunk(const std::vector<PropertyParser>& parsers,
+                         std::string_view line_ending, Chunk& chunk);
+
+  internal::ThreadPool& thread_pool_;
+  std::vector<Chunk> chunks_;
+};
+
+std::error_code ParallelASCIIParser::Parse(
+    InputBuffer& input, Context& context,
+    const std::vector<PropertyParser>& parsers, uintmax_t num_instances,
+    std::error_code end_of_file_error, uintmax_t min_instance_size,
+    uintmax_t& min_bytes_remaining) {
+  uintmax_t instance = 0u;
+  while (instance < num_instances) {
+    std::error_code line_error;
+
+    size_t num_chunks = 0u;
+    for (; num_chunks < chunks_.size() && instance < num_instances &&
+           !line_error;
+         num_chunks++) {
+      Chunk& chunk = chunks_[num_chunks];
+      chunk.text.clear();
+      chunk.line_ends.clear();
+      chunk.ends_at_eof = false;
+
+      for (; instance < num_instances && chunk.text.size() < kChunkSize;
+           instance++) {
+        input.ExpectAtLeast(min_bytes_remaining);
+        min_bytes_remaining -= std::min(min_bytes_remaining, min_instance_size);
+
+        line_error = ReadNextLine(input, context, end_of_file_error);
+        if (line_error) {
+          break;
+        }
+
+        chunk.text += context.line;
+        chunk.line_ends.push_back(chunk.text.size());
+        chunk.ends_at_eof = context.eof;
+      }
+    }
+
+    for (size_t i = 0; i < num_chunks; i++) {
+      thread_pool_.Submit([&parsers, line_ending = context.line_ending,
+                           &chunk = chunks_[i]]() {
+        ParseChunk(parsers, line_ending, chunk);
+        return std::error_code();
+      });
+    }
+
+    thread_pool_.Wait();
+
+    for (size_t i = 0; i < num_chunks; i++) {
+      if (std::error_code error =
+              HandleParsedInstances(parsers, chunks_[i].instances, context);
+          error) {
+        return error;
+      }
+    }
+
+    if (line_error) {
+      return line_error;
+    }
+  }
+
+  return std::error_code();
+}
+
+void ParallelASCIIParser::ParseChunk(const std::vector<PropertyParser>& parsers,
+                                     std::string_view line_ending,
+                                     Chunk& chunk) {
+  chunk.instances.clear();
+
+  // ASCII values are read from `context.line` rather than from the input
+  InputBuffer input(std::span<const std::byte>{});
+
+  Context context;
+  context.line_ending = line_ending;
+
+  std::string_view text = chunk.text;
+  size_t line_start = 0u;
+  for (size_t line = 0u; line < chunk.line_ends.size(); line++) {
+    size_t line_end = chunk.line_ends[line];
+    context.line = text.substr(line_start, line_end - line_start);
+    context.eof = chunk.ends_at_eof && line + 1u == chunk.line_ends.size();
+    line_start = line_end;
+
+    if (!ReadInstance(parsers, /*is_ascii=*/true, input, context,
+                      chunk.instances)) {
+      return;
+    }
+  }
+}
+
+// Parses the instances of an element of an input held in memory using the
+// threads of a thread pool by splitting the element at the checkpoints recorded
+// in its index. The instances between consecutive checkpoints are read and
+// converted on a thread of the pool directly from memory and are then handled
+// on the calling thread in input order so that the callbacks observe the same
+// values and errors as when parsing on a single thread.
+class IndexedParallelParser {
+ public:
+  // `thread_pool` must outlive the parser.
+  explicit IndexedParallelParser(internal::ThreadPool& thread_pool)
+      : thread_pool_(thread_pool), ranges_(thread_pool.num_threads()) {}
+
+  // Parses the instances of the element described by `element`, which must
+  // start at the current position of `input`. `data` is the entire input and
+  // `end_offset` is the offset at which the element ends.
+  std::error_code Parse(InputBuffer& input, Context& context,
+                        const std::vector<PropertyParser>& parsers,
+                        bool is_ascii, std::error_code end_of_file_error,
+                        std::span<const std::byte> data,
+                        const PlyIndex::Element& element, uintmax_t stride,
+                        uintmax_t end_offset);
+
+ private:
+  struct Range {
+    std::span<const std::byte> data;
+    uintmax_t num_instances = 0u;
+    ParsedInstances instances;
+  };
+
+  static void ParseRange(const std::vector<PropertyParser>& parsers,
+                         bool is_ascii, std::string_view line_ending,
+                         std::error_code end_of_file_error, Range& range);
+
+  internal::ThreadPool& thread_pool_;
+  std::vector<Range> ranges_;
+};
+
+std::error_code IndexedParallelParser::Parse(
+    InputBuffer& input, Context& context,
+    const std::vector<PropertyParser>& parsers, bool is_ascii,
+    std::error_code end_of_file_error, std::span<const std::byte> data,
+    const PlyIndex::Element& element, uintmax_t stride, uintmax_t end_offset) {
+  uintmax_t offset = element.offset;
+  size_t checkpoint = 0u;
+  uintmax_t instance = 0u;
+  while (instance < element.instance_count) {
+    size_t num_ranges = 0u;
+    for (; num_ranges < ranges_.size() && instance < element.instance_count;
+         num_ranges++) {
+      uintmax_t range_end = end_offset;
+      if (checkpoint < element.checkpoints.size()) {
+        range_end = element.checkpoints[checkpoint++];
+      }
+
+      Range& range = ranges_[num_ranges];
+      range.data = data.subspan(static_cast<size_t>(offset),
+                                static_cast<size_t>(range_end - offset));
+      range.num_instances = std::min(stride, element.instance_count - instance);
+
+      instance += range.num_instances;
+      offset = range_end;
+    }
+
+    for (size_t i = 0; i < num_ranges; i++) {
+      thread_pool_.Submit([&parsers, is_ascii,
+                           line_ending = context.line_ending, end_of_file_error,
+                           &range = ranges_[i]]() {
+        ParseRange(parsers, is_ascii, line_ending, end_of_file_error, range);
+        return std::error_code();
+      });
+    }
+
+    thread_pool_.Wait();
+
+    for (size_t i = 0; i < num_ranges; i++) {
+      if (std::error_code error =
+              HandleParsedInstances(parsers, ranges_[i].instances, context);
+          error) {
+        return error;
+      }
+    }
+  }
+
+  input.Skip(static_cast<size_t>(end_offset - element.offset));
+
+  return std::error_code();
+}
+
+void IndexedParallelParser::ParseRange(
+    const std::vector<PropertyParser>& parsers, bool is_ascii,
+    std::string_view line_ending, std::error_code end_of_file_error,
+    Range& range) {
+  range.instances.clear();
+
+  InputBuffer input(range.data);
+
+  Context context;
+  context.line_ending = line_ending;
+
+  for (uintmax_t instance = 0u; instance < range.num_instances; instance++) {
+    if (is_ascii) {
+      if (std::error_code error =
+              ReadNextLine(input, context, end_of_file_error);
+          error) {
+        range.instances.error = error;
+        range.instances.error_property = 0u;
+        range.instances.conversion_failed = false;
+        return;
+      }
+    }
+
+    if (!ReadInstance(parsers, is_ascii, input, context, range.instances)) {
+      return;
+    }
+  }
+
+  if (!input.Peek().empty()) {
+    range.instances.error = MakeMismatchedIndex();
+    range.instances.error_property = 0u;
+    range.instances.conversion_failed = false;
+  }
+}
+
+template <typename PropertyCallback>
+PropertyCallback MakeEmptyCallback(PlyHeader::Property::Type data_type,
+                                   bool is_list) {
+  static constexpr PropertyCallback (*make_empty_callback[16])() = {
+      []() { return PropertyCallback(std::in_place_index<0>); },
+      []() { return PropertyCallback(std::in_place_index<1>); },
+      []() { return PropertyCallback(std::in_place_index<2>); },
+      []() { return PropertyCallback(std::in_place_index<3>); },
+      []() { return PropertyCallback(std::in_place_index<4>); },
+      []() { return PropertyCallback(std::in_place_index<5>); },
+      []() { return PropertyCallback(std::in_place_index<6>); },
+      []() { return PropertyCallback(std::in_place_index<7>); },
+      []() { return PropertyCallback(std::in_place_index<8>); },
+      []() { return PropertyCallback(std::in_place_index<9>); },
+      []() { return PropertyCallback(std::in_place_index<10>); },
+      []() { return PropertyCallback(std::in_place_index<11>); },
+      []() { return PropertyCallback(std::in_place_index<12>); },
+      []() { return PropertyCallback(std::in_place_index<13>); },
+      []() { return PropertyCallback(std::in_place_index<14>); },
+      []() { return PropertyCallback(std::in_place_index<15>); }};
+
+  return make_empty_callback[2 * static_cast<size_t>(data_type) +
+                             static_cast<size_t>(is_list)]();
+}
+
+// Returns true if every instance of `element` has the same size in the input
+bool IsFixedSize(PlyHeader::Format format, const PlyHeader::Element& element) {
+  if (format == PlyHeader::Format::ASCII || element.properties.empty()) {
+    return false;
+  }
+
+  return std::ranges::none_of(element.properties,
+                              [](const PlyHeader::Property& property) {
+                                return property.list_type.has_value();
+                              });
+}
+
+// The parts of the setup of a read that depend only on the schema of its
+// header, including the parsers of each property and element. A plan is
+// compiled from the header of the first input read and then reused for each
+// following input whose header has the same schema, in which case only the
+// callbacks of the read are bound to its parsers.
+template <typename PropertyCallback>
+struct CompiledParsePlan final {
+  // Returns true if the plan was compiled from a header with the same schema
+  // as `header`.
+  bool Matches(const PlyHeader& header) const {
+    if (!compiled || format != header.format ||
+        elements.size() != header.elements.size()) {
+      return false;
+    }
+
+    for (size_t i = 0; i < elements.size(); i++) {
+      const std::vector<PlyHeader::Property>& properties =
+          elements[i].properties;
+      const std::vector<PlyHeader::Property>& header_properties =
+          header.elements[i].properties;
+      if (elements[i].name != header.elements[i].name ||
+          properties.size() != header_properties.size()) {
+        return false;
+      }
+
+      for (size_t j = 0; j < properties.size(); j++) {
+        if (properties[j].name != header_properties[j].name ||
+            properties[j].data_type != header_properties[j].data_type ||
+            properties[j].list_type != header_properties[j].list_type) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // Compiles the plan from scratch for the schema of `header`. Each property
+  // parser reports conversion failures to a copy of `on_conversion_error`,
+  // which must remain valid for as long as the plan is used.
+  template <typename OnConversionError>
+  void Compile(const PlyHeader& header,
+               const OnConversionError& on_conversion_error) {
+    record_parsers.clear();
+    parsers.clear();
+
+    compiled = true;
+    format = header.format;
+
+    elements.clear();
+    for (const PlyHeader::Element& element : header.elements) {
+      elements.emplace_back(element.name, 0u, element.properties);
+    }
+
+    sorted_properties.clear();
+    for (size_t i = 0; i < elements.size(); i++) {
+      for (size_t j = 0; j < elements[i].properties.size(); j++) {
+        sorted_properties.emplace_back(i, j);
+      }
+    }
+
+    std::ranges::sort(sorted_properties, [&](const auto& lhs, const auto& rhs) {
+      return Key(lhs) < Key(rhs);
+    });
+
+    PlyHeader::Format native_format =
+        std::endian::native == std::endian::big
+            ? PlyHeader::Format::BINARY_BIG_ENDIAN
+            : PlyHeader::Format::BINARY_LITTLE_ENDIAN;
+
+    byte_swappers.clear();
+    for (const PlyHeader::Element& element : elements) {
+      byte_swappers.emplace_back();
+      if (format != native_format && IsFixedSize(format, element)) {
+        std::vector<size_t> field_sizes;
+        for (const PlyHeader::Property& property : element.properties) {
+          field_sizes.push_back(internal::GetBinarySize(property.data_type));
+        }
+
+        byte_swappers.back().emplace(field_sizes);
+      }
+    }
+
+    for (const PlyHeader::Element& element : elements) {
+      parsers.emplace_back();
+      for (const PlyHeader::Property& property : element.properties) {
+        parsers.back().emplace_back(format, property.list_type,
+                                    property.data_type, on_conversion_error,
+                                    element.name, property.name);
+      }
+    }
+
+    // The record parsers refer to the property parsers, which are not moved
+    // again once every element has its parsers
+    for (size_t i = 0; i < elements.size(); i++) {
+      record_parsers.emplace_back();
+      if (IsFixedSize(format, elements[i])) {
+        record_parsers.back().emplace(
+            elements[i], parsers[i],
+            byte_swappers[i] ? &*byte_swappers[i] : nullptr);
+      }
+    }
+
+    callbacks.clear();
+    ReleaseCallbacks();
+  }
+
+  // Binds the parser of each property of the schema that has a callback in
+  // `callbacks` to that callback, moving it out of `callbacks`. Returns an
+  // error if a callback requests an unsupported conversion.
+  std::error_code BindCallbacks(const PlyHeader& header, size_t batch_size,
+                                bool handle_columns) {
+    // Both `callbacks` and `sorted_properties` are ordered by element name and
+    // then property name, so they are matched by walking them together
+    auto sorted_property = sorted_properties.begin();
+    for (auto& [element_name, element_callbacks] : callbacks) {
+      for (auto& [property_name, property_callback] : element_callbacks) {
+        auto requested = std::tie(element_name, property_name);
+        while (sorted_property != sorted_properties.end() &&
+               Key(*sorted_property) < requested) {
+          ++sorted_property;
+        }
+
+        if (sorted_property == sorted_properties.end() ||
+            Key(*sorted_property) != requested) {
+          continue;
+        }
+
+        auto [element_index, property_index] = *sorted_property;
+        const PlyHeader::Property& property =
+            elements[element_index].properties[property_index];
+        size_t property_type_index =
+            2u * static_cast<size_t>(property.data_type) +
+            static_cast<size_t>(property.list_type.has_value());
+        size_t callback_index = ToNonBatchIndex(property_callback.index());
+        if (IsInvalidConversion(property_type_index, callback_index)) {
+          return MakeInvalidConversionError(property_type_index,
+                                            callback_index);
+        }
+
+        ColumnHandler column_handler;
+        if (handle_columns) {
+          column_handler = MakeColumnHandler(property_callback);
+        }
+
+        parsers[element_index][property_index].Bind(
+            static_cast<PlyHeader::Property::Type>(callback_index >> 1u),
+            MakeHandler(std::move(property_callback), batch_size,
+                        header.elements[element_index].instance_count),
+            std::move(column_handler));
+      }
+    }
+
+    for (std::optional<RecordParser>& record_parser : record_parsers) {
+      if (record_parser) {
+        record_parser->Bind();
+      }
+    }
+
+    return std::error_code();
+  }
+
+  // Unbinds every parser and resets `callbacks` to hold only an empty callback
+  // for each property of the schema. Any callbacks left in `callbacks` by
+  // `Start`, including those for properties that are not in the schema, are
+  // released.
+  void ReleaseCallbacks() {
+    for (std::vector<PropertyParser>& element_parsers : parsers) {
+      for (PropertyParser& parser : element_parsers) {
+        parser.Unbind();
+      }
+    }
+
+    for (std::optional<RecordParser>& record_parser : record_parsers) {
+      if (record_parser) {
+        record_parser->Bind();
+      }
+    }
+
+    for (;;) {
+      bool has_extra_entries = false;
+      for (const PlyHeader::Element& element : elements) {
+        std::map<std::string, PropertyCallback>& property_callbacks =
+            callbacks[element.name];
+        for (const PlyHeader::Property& property : element.properties) {
+          property_callbacks.insert_or_assign(
+              property.name,
+              MakeEmptyCallback<PropertyCallback>(
+                  property.data_type, property.list_type.has_value()));
+        }
+
+        has_extra_entries |=
+            property_callbacks.size() != element.properties.size();
+      }
+
+      if (!has_extra_entries && callbacks.size() == elements.size()) {
+        return;
+      }
+
+      callbacks.clear();
+    }
+  }
+
+  std::tuple<const std::string&, const std::string&> Key(
+      const std::pair<size_t, size_t>& property) const {
+    const PlyHeader::Element& element = elements[property.first];
+    return std::tie(element.name, element.properties[property.second].name);
+  }
+
+  bool compiled = false;
+  PlyHeader::Format format = PlyHeader::Format::ASCII;
+  std::vector<PlyHeader::Element> elements;
+
+  // The callbacks passed to `Start`, which hold only an empty callback for
+  // each property of the schema between reads.
+  std::map<std::string, std::map<std::string, PropertyCallback>> callbacks;
+
+  // The element and property index of each property of the schema, ordered by
+  // element name and then property name.
+  std::vector<std::pair<size_t, size_t>> sorted_properties;
+
+  // The byte swapper of each fixed-size element if the input is binary and
+  // not in native byte order.
+  std::vector<std::optional<internal::RecordByteSwapper>> byte_swappers;
+
+  // The parser of each property of each element of the schema, which are
+  // bound to the callbacks of a read only for the duration of the read.
+  std::vector<std::vector<PropertyParser>> parsers;
+
+  // The record parser of each fixed-size element. Declared last since these
+  // refer to `parsers` and `byte_swappers`.
+  std::vector<std::optional<RecordParser>> record_parsers;
+};
+
+// Returns the compiled plan held by `plan`, creating an empty plan if needed.
+template <typename ParsePlan>
+auto& GetCompiledParsePlan(std::unique_ptr<ParsePlan>& plan) {
+  if (!plan) {
+    plan = std::make_unique<ParsePlan>();
+  }
+
+  return plan->compiled;
+}
+
+// Starts a read of the input described by `header`. `plan` is recompiled
+// unless it was compiled from a header with the same schema as `header`, after
+// which `start` is invoked to fill in the callbacks of `plan`. The callbacks
+// must then be bound with `BindCallbacks` and must be released from `plan`
+// once the read ends, including when this returns an error.
+//
+// `start` and `on_conversion_failure` must be pointers to the corresponding
+// member functions of `reader`. Since the parsers of `plan` report conversion
+// failures to `reader`, `plan` must only ever be used with `reader`.
+template <typename Reader, typename PropertyCallback,
+          typename ConversionFailureReason>
+std::error_code StartRead(
+    Reader& reader,
+    std::error_code (Reader::*start)(
+        std::map<std::string, uintmax_t>,
+        std::map<std::string, std::map<std::string, PropertyCallback>>&,
+        std::vector<std::string>, std::vector<std::string>),
+    std::error_code (Reader::*on_conversion_failure)(const std::string&,
+                                                     const std::string&,
+                                                     ConversionFailureReason),
+    PlyHeader& header, CompiledParsePlan<PropertyCallback>& plan) {
+  if (!plan.Matches(header)) {
+    plan.Compile(
+        header,
+        [&reader, on_conversion_failure](
+            const std::string& element_name, const std::string& property_name,
+            std::error_code error) -> std::error_code {
+          auto [type, payload] = *DecodeError(error.value());
+          auto [source, dest, is_list] = *DecodeOverUnderFlowPayload(payload);
+
+          ConversionFailureReason reason =
+              ConversionFailureReason::UNSIGNED_INTEGER_UNDERFLOW;
+          if (type == ErrorType::UNDERFLOW) {
+            if (dest == PlyHeader::Property::Type::FLOAT) {
+              reason = ConversionFailureReason::FLOAT_UNDERFLOW;
+            } else if (dest == PlyHeader::Property::Type::CHAR ||
+                       dest == PlyHeader::Property::Type::SHORT ||
+                       dest == PlyHeader::Property::Type::INT) {
+              reason = ConversionFailureReason::SIGNED_INTEGER_UNDERFLOW;
+            }
+          } else {
+            if (dest == PlyHeader::Property::Type::FLOAT) {
+              reason = ConversionFailureReason::FLOAT_OVERFLOW;
+            } else {
+              reason = ConversionFailureReason::INTEGER_OVERFLOW;
+            }
+          }
+
+          if (std::error_code error = (reader.*on_conversion_failure)(
+                  element_name, property_name, reason);
+              error) {
+            return error;
+          }
+
+          return error;
+        });
+  }
+
+  std::map<std::string, uintmax_t> num_element_instances;
+  for (const auto& element : header.elements) {
+    num_element_instances[element.name] = element.instance_count;
+  }
 
-std::error_code PropertyParser::Parse(std::istream& stream,
-                                      Context& context) const {
-  uint32_t length = 1;
-  if (read_length_) {
-    if (std::error_code error =
-            read_length_(stream, context, EntryType::LIST_SIZE);
-        error) {
-      return error;
-    }
+  return (reader.*start)(std::move(num_element_instances), plan.callbacks,
+                         std::move(header.comments),
+                         std::move(header.object_info));
+}
 
-    convert_length_(context, EntryType::LIST_SIZE);
+// Reads the data section of the input described by `header` from `input`.
+//
+// `start` and `on_conversion_failure` must be pointers to the corresponding
+// member functions of `reader`.
+//
+// If `index` is not null, it must have been validated against `header` and
+// `input` must be the data section of `data`.
+//
+// `plan` is set up for the read by `StartRead`.
+template <typename Reader, typename PropertyCallback,
+          typename ConversionFailureReason>
+std::error_code ReadData(
+    Reader& reader,
+    std::error_code (Reader::*start)(
+        std::map<std::string, uintmax_t>,
+        std::map<std::string, std::map<std::string, PropertyCallback>>&,
+        std::vector<std::string>, std::vector<std::string>),
+    std::error_code (Reader::*on_conversion_failure)(const std::string&,
+                                                     const std::string&,
+                                                     ConversionFailureReason),
+    size_t (Reader::*get_batch_size)() const,
+    size_t (Reader::*get_num_threads)() const, PlyHeader& header,
+    InputBuffer& input, const PlyIndex* index, std::span<const std::byte> data,
+    CompiledParsePlan<PropertyCallback>& plan) {
+  // The plan does not keep the callbacks of the read once it ends, however it
+  // ends
+  struct ReleaseCallbacksOnExit final {
+    CompiledParsePlan<PropertyCallback>& plan;
+    ~ReleaseCallbacksOnExit() { plan.ReleaseCallbacks(); }
+  } release_callbacks{plan};
 
-    length = std::get<uint32_t>(context.data);
+  if (std::error_code error =
+          StartRead(reader, start, on_conversion_failure, header, plan);
+      error) {
+    return error;
   }
 
-  for (uint32_t i = 0; i < length; i++) {
-    EntryType entry_type =
-        read_length_ ? EntryType::LIST_VALUE : EntryType::VALUE;
-    if (std::error_code error = read_(stream, context, entry_type); error) {
-      return error;
+  size_t batch_size = (reader.*get_batch_size)();
+  size_t num_threads = (reader.*get_num_threads)();
+
+  if (std::error_code error =
+          plan.BindCallbacks(header, batch_size, num_threads > 1u);
+      error) {
+    return error;
+  }
+
+  const std::vector<std::vector<PropertyParser>>& parsers = plan.parsers;
+  const std::vector<std::optional<RecordParser>>& record_parsers =
+      plan.record_parsers;
+
+  uintmax_t min_ascii_bytes_remaining =
+      header.format == PlyHeader::Format::ASCII ? MinimumASCIIDataSize(header)
+                                                : 0u;
+
+  // The threads are started once per read and shared by every element parsed
+  // on multiple threads. Inputs that are neither indexed, ASCII, nor held in
+  // memory are never parsed on multiple threads.
+  std::optional<internal::ThreadPool> thread_pool;
+  if (num_threads > 1u && (index || input.in_memory() ||
+                           header.format == PlyHeader::Format::ASCII)) {
+    thread_pool.emplace(num_threads);
+  }
+
+  std::optional<ParallelASCIIParser> parallel_ascii_parser;
+  std::optional<IndexedParallelParser> indexed_parallel_parser;
+  if (index && thread_pool) {
+    indexed_parallel_parser.emplace(*thread_pool);
+  } else if (header.format == PlyHeader::Format::ASCII && thread_pool) {
+    parallel_ascii_parser.emplace(*thread_pool);
+  }
+
+  Context context;
+  context.line_ending = header.line_ending;
+  for (size_t element_index = 0; element_index < header.elements.size();
+       element_index++) {
+    const PlyHeader::Element& element = header.elements[element_index];
+    uintmax_t min_ascii_instance_size =
+        MinimumASCIIInstanceSize(element, header.line_ending);
+
+    std::error_code eof_error = MakeUnexpectedEof(element);
+
+    if (index) {
+      const PlyIndex::Element& indexed = index->elements[element_index];
+      uintmax_t end_offset = (element_index + 1u < index->elements.size())
+                                 ? index->elements[element_index + 1u].offset
+                                 : index->end_offset;
+
+      uintmax_t position = static_cast<uintmax_t>(
+          reinterpret_cast<const std::byte*>(input.Peek().data()) -
+          data.data());
+      if (position != indexed.offset) {
+        return MakeMismatchedIndex();
+      }
+
+      // Elements whose values are all discarded are not parsed at all
+      if (std::ranges::all_of(parsers[element_index],
+                              &PropertyParser::IsNoOp)) {
+        input.Skip(static_cast<size_t>(end_offset - position));
+        continue;
+      }
+
+      if (indexed_parallel_parser && !record_parsers[element_index]) {
+        if (std::error_code error = indexed_parallel_parser->Parse(
+                input, context, parsers[element_index],
+                header.format == PlyHeader::Format::ASCII, eof_error, data,
+                indexed, index->stride, end_offset);
+            error) {
+          return error;
+        }
+
+        continue;
+      }
     }
 
-    if (std::error_code error = convert_(context, entry_type); error) {
-      return on_conversion_error_(element_name_, property_name_, error);
+    uintmax_t instance = 0;
+    if (record_parsers[element_index] && thread_pool) {
+      if (std::error_code error =
+              record_parsers[element_index]->ParseInParallel(
+                  input, *thread_pool, batch_size, element.instance_count,
+                  instance);
+          error) {
+        return error;
+      }
     }
 
-    if (append_to_list_) {
-      append_to_list_(context);
+    if (record_parsers[element_index]) {
+      if (std::error_code error = record_parsers[element_index]->Parse(
+              input, context, element.instance_count, instance);
+          error) {
+        return error;
+      }
     }
-  }
 
-  if (handler_) {
-    if (std::error_code error = handler_(context); error) {
-      return error;
+    if (parallel_ascii_parser) {
+      if (std::error_code error = parallel_ascii_parser->Parse(
+              input, context, parsers[element_index], element.instance_count,
+              eof_error, min_ascii_instance_size, min_ascii_bytes_remaining);
+          error) {
+        return error;
+      }
+
+      continue;
+    }
+
+    for (; instance < element.instance_count; instance++) {
+      if (header.format == PlyHeader::Format::ASCII) {
+        input.ExpectAtLeast(min_ascii_bytes_remaining);
+        min_ascii_bytes_remaining -=
+            std::min(min_ascii_bytes_remaining, min_ascii_instance_size);
+      }
+
+      if (std::error_code error = ParseInstance(
+              parsers[element_index],
+              header.format == PlyHeader::Format::ASCII, input, context,
+              eof_error);
+          error) {
+        return error;
+      }
     }
   }
 
   return std::error_code();
 }
 
-template <typename PropertyCallback>
-PropertyCallback MakeEmptyCallback(PlyHeader::Property::Type data_type,
-                                   bool is_list) {
-  static constexpr PropertyCallback (*make_empty_callback[16])() = {
-      []() { return PropertyCallback(std::in_place_index<0>); },
-      []() { return PropertyCallback(std::in_place_index<1>); },
-      []() { return PropertyCallback(std::in_place_index<2>); },
-      []() { return PropertyCallback(std::in_place_index<3>); },
-      []() { return PropertyCallback(std::in_place_index<4>); },
-      []() { return PropertyCallback(std::in_place_index<5>); },
-      []() { return PropertyCallback(std::in_place_index<6>); },
-      []() { return PropertyCallback(std::in_place_index<7>); },
-      []() { return PropertyCallback(std::in_place_index<8>); },
-      []() { return PropertyCallback(std::in_place_index<9>); },
-      []() { return PropertyCallback(std::in_place_index<10>); },
-      []() { return PropertyCallback(std::in_place_index<11>); },
-      []() { return PropertyCallback(std::in_place_index<12>); },
-      []() { return PropertyCallback(std::in_place_index<13>); },
-      []() { return PropertyCallback(std::in_place_index<14>); },
-      []() { return PropertyCallback(std::in_place_index<15>); }};
+// Returns the number of bytes at the start of `data` taken by the leading
+// instances of `element` whose parsing does not depend on any of the input that
+// follows `data`, counting at most `max_instances` instances, and sets
+// `num_instances` to the number of instances counted. An instance that is
+// certain to fail to parse is counted along with the rest of `data` so that
+// parsing it reports the same error as parsing the complete input would.
+size_t MeasureInstances(PlyHeader::Format format, std::string_view line_ending,
+                        const PlyHeader::Element& element,
+                        std::span<const std::byte> data,
+                        uintmax_t max_instances, uintmax_t& num_instances) {
+  num_instances = 0u;
 
-  return make_empty_callback[2 * static_cast<size_t>(data_type) +
-                             static_cast<size_t>(is_list)]();
+  if (format == PlyHeader::Format::ASCII) {
+    const char* begin = reinterpret_cast<const char*>(data.data());
+    const char* end = begin + data.size();
+
+    size_t offset = 0u;
+    while (num_instances < max_instances) {
+      bool has_tabs = false;
+      const char* position =
+          internal::FindLineEnd(begin + offset, end, has_tabs);
+      if (position == end) {
+        break;
+      }
+
+      // Mismatched line endings and invalid characters fail the instance
+      if (*position != line_ending[0]) {
+        num_instances += 1u;
+        return data.size();
+      }
+
+      if (line_ending.size() > 1u) {
+        if (position + 1 == end) {
+          break;
+        }
+
+        if (position[1] != line_ending[1]) {
+          num_instances += 1u;
+          return data.size();
+        }
+      }
+
+      offset = static_cast<size_t>(position - begin) + line_ending.size();
+      num_instances += 1u;
+    }
+
+    return offset;
+  }
+
+  // Instances with no properties take no bytes of the input
+  if (element.properties.empty()) {
+    num_instances = max_instances;
+    return 0u;
+  }
+
+  if (IsFixedSize(format, element)) {
+    size_t record_size = 0u;
+    for (const PlyHeader::Property& property : element.properties) {
+      record_size += internal::GetBinarySize(property.data_type);
+    }
+
+    num_instances =
+        std::min<uintmax_t>(max_instances, data.size() / record_size);
+
+    return static_cast<size_t>(num_instances) * record_size;
+  }
+
+  PlyHeader::Format native_format =
+      std::endian::native == std::endian::big
+          ? PlyHeader::Format::BINARY_BIG_ENDIAN
+          : PlyHeader::Format::BINARY_LITTLE_ENDIAN;
+  bool swap_bytes = format != native_format;
+
+  size_t offset = 0u;
+  while (num_instances < max_instances) {
+    size_t instance_end = offset;
+    for (const PlyHeader::Property& property : element.properties) {
+      uintmax_t size = internal::GetBinarySize(property.data_type);
+      if (property.list_type) {
+        size_t list_size_size = internal::GetBinarySize(*property.list_type);
+        if (data.size() - instance_end < list_size_size) {
+          return offset;
+        }
+
+        // Negative list sizes fail the instance
+        uintmax_t list_size;
+        if (!internal::ReadListSize(data.data() + instance_end,
+                                    *property.list_type, swap_bytes,
+                                    list_size)) {
+          num_instances += 1u;
+          return data.size();
+        }
+
+        instance_end += list_size_size;
+        size = internal::SaturatingMultiply(list_size, size);
+      }
+
+      if (data.size() - instance_end < size) {
+        return offset;
+      }
+
+      instance_end += static_cast<size_t>(size);
+    }
+
+    offset = instance_end;
+    num_instances += 1u;
+  }
+
+  return offset;
 }
 
 }  // namespace
 
+struct PlyReader::ParsePlan final {
+  CompiledParsePlan<PropertyCallback> compiled;
+};
+
+PlyReader::ParsePlanCache::ParsePlanCache() = default;
+
+PlyReader::ParsePlanCache::ParsePlanCache(const ParsePlanCache&) {}
+
+PlyReader::ParsePlanCache& PlyReader::ParsePlanCache::operator=(
+    const ParsePlanCache&) {
+  return *this;
+}
+
+PlyReader::ParsePlanCache::~ParsePlanCache() = default;
+
 std::error_code PlyReader::ReadFrom(std::istream& stream) {
   if (!stream) {
     return MakeBadStreamError();
@@ -1102,155 +3468,326 @@ std::error_code PlyReader::ReadFrom(std::istream& stream) {
     return header.error();
   }
 
-  std::map<std::string, uintmax_t> num_element_instances;
-  std::map<std::string, std::map<std::string, PropertyCallback>>
-      requested_callbacks;
-  std::map<std::string, std::map<std::string, PropertyCallback>>
-      actual_callbacks;
-  for (const auto& element : header->elements) {
-    num_element_instances[element.name] = element.instance_count;
+  InputBuffer input(stream, header->format != PlyHeader::Format::ASCII
+                                ? MinimumBinaryDataSize(*header)
+                                : 0u);
 
-    std::map<std::string, PropertyCallback>& actual_property_callbacks =
-        actual_callbacks[element.name];
-    std::map<std::string, PropertyCallback>& requested_property_callbacks =
-        requested_callbacks[element.name];
-    for (const auto& property : element.properties) {
-      actual_property_callbacks.emplace(
-          property.name,
-          MakeEmptyCallback<PropertyCallback>(property.data_type,
-                                              property.list_type.has_value()));
-      requested_property_callbacks.emplace(
-          property.name,
-          MakeEmptyCallback<PropertyCallback>(property.data_type,
-                                              property.list_type.has_value()));
-    }
+  return ReadData(*this, &PlyReader::Start, &PlyReader::OnConversionFailure,
+                  &PlyReader::GetBatchSize, &PlyReader::GetNumThreads,
+                  *header, input, /*index=*/nullptr, /*data=*/{},
+                  GetCompiledParsePlan(parse_plan_cache_.plan));
+}
+
+std::error_code PlyReader::ReadFrom(ByteSource& source) {
+  auto header = ReadPlyHeader(source);
+  if (!header) {
+    return header.error();
   }
 
-  if (std::error_code error =
-          Start(std::move(num_element_instances), requested_callbacks,
-                std::move(header->comments), std::move(header->object_info));
+  InputBuffer input(source);
+
+  std::error_code result = ReadData(
+      *this, &PlyReader::Start, &PlyReader::OnConversionFailure,
+      &PlyReader::GetBatchSize, &PlyReader::GetNumThreads, *header, input,
+      /*index=*/nullptr, /*data=*/{},
+      GetCompiledParsePlan(parse_plan_cache_.plan));
+
+  if (input.source_error()) {
+    return input.source_error();
+  }
+
+  input.BackUpSource();
+
+  return result;
+}
+
+std::error_code PlyReader::ReadFrom(std::span<const std::byte> data) {
+  auto header = ReadPlyHeader(data);
+  if (!header) {
+    return header.error();
+  }
+
+  InputBuffer input(data.subspan(header->data_offset));
+
+  return ReadData(*this, &PlyReader::Start, &PlyReader::OnConversionFailure,
+                  &PlyReader::GetBatchSize, &PlyReader::GetNumThreads,
+                  *header, input, /*index=*/nullptr, /*data=*/{},
+                  GetCompiledParsePlan(parse_plan_cache_.plan));
+}
+
+std::error_code PlyReader::ReadFrom(std::span<const std::byte> data,
+                                    const PlyIndex& index) {
+  auto header = ReadPlyHeader(data);
+  if (!header) {
+    return header.error();
+  }
+
+  if (std::error_code error = ValidatePlyIndex(index, *header, data.size());
       error) {
     return error;
   }
 
-  for (auto& [element_name, element_callbacks] : requested_callbacks) {
-    auto element_iter = actual_callbacks.find(element_name);
-    if (element_iter == actual_callbacks.end()) {
-      continue;
+  InputBuffer input(data.subspan(header->data_offset));
+
+  return ReadData(*this, &PlyReader::Start, &PlyReader::OnConversionFailure,
+                  &PlyReader::GetBatchSize, &PlyReader::GetNumThreads,
+                  *header, input, &index, data,
+                  GetCompiledParsePlan(parse_plan_cache_.plan));
+}
+
+std::error_code PlyReader::ReadFrom(const std::filesystem::path& path) {
+  auto file = internal::MappedFile::Open(path);
+  if (!file) {
+    return file.error();
+  }
+
+  return ReadFrom(file->data());
+}
+
+std::error_code PlyReader::ReadFrom(const std::filesystem::path& path,
+                                    const PlyIndex& index) {
+  auto file = internal::MappedFile::Open(path);
+  if (!file) {
+    return file.error();
+  }
+
+  return ReadFrom(file->data(), index);
+}
+
+// The parse state of a `PlyPushReader`, which is kept between calls to `Feed`
+// so that the input is never waited on. The bytes of the input that cannot yet
+// be parsed, which are those of the header until the header is complete and
+// afterwards those of the instance that ends past the input received so far,
+// are held in `pending`. Every other byte is parsed in place from the chunk
+// passed to `Feed`.
+struct PlyPushReader::State final {
+  explicit State(PlyReader& reader) : reader(reader) {}
+
+  ~State() {
+    if (plan) {
+      plan->ReleaseCallbacks();
     }
+  }
 
-    for (auto& [property_name, property_callback] : element_callbacks) {
-      auto property_iter = element_iter->second.find(property_name);
-      if (property_iter == element_iter->second.end()) {
-        continue;
+  // Parses the leading bytes of `data` that can be parsed without the input
+  // that follows it and sets `consumed` to the number of bytes parsed. `data`
+  // starts at the first byte of the input not yet consumed. If `end_of_input`
+  // is set, `data` holds the rest of the input and is parsed to the end of the
+  // data section.
+  std::error_code Consume(std::span<const std::byte> data, bool end_of_input,
+                          size_t& consumed);
+
+  // Ends the read with `error`, which is returned by every later call to
+  // `Feed` or `Finish`, and releases the callbacks of the read.
+  std::error_code Complete(std::error_code error) {
+    result = error;
+    pending.clear();
+
+    if (plan) {
+      plan->ReleaseCallbacks();
+      plan = nullptr;
+    }
+
+    return error;
+  }
+
+  // Returns true once every instance of every element has been parsed.
+  bool finished() const {
+    return header && element_index == header->elements.size();
+  }
+
+  PlyReader& reader;
+  std::optional<PlyHeader> header;
+  CompiledParsePlan<PlyReader::PropertyCallback>* plan = nullptr;
+  Context context;
+  size_t element_index = 0u;
+  uintmax_t instance = 0u;
+  std::vector<std::byte> pending;
+
+  // The number of bytes of the incomplete header that have been searched for
+  // the end of a line, after which the header is next parsed.
+  size_t header_searched = 0u;
+
+  std::optional<std::error_code> result;
+};
+
+std::error_code PlyPushReader::State::Consume(std::span<const std::byte> data,
+                                              bool end_of_input,
+                                              size_t& consumed) {
+  consumed = 0u;
+
+  if (!header) {
+    if (end_of_input) {
+      auto parsed = ReadPlyHeader(data);
+      if (!parsed) {
+        return parsed.error();
       }
 
-      if (IsInvalidConversion(property_iter->second.index(),
-                              property_callback.index())) {
-        return MakeInvalidConversionError(property_iter->second.index(),
-                                          property_callback.index());
+      header = std::move(*parsed);
+    } else {
+      // A header is only completed by the end of a line or by the byte that
+      // follows a carriage return, so it is not parsed again until one arrives
+      std::string_view text(reinterpret_cast<const char*>(data.data()),
+                            data.size());
+      size_t search_from = header_searched > 0u ? header_searched - 1u : 0u;
+      header_searched = data.size();
+      if (text.find_first_of("\r\n", search_from) == std::string_view::npos) {
+        return std::error_code();
+      }
+
+      auto parsed = ReadPartialPlyHeader(data);
+      if (!parsed) {
+        return parsed.error();
+      }
+
+      if (!*parsed) {
+        return std::error_code();
       }
 
-      property_iter->second = std::move(property_callback);
+      header = std::move(**parsed);
     }
-  }
 
-  std::vector<std::vector<PropertyParser>> parsers;
-  for (const PlyHeader::Element& element : header->elements) {
-    parsers.emplace_back();
-    for (const PlyHeader::Property& property : element.properties) {
-      size_t callback_index = actual_callbacks.find(element.name)
-                                  ->second.find(property.name)
-                                  ->second.index();
-      parsers.back().emplace_back(
-          header->format, property.list_type, property.data_type,
-          static_cast<PlyHeader::Property::Type>(callback_index >> 1u),
-          MakeHandler(std::move(actual_callbacks.find(element.name)
-                                    ->second.find(property.name)
-                                    ->second)),
-          [&, this](const std::string& element_name,
-                    const std::string& property_name,
-                    std::error_code error) -> std::error_code {
-            auto [type, payload] = *DecodeError(error.value());
-            auto [source, dest, is_list] = *DecodeOverUnderFlowPayload(payload);
-
-            ConversionFailureReason reason =
-                ConversionFailureReason::UNSIGNED_INTEGER_UNDERFLOW;
-            if (type == ErrorType::UNDERFLOW) {
-              if (dest == PlyHeader::Property::Type::FLOAT) {
-                reason = ConversionFailureReason::FLOAT_UNDERFLOW;
-              } else if (dest == PlyHeader::Property::Type::CHAR ||
-                         dest == PlyHeader::Property::Type::SHORT ||
-                         dest == PlyHeader::Property::Type::INT) {
-                reason = ConversionFailureReason::SIGNED_INTEGER_UNDERFLOW;
-              }
-            } else {
-              if (dest == PlyHeader::Property::Type::FLOAT) {
-                reason = ConversionFailureReason::FLOAT_OVERFLOW;
-              } else {
-                reason = ConversionFailureReason::INTEGER_OVERFLOW;
-              }
-            }
+    plan = &GetCompiledParsePlan(reader.parse_plan_cache_.plan);
 
-            if (std::error_code error =
-                    OnConversionFailure(element_name, property_name, reason);
-                error) {
-              return error;
-            }
+    if (std::error_code error =
+            StartRead(reader, &PlyReader::Start,
+                      &PlyReader::OnConversionFailure, *header, *plan);
+        error) {
+      return error;
+    }
 
-            return error;
-          },
-          element.name, property.name);
+    if (std::error_code error = plan->BindCallbacks(
+            *header, reader.GetBatchSize(), /*handle_columns=*/false);
+        error) {
+      return error;
     }
+
+    context.line_ending = header->line_ending;
+    consumed = header->data_offset;
   }
 
-  Context context;
-  context.line_ending = header->line_ending;
-  for (size_t element_index = 0; element_index < header->elements.size();
-       element_index++) {
+  bool is_ascii = header->format == PlyHeader::Format::ASCII;
+  for (; element_index < header->elements.size();
+       element_index++, instance = 0u) {
     const PlyHeader::Element& element = header->elements[element_index];
-    for (size_t instance = 0; instance < element.instance_count; instance++) {
-      if (header->format == PlyHeader::Format::ASCII) {
-        std::error_code eof_error = MakeUnexpectedEofNoProperties();
-        if (!element.properties.empty()) {
-          const PlyHeader::Property& property = element.properties.front();
-          if (property.list_type) {
-            eof_error =
-                MakeUnexpectedEof(EntryType::LIST_SIZE, *property.list_type);
-          } else {
-            eof_error = MakeUnexpectedEof(EntryType::VALUE, property.data_type);
-          }
-        }
+    std::span<const std::byte> remaining = data.subspan(consumed);
 
-        if (std::error_code error = ReadNextLine(stream, context, eof_error);
-            error) {
-          return error;
-        }
-      }
+    uintmax_t num_instances = element.instance_count - instance;
+    size_t size = remaining.size();
+    if (!end_of_input) {
+      size = MeasureInstances(header->format, header->line_ending, element,
+                              remaining, num_instances, num_instances);
+    }
 
-      for (size_t property_index = 0;
-           property_index < header->elements[element_index].properties.size();
-           property_index++) {
-        if (std::error_code error =
-                parsers[element_index][property_index].Parse(stream, context);
-            error) {
-          return error;
-        }
+    InputBuffer input(remaining.first(size));
+
+    uintmax_t num_parsed = 0u;
+    if (const std::optional<RecordParser>& record_parser =
+            plan->record_parsers[element_index];
+        record_parser) {
+      if (std::error_code error =
+              record_parser->Parse(input, context, num_instances, num_parsed);
+          error) {
+        return error;
       }
+    }
 
-      if (header->format == PlyHeader::Format::ASCII) {
-        std::error_code error =
-            ReadNextToken(context, false, MakeUnusedToken(), MakeUnusedToken());
-        if (!error) {
-          return MakeUnusedToken();
-        }
+    std::error_code eof_error = MakeUnexpectedEof(element);
+    for (; num_parsed < num_instances; num_parsed++) {
+      if (std::error_code error =
+              ParseInstance(plan->parsers[element_index], is_ascii, input,
+                            context, eof_error);
+          error) {
+        return error;
       }
     }
+
+    consumed += size - input.Peek().size();
+    instance += num_instances;
+
+    if (instance < element.instance_count) {
+      break;
+    }
+  }
+
+  return std::error_code();
+}
+
+PlyPushReader::PlyPushReader(PlyReader& reader)
+    : state_(std::make_unique<State>(reader)) {}
+
+PlyPushReader::~PlyPushReader() = default;
+
+std::error_code PlyPushReader::Feed(std::span<const std::byte> chunk) {
+  // The number of bytes of `chunk` first added to `pending` at a time. This
+  // is grown to the size of `pending` so that each byte of an instance much
+  // larger than a chunk is copied a bounded number of times.
+  static constexpr size_t kMinPendingGrowth = 4096u;
+
+  if (state_->result) {
+    return *state_->result;
+  }
+
+  size_t consumed;
+  while (!state_->pending.empty()) {
+    if (chunk.empty()) {
+      return std::error_code();
+    }
+
+    size_t num_pending = state_->pending.size();
+    size_t num_taken =
+        std::min(chunk.size(), std::max(num_pending, kMinPendingGrowth));
+    state_->pending.insert(state_->pending.end(), chunk.begin(),
+                           chunk.begin() + num_taken);
+
+    if (std::error_code error =
+            state_->Consume(state_->pending, /*end_of_input=*/false, consumed);
+        error) {
+      return state_->Complete(error);
+    }
+
+    if (state_->finished()) {
+      return state_->Complete(std::error_code());
+    }
+
+    // Once the bytes held over from earlier chunks have been consumed, the
+    // rest of `chunk` is parsed in place
+    if (consumed >= num_pending) {
+      chunk = chunk.subspan(consumed - num_pending);
+      state_->pending.clear();
+      break;
+    }
+
+    state_->pending.erase(state_->pending.begin(),
+                          state_->pending.begin() + consumed);
+    chunk = chunk.subspan(num_taken);
+  }
+
+  if (std::error_code error =
+          state_->Consume(chunk, /*end_of_input=*/false, consumed);
+      error) {
+    return state_->Complete(error);
+  }
+
+  if (state_->finished()) {
+    return state_->Complete(std::error_code());
   }
 
+  state_->pending.assign(chunk.begin() + consumed, chunk.end());
+
   return std::error_code();
 }
 
+std::error_code PlyPushReader::Finish() {
+  if (state_->result) {
+    return *state_->result;
+  }
+
+  size_t consumed;
+  return state_->Complete(
+      state_->Consume(state_->pending, /*end_of_input=*/true, consumed));
+}
+
 // Static assertions to ensure float types are properly sized
 static_assert(std::numeric_limits<double>::is_iec559 && sizeof(double) == 8);
 static_assert(std::numeric_limits<float>::is_iec559 && sizeof(float) == 4);
@@ -1,18 +1,26 @@
 #ifndef _PLYODINE_PLY_READER_
 #define _PLYODINE_PLY_READER_
 
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <istream>
 #include <map>
+#include <memory>
 #include <span>
 #include <string>
 #include <system_error>
 #include <variant>
 #include <vector>
 
+#include "plyodine/byte_source.h"
+#include "plyodine/ply_index.h"
+
 namespace plyodine {
 
+class PlyPushReader;
+
 // The base class enabling PLY deserialization.
 class PlyReader {
  public:
@@ -27,6 +35,56 @@ class PlyReader {
   // NOTE: Behavior is undefined if `stream` is not a binary stream.
   std::error_code ReadFrom(std::istream& stream);
 
+  // Reads the contents of `data` as a PLY file. On success, the function
+  // returns an `std::error_code` containing a zero value. On failure, returns
+  // an `std::error_code` containing a non-zero value. Any bytes following the
+  // end of the data section are ignored.
+  //
+  // Values are decoded in place which avoids the overhead of copying the input
+  // through a stream buffer.
+  std::error_code ReadFrom(std::span<const std::byte> data);
+
+  // Reads the buffers returned by `source` as a PLY file. On success, the
+  // function returns an `std::error_code` containing a zero value and the
+  // bytes following the end of the data section are returned to `source`. On
+  // failure, returns an `std::error_code` containing a non-zero value and the
+  // source will be left in an undefined state. If the source fails, its error
+  // is returned.
+  //
+  // Values are decoded in place from each buffer and only values that span
+  // two buffers are copied.
+  std::error_code ReadFrom(ByteSource& source);
+
+  // Reads the file at `path` as a PLY file. On success, the function returns an
+  // `std::error_code` containing a zero value. On failure, returns an
+  // `std::error_code` containing a non-zero value. If the file could not be
+  // opened or read, the error is always reported using `std::generic_category`,
+  // such as `std::errc::no_such_file_or_directory`, and is
+  // `std::errc::io_error` when the reason is unknown.
+  //
+  // Where supported, the file is memory mapped rather than read through a
+  // stream.
+  std::error_code ReadFrom(const std::filesystem::path& path);
+
+  // Reads the contents of `data` as a PLY file using an index of its elements
+  // previously built by `BuildPlyIndex`. The index is checked against the
+  // header of the input before any callbacks are set up and an error is
+  // returned if it does not match.
+  //
+  // Elements for which no values are requested are skipped without being
+  // parsed and so are not checked for errors. If `GetNumThreads` returns more
+  // than one, elements that contain property lists and the elements of ASCII
+  // inputs are parsed on multiple threads starting from the checkpoints
+  // recorded in the index.
+  std::error_code ReadFrom(std::span<const std::byte> data,
+                           const PlyIndex& index);
+
+  // Reads the file at `path` as a PLY file using an index of its elements. See
+  // the overloads above for details, including how errors opening the file are
+  // reported.
+  std::error_code ReadFrom(const std::filesystem::path& path,
+                           const PlyIndex& index);
+
  protected:
   // The reason a type conversion failed.
   enum class ConversionFailureReason {
@@ -143,16 +201,81 @@ class PlyReader {
   using DoublePropertyListCallback =
       std::move_only_function<std::error_code(std::span<const double>)>;
 
+  // A callback that receives the values of consecutive instances of a char
+  // property in batches. `first_instance` is the index of the instance to
+  // which the first entry of `values` belongs. Values are delivered once
+  // `GetBatchSize()` of them have been read or once the final instance of the
+  // element has been read, whichever is first.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using CharPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const int8_t> values)>;
+
+  // A callback that receives the values of consecutive instances of a uchar
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using UCharPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const uint8_t> values)>;
+
+  // A callback that receives the values of consecutive instances of a short
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using ShortPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const int16_t> values)>;
+
+  // A callback that receives the values of consecutive instances of a ushort
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using UShortPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const uint16_t> values)>;
+
+  // A callback that receives the values of consecutive instances of an int
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using IntPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const int32_t> values)>;
+
+  // A callback that receives the values of consecutive instances of a uint
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using UIntPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const uint32_t> values)>;
+
+  // A callback that receives the values of consecutive instances of a float
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using FloatPropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const float> values)>;
+
+  // A callback that receives the values of consecutive instances of a double
+  // property in batches.
+  //
+  // On success, returns an `std::error_code` with a zero-value.
+  using DoublePropertyBatchCallback = std::move_only_function<std::error_code(
+      uintmax_t first_instance, std::span<const double> values)>;
+
   // A variant that contains the callback for a property. The type of the
-  // variant determines the type of the property in the input.
-  typedef std::variant<CharPropertyCallback, CharPropertyListCallback,
-                       UCharPropertyCallback, UCharPropertyListCallback,
-                       ShortPropertyCallback, ShortPropertyListCallback,
-                       UShortPropertyCallback, UShortPropertyListCallback,
-                       IntPropertyCallback, IntPropertyListCallback,
-                       UIntPropertyCallback, UIntPropertyListCallback,
-                       FloatPropertyCallback, FloatPropertyListCallback,
-                       DoublePropertyCallback, DoublePropertyListCallback>
+  // variant determines the type of the property in the input. The batch
+  // callbacks are never passed to `Start`, but may be used in place of the
+  // callback of a non-list property.
+  typedef std::variant<
+      CharPropertyCallback, CharPropertyListCallback, UCharPropertyCallback,
+      UCharPropertyListCallback, ShortPropertyCallback,
+      ShortPropertyListCallback, UShortPropertyCallback,
+      UShortPropertyListCallback, IntPropertyCallback, IntPropertyListCallback,
+      UIntPropertyCallback, UIntPropertyListCallback, FloatPropertyCallback,
+      FloatPropertyListCallback, DoublePropertyCallback,
+      DoublePropertyListCallback, CharPropertyBatchCallback,
+      UCharPropertyBatchCallback, ShortPropertyBatchCallback,
+      UShortPropertyBatchCallback, IntPropertyBatchCallback,
+      UIntPropertyBatchCallback, FloatPropertyBatchCallback,
+      DoublePropertyBatchCallback>
       PropertyCallback;
 
  private:
@@ -178,6 +301,10 @@ class PlyReader {
   // event a supported conversion fails, the failure can be observed by
   // implementing `OnConversionFailure`.
   //
+  // The values of properties left with an empty callback and an unchanged type
+  // are skipped over rather than decoded. For ASCII inputs, this means that
+  // their tokens are not checked to be valid numbers.
+  //
   // `comments`: The comments in the that used the comment prefix.
   //
   // `object_info`: The comments in the header that used the obj_info prefix.
@@ -198,6 +325,43 @@ class PlyReader {
                                               ConversionFailureReason reason) {
     return std::error_code();
   }
+
+  // If implemented, controls the maximum number of values passed to each
+  // invocation of a batch callback. Values of zero are treated as one.
+  virtual size_t GetBatchSize() const { return 65536u; }
+
+  // If implemented, controls the number of threads used to parse the data
+  // section of ASCII inputs. For binary inputs read from memory, the elements
+  // with no property lists whose properties are each either skipped or
+  // received with a batch callback are also decoded using this many threads.
+  // Callbacks are always invoked on the thread that called `ReadFrom` and in
+  // the order in which the values appear in the input regardless of the number
+  // of threads used. Values of zero or one disable parsing on additional
+  // threads.
+  virtual size_t GetNumThreads() const { return 1u; }
+
+ private:
+  friend class PlyPushReader;
+
+  struct ParsePlan;
+
+  // Holds the parse plan compiled from the header of the most recently read
+  // input. The plan is reused by the next read of an input whose header has
+  // the same format, elements, and properties, which skips rebuilding the
+  // callback tables, parsers, and other setup that depends only on the schema.
+  // The callbacks of a read are not kept once it ends. Copies of a reader start
+  // with an empty cache.
+  class ParsePlanCache final {
+   public:
+    ParsePlanCache();
+    ParsePlanCache(const ParsePlanCache&);
+    ParsePlanCache& operator=(const ParsePlanCache&);
+    ~ParsePlanCache();
+
+    std::unique_ptr<ParsePlan> plan;
+  };
+
+  ParsePlanCache parse_plan_cache_;
 };
 
 }  // namespace plyodine
@@ -1,6 +1,12 @@
 #include "plyodine/ply_reader.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
 #include <fstream>
 #include <limits>
 #include <map>
@@ -9,11 +15,14 @@
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "googlemock/include/gmock/gmock.h"
 #include "googletest/include/gtest/gtest.h"
+#include "plyodine/byte_source.h"
+#include "plyodine/ply_index.h"
 #include "tools/cpp/runfiles/runfiles.h"
 
 namespace plyodine {
@@ -354,13 +363,21 @@ MATCHER_P(ValuesAre, values, "") {
   return true;
 }
 
-std::ifstream OpenRunfile(const std::string& path) {
+std::filesystem::path RunfilePath(const std::string& path) {
   std::unique_ptr<Runfiles> runfiles(Runfiles::CreateForTest());
-  return std::ifstream(runfiles->Rlocation(path),
-                       std::ios::in | std::ios::binary);
+  return runfiles->Rlocation(path);
 }
 
-void ExpectError(std::istream& stream) {
+std::ifstream OpenRunfile(const std::string& path) {
+  return std::ifstream(RunfilePath(path), std::ios::in | std::ios::binary);
+}
+
+std::span<const std::byte> AsBytes(const std::string& string) {
+  return std::as_bytes(std::span(string.data(), string.size()));
+}
+
+template <typename Input>
+std::error_code ReadAll(Input&& input) {
   MockPlyReader reader;
   EXPECT_CALL(reader, StartImpl(_, _, _))
       .WillRepeatedly(Return(std::error_code()));
@@ -397,7 +414,11 @@ void ExpectError(std::istream& stream) {
   EXPECT_CALL(reader, HandleDoubleList(_, _, _))
       .WillRepeatedly(Return(std::error_code()));
 
-  EXPECT_NE(0, reader.ReadFrom(stream).value());
+  return reader.ReadFrom(std::forward<Input>(input));
+}
+
+void ExpectError(std::istream& stream) {
+  EXPECT_NE(0, ReadAll(stream).value());
 }
 
 void RunReadErrorTest(const std::string& file_name,
@@ -419,6 +440,10 @@ void RunReadErrorTest(const std::string& file_name,
     string_copy.resize(i);
     std::stringstream stream(string_copy, std::ios::in | std::ios::binary);
     ExpectError(stream);
+
+    stream.clear();
+    stream.seekg(0);
+    EXPECT_EQ(ReadAll(stream), ReadAll(AsBytes(string_copy)));
   }
 }
 
@@ -2289,6 +2314,1250 @@ TEST(LittleEndian, WithNegativeIntListSize) {
                          "'int' that had a length that was out of range"));
 }
 
+TEST(LittleEndian, StopsAtEndOfData) {
+  std::ifstream input =
+      OpenRunfile("_main/plyodine/test_data/ply_little_data.ply");
+
+  std::string contents;
+  char c;
+  while (input.get(c)) {
+    contents += c;
+  }
+
+  contents += "trailing";
+
+  MockPlyReader reader;
+  reader.initialize_callbacks = false;
+
+  EXPECT_CALL(reader, StartImpl(_, _, _))
+      .Times(1)
+      .WillOnce(Return(std::error_code()));
+
+  std::stringstream stream(contents, std::ios::in | std::ios::binary);
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+
+  std::string remaining;
+  while (stream.get(c)) {
+    remaining += c;
+  }
+
+  EXPECT_EQ("trailing", remaining);
+}
+
+class ValueCollectingPlyReader final : public PlyReader {
+ public:
+  std::vector<uint32_t> values;
+  std::vector<std::vector<uint16_t>> lists;
+  size_t num_threads = 1u;
+  size_t fail_at_value = std::numeric_limits<size_t>::max();
+  bool skip_lists = false;
+
+ private:
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    callbacks["vertex"]["a"] = UIntPropertyCallback([this](uint32_t value) {
+      if (values.size() == fail_at_value) {
+        return std::make_error_code(std::errc::invalid_argument);
+      }
+      values.push_back(value);
+      return std::error_code();
+    });
+    if (!skip_lists) {
+      callbacks["vertex"]["b"] =
+          UShortPropertyListCallback([this](std::span<const uint16_t> value) {
+            lists.emplace_back(value.begin(), value.end());
+            return std::error_code();
+          });
+    }
+    return std::error_code();
+  }
+
+  size_t GetNumThreads() const override { return num_threads; }
+};
+
+std::string MakeLargeInput(std::endian endianness, uint32_t num_instances) {
+  std::string result =
+      std::string("ply\nformat ") +
+      (endianness == std::endian::big ? "binary_big_endian"
+                                      : "binary_little_endian") +
+      " 1.0\nelement vertex " + std::to_string(num_instances) +
+      "\nproperty uint a\nproperty list uchar ushort b\nend_header\n";
+
+  auto append = [&](auto value) {
+    if (endianness != std::endian::native) {
+      value = std::byteswap(value);
+    }
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  for (uint32_t i = 0; i < num_instances; i++) {
+    append(i);
+    append(static_cast<uint8_t>(i % 7u));
+    for (uint32_t j = 0; j < i % 7u; j++) {
+      append(static_cast<uint16_t>(i + j));
+    }
+  }
+
+  return result;
+}
+
+void ExpectLargeInput(const ValueCollectingPlyReader& reader,
+                      uint32_t num_instances) {
+  ASSERT_EQ(num_instances, reader.values.size());
+  ASSERT_EQ(num_instances, reader.lists.size());
+  for (uint32_t i = 0; i < num_instances; i++) {
+    EXPECT_EQ(i, reader.values[i]);
+    ASSERT_EQ(i % 7u, reader.lists[i].size());
+    for (uint32_t j = 0; j < i % 7u; j++) {
+      EXPECT_EQ(static_cast<uint16_t>(i + j), reader.lists[i][j]);
+    }
+  }
+}
+
+TEST(LittleEndian, LargeInput) {
+  std::stringstream stream(MakeLargeInput(std::endian::little, 100000u),
+                           std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ExpectLargeInput(reader, 100000u);
+  EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+}
+
+TEST(BigEndian, LargeInput) {
+  std::stringstream stream(MakeLargeInput(std::endian::big, 100000u),
+                           std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ExpectLargeInput(reader, 100000u);
+  EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+}
+
+TEST(LittleEndian, LargeInputTruncated) {
+  std::string input = MakeLargeInput(std::endian::little, 100000u);
+  input.resize(input.size() - 1u);
+
+  std::stringstream stream(input, std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_THAT(reader.ReadFrom(stream).message(),
+              StartsWith("The input ended earlier than expected"));
+}
+
+TEST(LittleEndian, LargeInputSpan) {
+  std::string input = MakeLargeInput(std::endian::little, 100000u);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  ExpectLargeInput(reader, 100000u);
+}
+
+TEST(BigEndian, LargeInputSpan) {
+  std::string input = MakeLargeInput(std::endian::big, 100000u);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  ExpectLargeInput(reader, 100000u);
+}
+
+TEST(LittleEndian, LargeInputSpanTruncated) {
+  std::string input = MakeLargeInput(std::endian::little, 100000u);
+  input.resize(input.size() - 1u);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_THAT(reader.ReadFrom(AsBytes(input)).message(),
+              StartsWith("The input ended earlier than expected"));
+}
+
+TEST(LittleEndian, SkipsUnrequestedLists) {
+  std::string contents =
+      MakeLargeInput(std::endian::little, 100000u) + "trailing";
+
+  std::stringstream stream(contents, std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  reader.skip_lists = true;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ASSERT_EQ(100000u, reader.values.size());
+  for (uint32_t i = 0; i < 100000u; i++) {
+    EXPECT_EQ(i, reader.values[i]);
+  }
+  EXPECT_TRUE(reader.lists.empty());
+
+  std::string remaining;
+  char c;
+  while (stream.get(c)) {
+    remaining += c;
+  }
+
+  EXPECT_EQ("trailing", remaining);
+}
+
+TEST(BigEndian, SkipsUnrequestedListsTruncated) {
+  std::string input = MakeLargeInput(std::endian::big, 1000u);
+  for (size_t removed = 1u; removed < 16u; removed++) {
+    std::string truncated = input.substr(0u, input.size() - removed);
+
+    std::stringstream expected_stream(truncated,
+                                      std::ios::in | std::ios::binary);
+    ValueCollectingPlyReader expected;
+    std::error_code expected_error = expected.ReadFrom(expected_stream);
+
+    std::stringstream actual_stream(truncated,
+                                    std::ios::in | std::ios::binary);
+    ValueCollectingPlyReader actual;
+    actual.skip_lists = true;
+    EXPECT_EQ(expected_error, actual.ReadFrom(actual_stream));
+    EXPECT_EQ(expected.values, actual.values);
+
+    ValueCollectingPlyReader span_reader;
+    span_reader.skip_lists = true;
+    EXPECT_EQ(expected_error, span_reader.ReadFrom(AsBytes(truncated)));
+    EXPECT_EQ(expected.values, span_reader.values);
+  }
+}
+
+// Makes an input containing lists that span many blocks of the input buffer
+std::string MakeLongListInput(std::endian endianness, uint32_t list_size) {
+  std::string result =
+      std::string("ply\nformat ") +
+      (endianness == std::endian::big ? "binary_big_endian"
+                                      : "binary_little_endian") +
+      " 1.0\nelement vertex 3\nproperty uint a\n"
+      "property list uint ushort b\nend_header\n";
+
+  auto append = [&](auto value) {
+    if (endianness != std::endian::native) {
+      value = std::byteswap(value);
+    }
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  for (uint32_t i = 0; i < 3u; i++) {
+    append(i);
+    append(list_size + i);
+    for (uint32_t j = 0; j < list_size + i; j++) {
+      append(static_cast<uint16_t>(i * 7u + j));
+    }
+  }
+
+  return result;
+}
+
+TEST(BigEndian, LongLists) {
+  std::string input = MakeLongListInput(std::endian::big, 100000u);
+
+  std::stringstream stream(input, std::ios::in | std::ios::binary);
+  ValueCollectingPlyReader stream_reader;
+  EXPECT_EQ(0, stream_reader.ReadFrom(stream).value());
+
+  ValueCollectingPlyReader span_reader;
+  EXPECT_EQ(0, span_reader.ReadFrom(AsBytes(input)).value());
+
+  for (const auto& reader : {&stream_reader, &span_reader}) {
+    EXPECT_EQ(std::vector<uint32_t>({0u, 1u, 2u}), reader->values);
+    ASSERT_EQ(3u, reader->lists.size());
+    for (uint32_t i = 0; i < 3u; i++) {
+      ASSERT_EQ(100000u + i, reader->lists[i].size());
+      for (uint32_t j = 0; j < 100000u + i; j++) {
+        ASSERT_EQ(static_cast<uint16_t>(i * 7u + j), reader->lists[i][j]);
+      }
+    }
+  }
+}
+
+TEST(LittleEndian, LongListsTruncated) {
+  std::string input = MakeLongListInput(std::endian::little, 100000u);
+  for (size_t removed : {1u, 2u, 3u, 150000u, 300000u}) {
+    std::string truncated = input.substr(0u, input.size() - removed);
+
+    std::stringstream stream(truncated, std::ios::in | std::ios::binary);
+    ValueCollectingPlyReader stream_reader;
+    std::error_code error = stream_reader.ReadFrom(stream);
+    EXPECT_THAT(error.message(),
+                StartsWith("The input ended earlier than expected (reached "
+                           "EOF but expected to find an entry of a property "
+                           "list with data type 'ushort'"));
+
+    ValueCollectingPlyReader span_reader;
+    EXPECT_EQ(error, span_reader.ReadFrom(AsBytes(truncated)));
+    EXPECT_EQ(stream_reader.values, span_reader.values);
+    EXPECT_EQ(stream_reader.lists, span_reader.lists);
+  }
+}
+
+std::string MakeLargeASCIIInput(uint32_t num_instances) {
+  std::string result =
+      "ply\nformat ascii 1.0\nelement vertex " +
+      std::to_string(num_instances) +
+      "\nproperty uint a\nproperty list uchar ushort b\nend_header\n";
+
+  for (uint32_t i = 0; i < num_instances; i++) {
+    std::string separator =
+        (i % 3u == 0u) ? "\t" : std::string(i % 5u + 1u, ' ');
+    result += std::to_string(i) + separator + std::to_string(i % 7u);
+    for (uint32_t j = 0; j < i % 7u; j++) {
+      result += separator + std::to_string(static_cast<uint16_t>(i + j));
+    }
+    result += (i % 11u == 0u) ? std::string(100u, ' ') + "\n" : "\n";
+  }
+
+  return result;
+}
+
+TEST(ASCII, SkipsUnrequestedTokens) {
+  std::string header =
+      "ply\nformat ascii 1.0\nelement vertex 2\nproperty uint a\n"
+      "property list uchar ushort b\nend_header\n";
+
+  std::string unparsable = header + "1 2 x 99999\n2 0\n";
+
+  ValueCollectingPlyReader parsing_reader;
+  EXPECT_THAT(parsing_reader.ReadFrom(AsBytes(unparsable)).message(),
+              StartsWith("The input contained a property list with data type "
+                         "'ushort' that had an entry could not be parsed"));
+
+  for (size_t num_threads : {1u, 2u}) {
+    ValueCollectingPlyReader reader;
+    reader.num_threads = num_threads;
+    reader.skip_lists = true;
+    EXPECT_EQ(0, reader.ReadFrom(AsBytes(unparsable)).value());
+    EXPECT_EQ(std::vector<uint32_t>({1u, 2u}), reader.values);
+  }
+
+  // The number of tokens on each line is still checked
+  std::string missing_token = header + "1 3 4 5\n2 0\n";
+
+  ValueCollectingPlyReader missing_token_reader;
+  missing_token_reader.skip_lists = true;
+  EXPECT_THAT(
+      missing_token_reader.ReadFrom(AsBytes(missing_token)).message(),
+      StartsWith("The input contained a line in its data section with fewer "
+                 "tokens than expected (reached end of line but expected to "
+                 "find an entry of a property list with data type "
+                 "'ushort')"));
+
+  std::string unused_token = header + "1 1 4 5\n2 0\n";
+
+  ValueCollectingPlyReader unused_token_reader;
+  unused_token_reader.skip_lists = true;
+  EXPECT_EQ(
+      "The input contained a token in its data section that was not "
+      "associated with any property",
+      unused_token_reader.ReadFrom(AsBytes(unused_token)).message());
+}
+
+TEST(ASCII, LargeInput) {
+  std::stringstream stream(MakeLargeASCIIInput(100000u),
+                           std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ExpectLargeInput(reader, 100000u);
+  EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+}
+
+TEST(ASCII, LargeInputSpan) {
+  std::string input = MakeLargeASCIIInput(100000u);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  ExpectLargeInput(reader, 100000u);
+}
+
+TEST(ASCII, LargeInputTruncated) {
+  std::string input = MakeLargeASCIIInput(100000u);
+  input.resize(input.rfind('\n', input.size() - 2u) + 1u);
+
+  std::stringstream stream(input, std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader stream_reader;
+  EXPECT_THAT(stream_reader.ReadFrom(stream).message(),
+              StartsWith("The input ended earlier than expected"));
+
+  ValueCollectingPlyReader span_reader;
+  EXPECT_THAT(span_reader.ReadFrom(AsBytes(input)).message(),
+              StartsWith("The input ended earlier than expected"));
+}
+
+TEST(ASCII, LargeInputThreaded) {
+  std::stringstream stream(MakeLargeASCIIInput(100000u),
+                           std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  reader.num_threads = 4u;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ExpectLargeInput(reader, 100000u);
+  EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+}
+
+TEST(ASCII, LargeInputThreadedSpan) {
+  std::string input = MakeLargeASCIIInput(100000u);
+
+  ValueCollectingPlyReader reader;
+  reader.num_threads = 4u;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  ExpectLargeInput(reader, 100000u);
+}
+
+TEST(ASCII, LargeInputThreadedMatchesErrors) {
+  std::string input = MakeLargeASCIIInput(100000u);
+  size_t data_start = input.find("end_header\n") + 11u;
+
+  std::vector<std::string> inputs;
+  for (size_t position : {data_start, input.size() / 2u, input.size() - 2u}) {
+    for (char c : {'x', '\r', '-', ' ', '\n', '\0'}) {
+      inputs.push_back(input);
+      inputs.back()[position] = c;
+    }
+  }
+
+  inputs.push_back(input.substr(0u, input.size() / 2u));
+  inputs.push_back(input + "1\n");
+  inputs.push_back(input.substr(0u, input.size() - 1u) + " 1");
+
+  for (const auto& corrupted : inputs) {
+    ValueCollectingPlyReader expected;
+    std::error_code expected_error = expected.ReadFrom(AsBytes(corrupted));
+
+    ValueCollectingPlyReader actual;
+    actual.num_threads = 3u;
+    std::error_code actual_error = actual.ReadFrom(AsBytes(corrupted));
+
+    EXPECT_EQ(expected_error, actual_error);
+    EXPECT_EQ(expected.values, actual.values);
+    EXPECT_EQ(expected.lists, actual.lists);
+  }
+
+  for (size_t fail_at_value : {0u, 12345u, 99999u}) {
+    ValueCollectingPlyReader expected;
+    expected.fail_at_value = fail_at_value;
+    std::error_code expected_error = expected.ReadFrom(AsBytes(input));
+
+    ValueCollectingPlyReader actual;
+    actual.num_threads = 3u;
+    actual.fail_at_value = fail_at_value;
+    std::error_code actual_error = actual.ReadFrom(AsBytes(input));
+
+    EXPECT_EQ(std::errc::invalid_argument, expected_error);
+    EXPECT_EQ(expected_error, actual_error);
+    EXPECT_EQ(expected.values, actual.values);
+    EXPECT_EQ(expected.lists, actual.lists);
+  }
+}
+
+TEST(ASCII, StopsAtEndOfDataThreaded) {
+  std::string contents = MakeLargeASCIIInput(1000u) + "trailing";
+
+  std::stringstream stream(contents, std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  reader.num_threads = 4u;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ExpectLargeInput(reader, 1000u);
+
+  std::string remaining;
+  char c;
+  while (stream.get(c)) {
+    remaining += c;
+  }
+
+  EXPECT_EQ("trailing", remaining);
+}
+
+TEST(ASCII, StopsAtEndOfData) {
+  std::string contents = MakeLargeASCIIInput(1000u) + "trailing";
+
+  std::stringstream stream(contents, std::ios::in | std::ios::binary);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+  ExpectLargeInput(reader, 1000u);
+
+  std::string remaining;
+  char c;
+  while (stream.get(c)) {
+    remaining += c;
+  }
+
+  EXPECT_EQ("trailing", remaining);
+}
+
+// Returns the input in buffers of `buffer_size` bytes and fails with `error`
+// once `fail_at` bytes have been returned.
+class ChunkedByteSource final : public ByteSource {
+ public:
+  ChunkedByteSource(const std::string& input, size_t buffer_size,
+                    size_t fail_at = std::numeric_limits<size_t>::max(),
+                    std::error_code error = std::error_code())
+      : input_(AsBytes(input)),
+        buffer_size_(buffer_size),
+        fail_at_(fail_at),
+        error_(error) {}
+
+  std::expected<std::span<const std::byte>, std::error_code> Next() override {
+    if (position_ >= fail_at_) {
+      return std::unexpected(error_);
+    }
+
+    size_t size = std::min({buffer_size_, input_.size() - position_,
+                            fail_at_ - position_});
+    std::span<const std::byte> result = input_.subspan(position_, size);
+    position_ += size;
+
+    return result;
+  }
+
+  void BackUp(size_t count) override { position_ -= count; }
+
+  std::string Remaining() const {
+    std::span<const std::byte> remaining = input_.subspan(position_);
+    return std::string(reinterpret_cast<const char*>(remaining.data()),
+                       remaining.size());
+  }
+
+ private:
+  std::span<const std::byte> input_;
+  size_t buffer_size_;
+  size_t fail_at_;
+  std::error_code error_;
+  size_t position_ = 0u;
+};
+
+TEST(ByteSource, LargeInput) {
+  for (const std::string& input :
+       {MakeLargeInput(std::endian::little, 10000u),
+        MakeLargeInput(std::endian::big, 10000u),
+        MakeLargeASCIIInput(10000u)}) {
+    std::string contents = input + "trailing";
+
+    for (size_t buffer_size : {1u, 7u, 4096u, 1000000u}) {
+      for (bool skip_lists : {false, true}) {
+        ChunkedByteSource source(contents, buffer_size);
+
+        ValueCollectingPlyReader reader;
+        reader.skip_lists = skip_lists;
+        EXPECT_EQ(0, reader.ReadFrom(source).value());
+        if (skip_lists) {
+          EXPECT_EQ(10000u, reader.values.size());
+        } else {
+          ExpectLargeInput(reader, 10000u);
+        }
+
+        EXPECT_EQ("trailing", source.Remaining());
+      }
+    }
+  }
+}
+
+TEST(ByteSource, LargeInputTruncated) {
+  for (const std::string& input :
+       {MakeLargeInput(std::endian::little, 1000u),
+        MakeLargeInput(std::endian::big, 1000u),
+        MakeLargeASCIIInput(1000u)}) {
+    for (size_t removed : {1u, 2u, 17u, 1000u}) {
+      std::string truncated = input.substr(0u, input.size() - removed);
+
+      ValueCollectingPlyReader expected;
+      std::error_code expected_error = expected.ReadFrom(AsBytes(truncated));
+
+      for (size_t buffer_size : {1u, 13u, 4096u}) {
+        ChunkedByteSource source(truncated, buffer_size);
+
+        ValueCollectingPlyReader actual;
+        EXPECT_EQ(expected_error, actual.ReadFrom(source));
+        EXPECT_EQ(expected.values, actual.values);
+        EXPECT_EQ(expected.lists, actual.lists);
+      }
+    }
+  }
+}
+
+TEST(ByteSource, ReturnsSourceError) {
+  std::error_code error = std::make_error_code(std::errc::io_error);
+
+  for (const std::string& input :
+       {MakeLargeInput(std::endian::little, 1000u),
+        MakeLargeASCIIInput(1000u)}) {
+    for (size_t fail_at : {0u, 10u, 200u, 5000u}) {
+      ChunkedByteSource source(input, 64u, fail_at, error);
+
+      ValueCollectingPlyReader reader;
+      EXPECT_EQ(error, reader.ReadFrom(source));
+    }
+  }
+}
+
+TEST(Index, LargeInput) {
+  for (const std::string& input :
+       {MakeLargeInput(std::endian::little, 100000u),
+        MakeLargeInput(std::endian::big, 100000u),
+        MakeLargeASCIIInput(100000u)}) {
+    auto index = BuildPlyIndex(AsBytes(input), 1000u);
+    ASSERT_TRUE(index);
+
+    for (size_t num_threads : {1u, 4u}) {
+      ValueCollectingPlyReader reader;
+      reader.num_threads = num_threads;
+      EXPECT_EQ(0, reader.ReadFrom(AsBytes(input), *index).value());
+      ExpectLargeInput(reader, 100000u);
+    }
+  }
+}
+
+TEST(Index, LargeInputMatchesErrors) {
+  std::string input = MakeLargeASCIIInput(100000u);
+  size_t data_start = input.find("end_header\n") + 11u;
+
+  auto index = BuildPlyIndex(AsBytes(input), 1000u);
+  ASSERT_TRUE(index);
+
+  // Only corruptions that preserve the lines of the input are indexed the same
+  std::vector<std::string> inputs;
+  for (size_t position : {data_start, input.size() / 2u, input.size() - 2u}) {
+    for (char c : {'x', '-', ' ', '\0'}) {
+      inputs.push_back(input);
+      inputs.back()[position] = c;
+    }
+  }
+
+  for (const auto& corrupted : inputs) {
+    ValueCollectingPlyReader expected;
+    std::error_code expected_error = expected.ReadFrom(AsBytes(corrupted));
+
+    ValueCollectingPlyReader actual;
+    actual.num_threads = 3u;
+    std::error_code actual_error = actual.ReadFrom(AsBytes(corrupted), *index);
+
+    EXPECT_EQ(expected_error, actual_error);
+    EXPECT_EQ(expected.values, actual.values);
+    EXPECT_EQ(expected.lists, actual.lists);
+  }
+
+  std::string binary = MakeLargeInput(std::endian::little, 100000u);
+  auto binary_index = BuildPlyIndex(AsBytes(binary), 1000u);
+  ASSERT_TRUE(binary_index);
+
+  for (size_t fail_at_value : {0u, 12345u, 99999u}) {
+    ValueCollectingPlyReader expected;
+    expected.fail_at_value = fail_at_value;
+    std::error_code expected_error = expected.ReadFrom(AsBytes(binary));
+
+    ValueCollectingPlyReader actual;
+    actual.num_threads = 3u;
+    actual.fail_at_value = fail_at_value;
+    std::error_code actual_error =
+        actual.ReadFrom(AsBytes(binary), *binary_index);
+
+    EXPECT_EQ(std::errc::invalid_argument, expected_error);
+    EXPECT_EQ(expected_error, actual_error);
+    EXPECT_EQ(expected.values, actual.values);
+    EXPECT_EQ(expected.lists, actual.lists);
+  }
+}
+
+std::string MakeSkippableInput() {
+  return "ply\nformat ascii 1.0\nelement face 2\n"
+         "property list uchar int vertex_indices\nelement vertex 2\n"
+         "property uint a\nproperty list uchar ushort b\nend_header\n"
+         "3 1 2\n1\n1 0\n2 2 3 4\n";
+}
+
+TEST(Index, SkipsElements) {
+  std::string input = MakeSkippableInput();
+
+  auto index = BuildPlyIndex(AsBytes(input), 1u);
+  ASSERT_TRUE(index);
+
+  ValueCollectingPlyReader sequential;
+  EXPECT_NE(0, sequential.ReadFrom(AsBytes(input)).value());
+
+  for (size_t num_threads : {1u, 2u}) {
+    ValueCollectingPlyReader reader;
+    reader.num_threads = num_threads;
+    EXPECT_EQ(0, reader.ReadFrom(AsBytes(input), *index).value());
+    EXPECT_EQ(std::vector<uint32_t>({1u, 2u}), reader.values);
+    EXPECT_EQ(std::vector<std::vector<uint16_t>>({{}, {3u, 4u}}),
+              reader.lists);
+  }
+}
+
+TEST(Index, Mismatched) {
+  std::string input = MakeLargeASCIIInput(10u);
+
+  auto other_index = BuildPlyIndex(AsBytes(MakeLargeASCIIInput(11u)), 2u);
+  ASSERT_TRUE(other_index);
+
+  ValueCollectingPlyReader other_reader;
+  EXPECT_EQ("The index does not describe the input",
+            other_reader.ReadFrom(AsBytes(input), *other_index).message());
+  EXPECT_TRUE(other_reader.values.empty());
+
+  // Moves the first checkpoint forward by one line, which cannot be detected
+  // without parsing the input
+  auto index = BuildPlyIndex(AsBytes(input), 2u);
+  ASSERT_TRUE(index);
+  uintmax_t& checkpoint = index->elements[0].checkpoints[0];
+  checkpoint = input.find('\n', checkpoint) + 1u;
+
+  ValueCollectingPlyReader reader;
+  reader.num_threads = 2u;
+  EXPECT_EQ(
+      "The data section of the input did not match the offsets recorded in "
+      "its index",
+      reader.ReadFrom(AsBytes(input), *index).message());
+  EXPECT_EQ(std::vector<uint32_t>({0u, 1u}), reader.values);
+
+  // Moves the start of the second element forward by two characters
+  std::string two_elements =
+      "ply\nformat ascii 1.0\nelement vertex 2\nproperty uint a\n"
+      "property list uchar ushort b\nelement face 2\n"
+      "property list uchar int vertex_indices\nend_header\n"
+      "1 0\n2 2 3 4\n3 x y z\n1 bad\n";
+  auto two_elements_index = BuildPlyIndex(AsBytes(two_elements), 10u);
+  ASSERT_TRUE(two_elements_index);
+  two_elements_index->elements[1].offset += 2u;
+
+  ValueCollectingPlyReader two_elements_reader;
+  EXPECT_EQ(
+      "The data section of the input did not match the offsets recorded in "
+      "its index",
+      two_elements_reader.ReadFrom(AsBytes(two_elements), *two_elements_index)
+          .message());
+  EXPECT_EQ(std::vector<uint32_t>({1u, 2u}), two_elements_reader.values);
+}
+
+TEST(Index, Path) {
+  auto index = BuildPlyIndex(
+      RunfilePath("_main/plyodine/test_data/ply_ascii_data.ply"));
+  ASSERT_TRUE(index);
+
+  ValueCollectingPlyReader reader;
+  EXPECT_EQ(std::errc::no_such_file_or_directory,
+            reader.ReadFrom(
+                RunfilePath("_main/plyodine/test_data/missing.ply"), *index));
+}
+
+class RecordCollectingPlyReader final : public PlyReader {
+ public:
+  std::vector<float> x;
+  std::vector<double> y;
+  std::vector<int32_t> z;
+
+ private:
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    callbacks["vertex"]["x"] = FloatPropertyCallback([this](float value) {
+      x.push_back(value);
+      return std::error_code();
+    });
+    callbacks["vertex"]["y"] = DoublePropertyCallback([this](double value) {
+      y.push_back(value);
+      return std::error_code();
+    });
+    callbacks["vertex"]["z"] = IntPropertyCallback([this](int32_t value) {
+      z.push_back(value);
+      return std::error_code();
+    });
+    return std::error_code();
+  }
+};
+
+std::string MakeRecordInput(std::endian endianness, uint32_t num_instances) {
+  std::string result =
+      std::string("ply\nformat ") +
+      (endianness == std::endian::big ? "binary_big_endian"
+                                      : "binary_little_endian") +
+      " 1.0\nelement vertex " + std::to_string(num_instances) +
+      "\nproperty float x\nproperty uchar unused\nproperty double y\n"
+      "property short z\nend_header\n";
+
+  auto append = [&](auto value) {
+    if (endianness != std::endian::native) {
+      value = std::byteswap(value);
+    }
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  for (uint32_t i = 0; i < num_instances; i++) {
+    append(std::bit_cast<uint32_t>(static_cast<float>(i) + 0.5f));
+    append(static_cast<uint8_t>(i));
+    append(std::bit_cast<uint64_t>(static_cast<double>(i) * 2.0));
+    append(static_cast<int16_t>(-static_cast<int32_t>(i % 1000u)));
+  }
+
+  return result;
+}
+
+void ExpectRecordInput(const RecordCollectingPlyReader& reader,
+                       uint32_t num_instances) {
+  ASSERT_EQ(num_instances, reader.x.size());
+  ASSERT_EQ(num_instances, reader.y.size());
+  ASSERT_EQ(num_instances, reader.z.size());
+  for (uint32_t i = 0; i < num_instances; i++) {
+    EXPECT_EQ(static_cast<float>(i) + 0.5f, reader.x[i]);
+    EXPECT_EQ(static_cast<double>(i) * 2.0, reader.y[i]);
+    EXPECT_EQ(-static_cast<int32_t>(i % 1000u), reader.z[i]);
+  }
+}
+
+TEST(LittleEndian, FixedSizeElement) {
+  std::string input = MakeRecordInput(std::endian::little, 100000u);
+
+  RecordCollectingPlyReader stream_reader;
+  std::stringstream stream(input, std::ios::in | std::ios::binary);
+  EXPECT_EQ(0, stream_reader.ReadFrom(stream).value());
+  ExpectRecordInput(stream_reader, 100000u);
+  EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+
+  RecordCollectingPlyReader span_reader;
+  EXPECT_EQ(0, span_reader.ReadFrom(AsBytes(input)).value());
+  ExpectRecordInput(span_reader, 100000u);
+}
+
+TEST(BigEndian, FixedSizeElement) {
+  std::string input = MakeRecordInput(std::endian::big, 100000u);
+
+  RecordCollectingPlyReader stream_reader;
+  std::stringstream stream(input, std::ios::in | std::ios::binary);
+  EXPECT_EQ(0, stream_reader.ReadFrom(stream).value());
+  ExpectRecordInput(stream_reader, 100000u);
+  EXPECT_EQ(std::char_traits<char>::eof(), stream.peek());
+
+  RecordCollectingPlyReader span_reader;
+  EXPECT_EQ(0, span_reader.ReadFrom(AsBytes(input)).value());
+  ExpectRecordInput(span_reader, 100000u);
+}
+
+TEST(LittleEndian, FixedSizeElementTruncated) {
+  static const std::string types[15] = {
+      "float", "float", "float", "float", "uchar", "double", "double", "double",
+      "double", "double", "double", "double", "double", "short", "short"};
+
+  std::string input = MakeRecordInput(std::endian::little, 100000u);
+  for (size_t i = 1; i <= 15; i++) {
+    std::string truncated = input.substr(0u, input.size() - i);
+
+    RecordCollectingPlyReader stream_reader;
+    std::stringstream stream(truncated, std::ios::in | std::ios::binary);
+    std::error_code error = stream_reader.ReadFrom(stream);
+    EXPECT_EQ(
+        "The input ended earlier than expected (reached EOF but expected to "
+        "find the value of a property with type '" +
+            types[15 - i] + "')",
+        error.message());
+    EXPECT_EQ(99999u, stream_reader.z.size());
+
+    RecordCollectingPlyReader span_reader;
+    EXPECT_EQ(error, span_reader.ReadFrom(AsBytes(truncated)));
+  }
+}
+
+class BatchCollectingPlyReader final : public PlyReader {
+ public:
+  BatchCollectingPlyReader(size_t batch_size) : batch_size_(batch_size) {}
+
+  std::vector<std::pair<uintmax_t, size_t>> batches;
+  std::vector<float> x;
+  std::vector<double> y;
+  std::vector<int32_t> z;
+
+ private:
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    callbacks["vertex"]["x"] = FloatPropertyBatchCallback(
+        [this](uintmax_t first_instance, std::span<const float> values) {
+          batches.emplace_back(first_instance, values.size());
+          x.insert(x.end(), values.begin(), values.end());
+          return std::error_code();
+        });
+    callbacks["vertex"]["y"] = DoublePropertyBatchCallback(
+        [this](uintmax_t first_instance, std::span<const double> values) {
+          y.insert(y.end(), values.begin(), values.end());
+          return std::error_code();
+        });
+    callbacks["vertex"]["z"] = IntPropertyBatchCallback(
+        [this](uintmax_t first_instance, std::span<const int32_t> values) {
+          z.insert(z.end(), values.begin(), values.end());
+          return std::error_code();
+        });
+
+    if (callbacks.contains("vertex") && callbacks["vertex"].contains("b")) {
+      callbacks["vertex"]["b"] = UShortPropertyBatchCallback(
+          [](uintmax_t first_instance, std::span<const uint16_t> values) {
+            return std::error_code();
+          });
+    }
+
+    return std::error_code();
+  }
+
+  size_t GetBatchSize() const override { return batch_size_; }
+
+  size_t batch_size_;
+};
+
+TEST(LittleEndian, BatchCallbacks) {
+  std::string input = MakeRecordInput(std::endian::little, 1000u);
+
+  BatchCollectingPlyReader reader(64u);
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+
+  ASSERT_EQ(16u, reader.batches.size());
+  for (size_t i = 0; i < 15u; i++) {
+    EXPECT_EQ(64u * i, reader.batches[i].first);
+    EXPECT_EQ(64u, reader.batches[i].second);
+  }
+  EXPECT_EQ(960u, reader.batches[15].first);
+  EXPECT_EQ(40u, reader.batches[15].second);
+
+  ASSERT_EQ(1000u, reader.x.size());
+  ASSERT_EQ(1000u, reader.y.size());
+  ASSERT_EQ(1000u, reader.z.size());
+  for (uint32_t i = 0; i < 1000u; i++) {
+    EXPECT_EQ(static_cast<float>(i) + 0.5f, reader.x[i]);
+    EXPECT_EQ(static_cast<double>(i) * 2.0, reader.y[i]);
+    EXPECT_EQ(-static_cast<int32_t>(i % 1000u), reader.z[i]);
+  }
+}
+
+TEST(BigEndian, BatchCallbacksZeroSize) {
+  std::string input = MakeRecordInput(std::endian::big, 3u);
+
+  BatchCollectingPlyReader reader(0u);
+  std::stringstream stream(input, std::ios::in | std::ios::binary);
+  EXPECT_EQ(0, reader.ReadFrom(stream).value());
+
+  std::vector<std::pair<uintmax_t, size_t>> expected = {
+      {0u, 1u}, {1u, 1u}, {2u, 1u}};
+  EXPECT_EQ(expected, reader.batches);
+  EXPECT_EQ(std::vector<float>({0.5f, 1.5f, 2.5f}), reader.x);
+}
+
+TEST(Error, BatchCallbackForList) {
+  std::string input = MakeLargeInput(std::endian::little, 10u);
+
+  BatchCollectingPlyReader reader(64u);
+  EXPECT_EQ(
+      "A callback requested an unsupported conversion from 'ushort' property "
+      "list to 'ushort' property",
+      reader.ReadFrom(AsBytes(input)).message());
+}
+
+class ParallelBatchPlyReader final : public PlyReader {
+ public:
+  ParallelBatchPlyReader(size_t num_threads, size_t batch_size)
+      : num_threads_(num_threads), batch_size_(batch_size) {}
+
+  std::vector<std::tuple<std::string, uintmax_t, size_t>> batches;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<int32_t> z;
+  size_t fail_at_batch = std::numeric_limits<size_t>::max();
+
+ private:
+  template <typename T>
+  auto Collect(std::string name, std::vector<T>& values) {
+    return [this, name, &values](uintmax_t first_instance,
+                                 std::span<const T> batch) {
+      if (batches.size() == fail_at_batch) {
+        return std::make_error_code(std::errc::invalid_argument);
+      }
+      batches.emplace_back(name, first_instance, batch.size());
+      values.insert(values.end(), batch.begin(), batch.end());
+      return std::error_code();
+    };
+  }
+
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    callbacks["vertex"]["x"] = FloatPropertyBatchCallback(Collect("x", x));
+    callbacks["vertex"]["y"] = FloatPropertyBatchCallback(Collect("y", y));
+    callbacks["vertex"]["z"] = IntPropertyBatchCallback(Collect("z", z));
+    return std::error_code();
+  }
+
+  std::error_code OnConversionFailure(const std::string& element,
+                                      const std::string& property,
+                                      ConversionFailureReason reason) override {
+    return std::make_error_code(std::errc::result_out_of_range);
+  }
+
+  size_t GetBatchSize() const override { return batch_size_; }
+  size_t GetNumThreads() const override { return num_threads_; }
+
+  size_t num_threads_;
+  size_t batch_size_;
+};
+
+void ExpectParallelMatchesSequential(const std::string& input,
+                                     size_t batch_size,
+                                     size_t fail_at_batch) {
+  ParallelBatchPlyReader expected(1u, batch_size);
+  expected.fail_at_batch = fail_at_batch;
+  std::error_code expected_error = expected.ReadFrom(AsBytes(input));
+
+  ParallelBatchPlyReader actual(4u, batch_size);
+  actual.fail_at_batch = fail_at_batch;
+  std::error_code actual_error = actual.ReadFrom(AsBytes(input));
+
+  EXPECT_EQ(expected_error, actual_error);
+  EXPECT_EQ(expected.batches, actual.batches);
+  EXPECT_EQ(expected.x, actual.x);
+  EXPECT_EQ(expected.y, actual.y);
+  EXPECT_EQ(expected.z, actual.z);
+}
+
+TEST(LittleEndian, ParallelBatchCallbacks) {
+  std::string input = MakeRecordInput(std::endian::little, 300000u);
+
+  ParallelBatchPlyReader reader(4u, 1000u);
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+
+  ASSERT_EQ(900u, reader.batches.size());
+  for (size_t i = 0; i < 900u; i++) {
+    EXPECT_EQ(std::string(1u, "xyz"[i % 3u]), std::get<0>(reader.batches[i]));
+    EXPECT_EQ(1000u * (i / 3u), std::get<1>(reader.batches[i]));
+    EXPECT_EQ(1000u, std::get<2>(reader.batches[i]));
+  }
+
+  ASSERT_EQ(300000u, reader.x.size());
+  ASSERT_EQ(300000u, reader.y.size());
+  ASSERT_EQ(300000u, reader.z.size());
+  for (uint32_t i = 0; i < 300000u; i++) {
+    EXPECT_EQ(static_cast<float>(i) + 0.5f, reader.x[i]);
+    EXPECT_EQ(static_cast<float>(i) * 2.0f, reader.y[i]);
+    EXPECT_EQ(-static_cast<int32_t>(i % 1000u), reader.z[i]);
+  }
+}
+
+TEST(BigEndian, ParallelBatchCallbacks) {
+  for (size_t batch_size : {0u, 1u, 7u, 65536u, 1000000u}) {
+    ExpectParallelMatchesSequential(
+        MakeRecordInput(std::endian::big, 200001u), batch_size,
+        std::numeric_limits<size_t>::max());
+  }
+}
+
+TEST(LittleEndian, ParallelBatchCallbacksErrors) {
+  std::string input = MakeRecordInput(std::endian::little, 200000u);
+  size_t data_start = input.find("end_header\n") + 11u;
+
+  for (size_t instance : {0u, 999u, 1000u, 150123u, 199999u}) {
+    std::string corrupted = input;
+    uint64_t value = std::bit_cast<uint64_t>(1e300);
+    if (std::endian::native != std::endian::little) {
+      value = std::byteswap(value);
+    }
+    std::memcpy(corrupted.data() + data_start + instance * 15u + 5u, &value,
+                sizeof(value));
+
+    ExpectParallelMatchesSequential(corrupted, 1000u,
+                                    std::numeric_limits<size_t>::max());
+  }
+
+  for (size_t fail_at_batch : {0u, 1u, 2u, 100u, 599u}) {
+    ExpectParallelMatchesSequential(input, 1000u, fail_at_batch);
+  }
+
+  std::string truncated = input.substr(0u, input.size() - 1u);
+  ExpectParallelMatchesSequential(truncated, 1000u,
+                                  std::numeric_limits<size_t>::max());
+}
+
+TEST(ReadFrom, Span) {
+  std::string files[] = {"_main/plyodine/test_data/ply_ascii_data.ply",
+                         "_main/plyodine/test_data/ply_big_data.ply",
+                         "_main/plyodine/test_data/ply_little_data.ply"};
+
+  for (const auto& file : files) {
+    std::ifstream input = OpenRunfile(file);
+
+    std::string contents;
+    char c;
+    while (input.get(c)) {
+      contents += c;
+    }
+
+    std::stringstream stream(contents, std::ios::in | std::ios::binary);
+    EXPECT_EQ(0, ReadAll(stream).value());
+    EXPECT_EQ(0, ReadAll(AsBytes(contents)).value());
+  }
+}
+
+TEST(ReadFrom, Path) {
+  std::string files[] = {"_main/plyodine/test_data/ply_ascii_data.ply",
+                         "_main/plyodine/test_data/ply_big_data.ply",
+                         "_main/plyodine/test_data/ply_little_data.ply",
+                         "_main/plyodine/test_data/ply_little_empty.ply"};
+
+  for (const auto& file : files) {
+    EXPECT_EQ(0, ReadAll(RunfilePath(file)).value());
+  }
+}
+
+TEST(ReadFrom, PathError) {
+  EXPECT_NE(0, ReadAll(RunfilePath(
+                       "_main/plyodine/test_data/header_format_bad.ply"))
+                   .value());
+  EXPECT_EQ(std::errc::no_such_file_or_directory,
+            ReadAll(RunfilePath("_main/plyodine/test_data/missing.ply")));
+}
+
+TEST(ReadFrom, PathErrorCategory) {
+  // Directories are opened but cannot be read as a file
+  std::error_code error = ReadAll(std::filesystem::path(testing::TempDir()));
+  EXPECT_NE(0, error.value());
+  EXPECT_EQ(std::generic_category(), error.category());
+}
+
+TEST(ReadFrom, ReusesReader) {
+  std::string inputs[] = {MakeLargeInput(std::endian::little, 100u),
+                          MakeLargeInput(std::endian::little, 50u),
+                          MakeLargeInput(std::endian::big, 30u),
+                          MakeLargeASCIIInput(20u),
+                          MakeLargeInput(std::endian::little, 10u)};
+
+  ValueCollectingPlyReader expected;
+  ValueCollectingPlyReader reused;
+  for (bool skip_lists : {false, true, false}) {
+    for (const std::string& input : inputs) {
+      ValueCollectingPlyReader fresh;
+      fresh.skip_lists = skip_lists;
+      ASSERT_EQ(0, fresh.ReadFrom(AsBytes(input)).value());
+      expected.values.insert(expected.values.end(), fresh.values.begin(),
+                             fresh.values.end());
+      expected.lists.insert(expected.lists.end(), fresh.lists.begin(),
+                            fresh.lists.end());
+
+      reused.skip_lists = skip_lists;
+      ASSERT_EQ(0, reused.ReadFrom(AsBytes(input)).value());
+    }
+  }
+
+  EXPECT_EQ(expected.values, reused.values);
+  EXPECT_EQ(expected.lists, reused.lists);
+}
+
+class TableEditingPlyReader final : public PlyReader {
+ public:
+  std::vector<uint32_t> values;
+  size_t mode = 0u;
+
+ private:
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    // Each read starts from a table containing only empty callbacks
+    EXPECT_EQ(1u, callbacks.size());
+    EXPECT_EQ(2u, callbacks["vertex"].size());
+    EXPECT_FALSE(std::get<UIntPropertyCallback>(callbacks["vertex"]["a"]));
+    EXPECT_FALSE(
+        std::get<UShortPropertyListCallback>(callbacks["vertex"]["b"]));
+
+    auto collect = [this](uint32_t value) {
+      values.push_back(value);
+      return std::error_code();
+    };
+
+    if (mode == 0u) {
+      callbacks["vertex"]["a"] = UIntPropertyCallback(collect);
+    } else if (mode == 1u) {
+      callbacks["vertex"].erase("a");
+      callbacks["vertex"]["c"] = UIntPropertyCallback(collect);
+      callbacks["face"]["a"] = UIntPropertyCallback(collect);
+    } else {
+      callbacks.erase("vertex");
+      callbacks["vertex"]["a"] = FloatPropertyCallback(
+          [](float value) { return std::error_code(); });
+    }
+
+    return std::error_code();
+  }
+};
+
+TEST(ReadFrom, ReusedReaderResetsCallbacks) {
+  std::string input = MakeLargeInput(std::endian::little, 100u);
+
+  TableEditingPlyReader reader;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  EXPECT_EQ(100u, reader.values.size());
+
+  reader.mode = 1u;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  EXPECT_EQ(100u, reader.values.size());
+
+  reader.mode = 2u;
+  EXPECT_THAT(reader.ReadFrom(AsBytes(input)).message(),
+              StartsWith("A callback requested an unsupported conversion"));
+  EXPECT_EQ(100u, reader.values.size());
+
+  reader.mode = 0u;
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+  EXPECT_EQ(200u, reader.values.size());
+}
+
+class CallbackHoldingPlyReader final : public PlyReader {
+ public:
+  std::shared_ptr<int> held = std::make_shared<int>(0);
+  bool batches = false;
+
+ private:
+  std::error_code Start(
+      std::map<std::string, uintmax_t> num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,
+      std::vector<std::string> comments,
+      std::vector<std::string> object_info) override {
+    if (batches) {
+      callbacks["vertex"]["a"] = UIntPropertyBatchCallback(
+          [held = held](uintmax_t, std::span<const uint32_t> values) {
+            *held += static_cast<int>(values.size());
+            return std::error_code();
+          });
+    } else {
+      callbacks["vertex"]["a"] = UIntPropertyCallback([held = held](uint32_t) {
+        *held += 1;
+        return std::error_code();
+      });
+    }
+
+    callbacks["vertex"]["missing"] = UIntPropertyCallback(
+        [held = held](uint32_t) { return std::error_code(); });
+
+    return std::error_code();
+  }
+
+  size_t GetNumThreads() const override { return batches ? 2u : 1u; }
+};
+
+TEST(ReadFrom, ReusedReaderReleasesCallbacks) {
+  std::string input = MakeLargeInput(std::endian::little, 100u);
+
+  CallbackHoldingPlyReader reader;
+  for (bool batches : {false, true, false}) {
+    reader.batches = batches;
+    EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+    EXPECT_EQ(1, reader.held.use_count());
+  }
+
+  EXPECT_EQ(300, *reader.held);
+}
+
 class MockConvertingPlyReader final : public PlyReader {
  public:
   MockConvertingPlyReader(PropertyType type) : type_(type) {}
@@ -2428,5 +3697,71 @@ TEST(Error, FloatOverflow) {
                          "that overflowed when converted to type 'float'"));
 }
 
+std::string MakeDoublesInput(bool is_list, size_t num_values,
+                             size_t bad_value, double bad) {
+  std::string input =
+      "ply\rformat binary_little_endian 1.0\relement vertex ";
+  input += is_list ? "1\rproperty list uint double a\r"
+                   : std::to_string(num_values) + "\rproperty double a\r";
+  input += "end_header\r";
+
+  if (is_list) {
+    uint32_t size = static_cast<uint32_t>(num_values);
+    if (std::endian::native != std::endian::little) {
+      size = std::byteswap(size);
+    }
+    input.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  }
+
+  for (size_t i = 0; i < num_values; i++) {
+    uint64_t value = std::bit_cast<uint64_t>(i == bad_value ? bad : 1.5);
+    if (std::endian::native != std::endian::little) {
+      value = std::byteswap(value);
+    }
+    input.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  return input;
+}
+
+TEST(Error, FloatOverflowInList) {
+  for (size_t bad_value : {0u, 63u, 64u, 150u, 199u}) {
+    std::string input = MakeDoublesInput(true, 200u, bad_value, 1e300);
+
+    MockConvertingPlyReader reader(PropertyType::FLOAT_LIST);
+    EXPECT_CALL(reader, OnConversionFailure("vertex", "a", 4))
+        .WillOnce(Return(std::error_code()));
+
+    EXPECT_THAT(reader.ReadFrom(AsBytes(input)).message(),
+                StartsWith("The input contained a property list with data "
+                           "type 'double' that overflowed when converted to "
+                           "type 'float'"));
+  }
+}
+
+TEST(Error, FloatUnderflowInBatch) {
+  for (size_t bad_value : {0u, 63u, 64u, 150u, 199u}) {
+    std::string input = MakeDoublesInput(false, 200u, bad_value, -1e300);
+
+    MockConvertingPlyReader reader(PropertyType::FLOAT);
+    EXPECT_CALL(reader, OnConversionFailure("vertex", "a", 3))
+        .WillOnce(Return(std::error_code()));
+
+    EXPECT_THAT(reader.ReadFrom(AsBytes(input)).message(),
+                StartsWith("The input contained a property with type 'double' "
+                           "that underflowed when converted to type 'float'"));
+  }
+}
+
+TEST(LittleEndian, ConvertsInfinitiesInBatch) {
+  std::string input = MakeDoublesInput(
+      false, 200u, 100u, std::numeric_limits<double>::infinity());
+
+  MockConvertingPlyReader reader(PropertyType::FLOAT);
+  EXPECT_CALL(reader, OnConversionFailure(_, _, _)).Times(0);
+
+  EXPECT_EQ(0, reader.ReadFrom(AsBytes(input)).value());
+}
+
 }  // namespace
 }  // namespace plyodine
@@ -1,26 +1,39 @@
 #include "plyodine/ply_writer.h"
 
+#include <algorithm>
 #include <bit>
 #include <cctype>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <generator>
-#include <iomanip>
 #include <ios>
 #include <limits>
 #include <map>
+#include <memory>
+#include <optional>
 #include <ostream>
+#include <ranges>
+#include <semaphore>
 #include <set>
 #include <span>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "plyodine/internal/byte_swap.h"
+#include "plyodine/internal/number_formatter.h"
+#include "plyodine/internal/parallel_file_writer.h"
+#include "plyodine/internal/thread_pool.h"
+
 namespace {
 
 enum class ErrorCode {
@@ -204,9 +217,191 @@ using GetPropertyRankFunc =
     std::move_only_function<size_t(const std::string&, const std::string&)>;
 using GetPropertyListSizeFunc =
     std::move_only_function<int(const std::string&, const std::string&)>;
-using WriteFunc =
-    std::move_only_function<std::error_code(std::ostream&, std::stringstream&)>;
-using WriteFuncMaker = std::move_only_function<WriteFunc()>;
+
+// Collects the serialized output in memory and passes it to a sink in large
+// blocks so that appending a value is a bounds check and a copy rather than a
+// call into the destination stream. Writes larger than a block bypass the
+// buffer. Once the sink fails, every subsequent write fails.
+//
+// A buffer without a sink instead grows to hold everything written to it,
+// which is read back using `data` and `size` and discarded by `Clear`.
+class OutputBuffer final {
+ public:
+  // Writes each of the bytes passed to it, returning false on failure.
+  using Sink = std::move_only_function<bool(const char*, size_t)>;
+
+  static constexpr size_t kBlockSize = 64u * 1024u;
+
+  OutputBuffer() = default;
+  explicit OutputBuffer(Sink sink) : sink_(std::move(sink)) {}
+
+  // Returns a pointer to space for at least `size` more bytes, flushing the
+  // buffer first if required. Returns nullptr if the flush failed. The bytes
+  // written to the space are added to the output by calling `Commit`.
+  char* Reserve(size_t size) {
+    if (storage_.size() - used_ < size && !MakeSpace(size)) {
+      return nullptr;
+    }
+
+    return storage_.data() + used_;
+  }
+
+  void Commit(size_t size) { used_ += size; }
+
+  bool Write(const char* data, size_t size) {
+    if (size == 0u) {
+      return true;
+    }
+
+    if (size > kBlockSize && sink_) {
+      return Flush() && Drain(data, size);
+    }
+
+    char* dest = Reserve(size);
+    if (dest == nullptr) {
+      return false;
+    }
+
+    std::memcpy(dest, data, size);
+    used_ += size;
+
+    return true;
+  }
+
+  bool Put(char c) {
+    char* dest = Reserve(1u);
+    if (dest == nullptr) {
+      return false;
+    }
+
+    *dest = c;
+    used_ += 1u;
+
+    return true;
+  }
+
+  // Passes the buffered bytes to the sink. Does nothing without a sink.
+  bool Flush() {
+    if (!sink_) {
+      return true;
+    }
+
+    bool result = Drain(storage_.data(), used_);
+    used_ = 0u;
+    return result;
+  }
+
+  const char* data() const { return storage_.data(); }
+  size_t size() const { return used_; }
+  void Clear() { used_ = 0u; }
+
+ private:
+  bool MakeSpace(size_t size) {
+    if (!sink_) {
+      storage_.resize(std::max(used_ + size, 2u * storage_.size()));
+      return true;
+    }
+
+    if (!Flush()) {
+      return false;
+    }
+
+    if (storage_.size() < size) {
+      storage_.resize(size);
+    }
+
+    return true;
+  }
+
+  bool Drain(const char* data, size_t size) {
+    if (failed_) {
+      return false;
+    }
+
+    if (size != 0u && !sink_(data, size)) {
+      failed_ = true;
+    }
+
+    return !failed_;
+  }
+
+  Sink sink_;
+  std::vector<char> storage_ = std::vector<char>(kBlockSize);
+  size_t used_ = 0u;
+  bool failed_ = false;
+};
+
+using WriteFunc = std::move_only_function<std::error_code(OutputBuffer&)>;
+
+// Returns the number of values of a property with a batch generator that can be
+// written without resuming the generator, resuming it if there are none.
+// Returns zero once the generator has ended.
+using AvailableFunc = std::move_only_function<size_t()>;
+
+// Copies up to the next `count` values of a non-list property to `dest` in
+// native byte order, placing consecutive values `stride` bytes apart. Returns
+// the number of values copied, which is less than `count` only if the
+// property's generator has ended.
+using WriteColumnFunc =
+    std::move_only_function<size_t(char* dest, size_t stride, size_t count)>;
+
+// Writes the next `count` values of a property with a batch generator to
+// `output` in native byte order directly from the batch. `count` must not
+// exceed the number returned by the `AvailableFunc`. Returns false if the
+// output could not be written.
+using WriteRunFunc =
+    std::move_only_function<bool(OutputBuffer& output, size_t count)>;
+
+// Copies `count` values starting at `first` of the values taken by a
+// `TakeColumnFunc` to `dest` in native byte order, placing consecutive values
+// `stride` bytes apart. May be called concurrently from multiple threads.
+using CopyColumnFunc = std::move_only_function<void(
+    char* dest, size_t stride, size_t first, size_t count) const>;
+
+// Takes the next `count` values of a property with a batch generator, which
+// must not exceed the number returned by the `AvailableFunc`, and returns a
+// function that copies them. The values remain valid until the
+// `AvailableFunc` is next called.
+using TakeColumnFunc = std::move_only_function<CopyColumnFunc(size_t count)>;
+
+// Formats the value at `index` of the values taken by a `TakeFunc` and appends
+// it to `output`. May be called concurrently from multiple threads.
+using FormatFunc =
+    std::move_only_function<std::error_code(OutputBuffer& output,
+                                            size_t index) const>;
+
+// Takes the next `count` values of a property with a batch generator, which
+// must not exceed the number returned by the `AvailableFunc`, and returns a
+// function that formats them. The values remain valid until the
+// `AvailableFunc` is next called.
+using TakeFunc = std::move_only_function<FormatFunc(size_t count)>;
+
+struct WriteFuncs {
+  WriteFunc write;
+
+  // Only set for non-list properties
+  WriteColumnFunc write_column;
+
+  // Only set for properties with a batch generator
+  AvailableFunc available;
+  WriteRunFunc write_run;
+  TakeFunc take;
+  TakeColumnFunc take_column;
+};
+
+using WriteFuncMaker = std::move_only_function<WriteFuncs()>;
+
+// The size in bytes of each data type in the binary formats, indexed by the
+// index of its non-list generator divided by two
+constexpr size_t kDataTypeSizes[8] = {1u, 1u, 2u, 2u, 4u, 4u, 4u, 8u};
+
+size_t ToNonBatchIndex(size_t generator_index) {
+  if (generator_index >= 16u) {
+    return 2u * (generator_index - 16u);
+  }
+
+  return generator_index;
+}
 
 std::error_code ValidateName(const std::string& name, ErrorCode empty_error,
                              ErrorCode invalid_chars_error) {
@@ -233,11 +428,22 @@ bool ValidateComment(const std::string& comment) {
   return true;
 }
 
+template <typename T>
+bool WriteDecimal(OutputBuffer& output, T value) {
+  char* dest = output.Reserve(internal::kMaxFormattedLength<T>);
+  if (dest == nullptr) {
+    return false;
+  }
+
+  output.Commit(
+      static_cast<size_t>(internal::FormatNumber(value, dest) - dest));
+
+  return true;
+}
+
 template <std::integral T>
-std::error_code SerializeASCII(std::ostream& stream, std::stringstream& storage,
-                               T value) {
-  stream << +value;
-  if (!stream) {
+std::error_code SerializeASCII(OutputBuffer& output, T value) {
+  if (!WriteDecimal(output, value)) {
     return std::io_errc::stream;
   }
 
@@ -245,30 +451,13 @@ std::error_code SerializeASCII(std::ostream& stream, std::stringstream& storage,
 }
 
 template <std::floating_point T>
-std::error_code SerializeASCII(std::ostream& stream, std::stringstream& storage,
-                               T value) {
+std::error_code SerializeASCII(OutputBuffer& output, T value) {
   if (!std::isfinite(value)) {
     return std::is_same_v<T, float> ? ErrorCode::ASCII_FLOAT_OUT_OF_RANGE
                                     : ErrorCode::ASCII_DOUBLE_OUT_OF_RANGE;
   }
 
-  storage.str("");
-
-  int log = static_cast<int>(std::log10(std::abs(value))) + 1;
-  int num_digits = std::max(std::numeric_limits<T>::max_digits10 - log, 0);
-  storage << std::fixed << std::setprecision(num_digits) << value;
-
-  std::string_view result = storage.view();
-
-  size_t dot = result.find(".");
-  if (dot != std::string_view::npos) {
-    result = result.substr(0u, result.find_last_not_of("0") + 1u);
-    if (result.back() == '.') {
-      result.remove_suffix(1u);
-    }
-  }
-
-  if (!stream.write(result.data(), result.size())) {
+  if (!WriteDecimal(output, value)) {
     return std::io_errc::stream;
   }
 
@@ -276,14 +465,12 @@ std::error_code SerializeASCII(std::ostream& stream, std::stringstream& storage,
 }
 
 template <std::endian Endianness, std::integral T>
-std::error_code SerializeBinary(std::ostream& stream,
-                                std::stringstream& storage, T value) {
+std::error_code SerializeBinary(OutputBuffer& output, T value) {
   if (Endianness != std::endian::native) {
     value = std::byteswap(value);
   }
 
-  stream.write(reinterpret_cast<char*>(&value), sizeof(value));
-  if (!stream) {
+  if (!output.Write(reinterpret_cast<char*>(&value), sizeof(value))) {
     return std::io_errc::stream;
   }
 
@@ -291,8 +478,7 @@ std::error_code SerializeBinary(std::ostream& stream,
 }
 
 template <std::endian Endianness, std::floating_point T>
-std::error_code SerializeBinary(std::ostream& stream,
-                                std::stringstream& storage, T value) {
+std::error_code SerializeBinary(OutputBuffer& output, T value) {
   auto entry = std::bit_cast<
       std::conditional_t<std::is_same_v<T, float>, uint32_t, uintmax_t>>(value);
 
@@ -300,8 +486,51 @@ std::error_code SerializeBinary(std::ostream& stream,
     entry = std::byteswap(entry);
   }
 
-  stream.write(reinterpret_cast<char*>(&entry), sizeof(entry));
-  if (!stream) {
+  if (!output.Write(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+    return std::io_errc::stream;
+  }
+
+  return std::error_code();
+}
+
+// Writes the entries of a property list in a single block, reversing their byte
+// order first if required. Lists that fit in the output buffer are reversed in
+// place there while larger lists are reversed in `buffer`.
+template <std::endian Endianness, typename T>
+std::error_code SerializeBinaryList(OutputBuffer& output,
+                                    std::vector<char>& buffer,
+                                    std::span<const T> values) {
+  // The data of an empty list may be null and must not be copied
+  if (values.empty()) {
+    return std::error_code();
+  }
+
+  const char* data = reinterpret_cast<const char*>(values.data());
+  if (Endianness == std::endian::native || sizeof(T) == 1u) {
+    if (!output.Write(data, values.size_bytes())) {
+      return std::io_errc::stream;
+    }
+
+    return std::error_code();
+  }
+
+  if (values.size_bytes() <= OutputBuffer::kBlockSize) {
+    char* dest = output.Reserve(values.size_bytes());
+    if (dest == nullptr) {
+      return std::io_errc::stream;
+    }
+
+    std::memcpy(dest, data, values.size_bytes());
+    plyodine::internal::ByteSwap(dest, sizeof(T), values.size());
+    output.Commit(values.size_bytes());
+
+    return std::error_code();
+  }
+
+  buffer.assign(data, data + values.size_bytes());
+  plyodine::internal::ByteSwap(buffer.data(), sizeof(T), values.size());
+
+  if (!output.Write(buffer.data(), buffer.size())) {
     return std::io_errc::stream;
   }
 
@@ -309,14 +538,13 @@ std::error_code SerializeBinary(std::ostream& stream,
 }
 
 template <Format format, typename T>
-std::error_code Serialize(std::ostream& stream, std::stringstream& storage,
-                          T value) {
+std::error_code Serialize(OutputBuffer& output, T value) {
   if constexpr (format == Format::ASCII) {
-    return SerializeASCII(stream, storage, value);
+    return SerializeASCII(output, value);
   } else if constexpr (format == Format::BINARY_BIG_ENDIAN) {
-    return SerializeBinary<std::endian::big>(stream, storage, value);
+    return SerializeBinary<std::endian::big>(output, value);
   } else {
-    return SerializeBinary<std::endian::little>(stream, storage, value);
+    return SerializeBinary<std::endian::little>(output, value);
   }
 }
 
@@ -367,9 +595,9 @@ WriteFunc MakeWriteFuncImpl(std::generator<T>& generator, int list_type) {
       ErrorCode::OVERFLOWED_UCHAR_LIST, ErrorCode::OVERFLOWED_USHORT_LIST,
       ErrorCode::OVERFLOWED_UINT_LIST};
 
-  return [iter = generator.begin(), end = generator.end(), list_type](
-             std::ostream& stream,
-             std::stringstream& token) mutable -> std::error_code {
+  return [iter = generator.begin(), end = generator.end(), list_type,
+          buffer = std::vector<char>()](
+             OutputBuffer& output) mutable -> std::error_code {
     if (iter == end) {
       return MissingDataError<T>();
     }
@@ -385,50 +613,61 @@ WriteFunc MakeWriteFuncImpl(std::generator<T>& generator, int list_type) {
       switch (list_type) {
         case 0:
           if (std::error_code error =
-                  Serialize<F>(stream, token, static_cast<uint8_t>(size));
+                  Serialize<F>(output, static_cast<uint8_t>(size));
               error) {
             return error;
           }
           break;
         case 1:
           if (std::error_code error =
-                  Serialize<F>(stream, token, static_cast<uint16_t>(size));
+                  Serialize<F>(output, static_cast<uint16_t>(size));
               error) {
             return error;
           }
           break;
         case 2:
           if (std::error_code error =
-                  Serialize<F>(stream, token, static_cast<uint32_t>(size));
+                  Serialize<F>(output, static_cast<uint32_t>(size));
               error) {
             return error;
           }
           break;
       }
 
-      for (size_t i = 0; i < value.size(); i++) {
-        if constexpr (F == Format::ASCII) {
-          if (!stream.put(' ')) {
+      if constexpr (F == Format::ASCII) {
+        for (size_t i = 0; i < value.size(); i++) {
+          if (!output.Put(' ')) {
             return std::io_errc::stream;
           }
-        }
 
-        if (std::error_code error = Serialize<F>(stream, token, value[i]);
-            error) {
-          if constexpr (std::is_same_v<T, std::span<const float>>) {
-            if (error == ErrorCode::ASCII_FLOAT_OUT_OF_RANGE) {
-              error = ErrorCode::ASCII_FLOAT_LIST_OUT_OF_RANGE;
-            }
-          } else if constexpr (std::is_same_v<T, std::span<const double>>) {
-            if (error == ErrorCode::ASCII_DOUBLE_OUT_OF_RANGE) {
-              error = ErrorCode::ASCII_DOUBLE_LIST_OUT_OF_RANGE;
+          if (std::error_code error = Serialize<F>(output, value[i]); error) {
+            if constexpr (std::is_same_v<T, std::span<const float>>) {
+              if (error == ErrorCode::ASCII_FLOAT_OUT_OF_RANGE) {
+                error = ErrorCode::ASCII_FLOAT_LIST_OUT_OF_RANGE;
+              }
+            } else if constexpr (std::is_same_v<T, std::span<const double>>) {
+              if (error == ErrorCode::ASCII_DOUBLE_OUT_OF_RANGE) {
+                error = ErrorCode::ASCII_DOUBLE_LIST_OUT_OF_RANGE;
+              }
             }
+            return error;
           }
+        }
+      } else if constexpr (F == Format::BINARY_BIG_ENDIAN) {
+        if (std::error_code error =
+                SerializeBinaryList<std::endian::big>(output, buffer, value);
+            error) {
+          return error;
+        }
+      } else {
+        if (std::error_code error = SerializeBinaryList<std::endian::little>(
+                output, buffer, value);
+            error) {
           return error;
         }
       }
     } else {
-      if (std::error_code error = Serialize<F>(stream, token, value); error) {
+      if (std::error_code error = Serialize<F>(output, value); error) {
         return error;
       }
     }
@@ -439,18 +678,140 @@ WriteFunc MakeWriteFuncImpl(std::generator<T>& generator, int list_type) {
   };
 }
 
-template <Format F, typename Variant>
-WriteFunc MakeWriteFunc(Variant& generator, int list_type) {
-  return std::visit(
-      [list_type](auto& gen) { return MakeWriteFuncImpl<F>(gen, list_type); },
-      generator);
+// The position of the next value to be written within the values yielded by
+// the generator of a non-list property. `Generator` yields either one value or
+// a batch of values at a time.
+template <typename T, typename Generator>
+class ValueCursor final {
+ public:
+  explicit ValueCursor(Generator& generator)
+      : iter_(generator.begin()), end_(generator.end()) {}
+
+  // Returns the number of values that can be taken without resuming the
+  // generator, resuming it if there are none. Returns zero once the generator
+  // has ended.
+  size_t Available() {
+    while (values_.empty()) {
+      if (iter_ == end_) {
+        return 0u;
+      }
+
+      if (loaded_) {
+        ++iter_;
+        loaded_ = false;
+      } else if constexpr (std::is_arithmetic_v<
+                               std::remove_cvref_t<decltype(*iter_)>>) {
+        // The value lives in the generator's frame until it is next resumed
+        const T& value = *iter_;
+        values_ = std::span<const T>(&value, 1u);
+        loaded_ = true;
+      } else {
+        values_ = (*iter_).values;
+        loaded_ = true;
+      }
+    }
+
+    return values_.size();
+  }
+
+  std::span<const T> Take(size_t count) {
+    std::span<const T> result = values_.first(count);
+    values_ = values_.subspan(count);
+    return result;
+  }
+
+ private:
+  std::ranges::iterator_t<Generator> iter_;
+  std::ranges::sentinel_t<Generator> end_;
+  std::span<const T> values_;
+  bool loaded_ = false;
+};
+
+template <Format F, typename T, typename Generator>
+WriteFuncs MakeValueWriteFuncs(Generator& generator, bool batched) {
+  auto cursor = std::make_shared<ValueCursor<T, Generator>>(generator);
+
+  WriteFuncs result;
+  result.write = [cursor](OutputBuffer& output) -> std::error_code {
+    if (cursor->Available() == 0u) {
+      return MissingDataError<T>();
+    }
+
+    return Serialize<F>(output, cursor->Take(1u).front());
+  };
+  result.write_column = [cursor](char* dest, size_t stride, size_t count) {
+    size_t written = 0u;
+    while (written < count) {
+      size_t available = cursor->Available();
+      if (available == 0u) {
+        break;
+      }
+
+      std::span<const T> values =
+          cursor->Take(std::min(available, count - written));
+      if (stride == sizeof(T)) {
+        std::memcpy(dest, values.data(), values.size_bytes());
+        dest += values.size_bytes();
+      } else {
+        for (const T& value : values) {
+          std::memcpy(dest, &value, sizeof(T));
+          dest += stride;
+        }
+      }
+
+      written += values.size();
+    }
+
+    return written;
+  };
+
+  if (batched) {
+    result.available = [cursor]() { return cursor->Available(); };
+    result.write_run = [cursor](OutputBuffer& output, size_t count) {
+      std::span<const T> values = cursor->Take(count);
+      return output.Write(reinterpret_cast<const char*>(values.data()),
+                          values.size_bytes());
+    };
+    result.take = [cursor](size_t count) -> FormatFunc {
+      return [values = cursor->Take(count)](OutputBuffer& output,
+                                            size_t index) {
+        return Serialize<F>(output, values[index]);
+      };
+    };
+    result.take_column = [cursor](size_t count) -> CopyColumnFunc {
+      return [values = cursor->Take(count)](char* dest, size_t stride,
+                                            size_t first, size_t count) {
+        for (const T& value : values.subspan(first, count)) {
+          std::memcpy(dest, &value, sizeof(T));
+          dest += stride;
+        }
+      };
+    };
+  }
+
+  return result;
+}
+
+template <Format F, typename T>
+WriteFuncs MakeWriteFuncs(std::generator<T>& generator, int list_type) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return MakeValueWriteFuncs<F, T>(generator, false);
+  } else {
+    return WriteFuncs{MakeWriteFuncImpl<F>(generator, list_type)};
+  }
+}
+
+template <Format F, typename T>
+WriteFuncs MakeWriteFuncs(std::generator<PropertyBatch<T>>& generator,
+                          int list_type) {
+  return MakeValueWriteFuncs<F, T>(generator, true);
 }
 
 template <Format F, typename Variant>
 WriteFuncMaker MakeWriteFuncMaker(Variant& generator, int list_type) {
   return [&generator, list_type]() {
     return std::visit(
-        [list_type](auto& gen) { return MakeWriteFuncImpl<F>(gen, list_type); },
+        [list_type](auto& gen) { return MakeWriteFuncs<F>(gen, list_type); },
         generator);
   };
 }
@@ -458,8 +819,8 @@ WriteFuncMaker MakeWriteFuncMaker(Variant& generator, int list_type) {
 struct Property {
   int list_type;
   size_t data_type_index;
-  WriteFuncMaker make_write_func;
-  WriteFunc write_func;
+  WriteFuncMaker make_write_funcs;
+  WriteFuncs write_funcs;
 };
 
 template <Format F, typename T>
@@ -504,13 +865,14 @@ BuildProperties(GetElementRankFunc get_element_rank,
     for (const std::string& property_name : ordered_properties) {
       auto& generator =
           generators.find(element_name)->second.find(property_name)->second;
+      size_t data_type_index = ToNonBatchIndex(generator.index());
       int list_type = 2;
-      if (generator.index() & 1u) {
+      if (data_type_index & 1u) {
         list_type = get_property_list_size(element_name, property_name);
       }
 
       result.back().second.emplace_back(
-          property_name, Property{list_type, generator.index(),
+          property_name, Property{list_type, data_type_index,
                                   MakeWriteFuncMaker<F>(generator, list_type)});
     }
   }
@@ -519,7 +881,7 @@ BuildProperties(GetElementRankFunc get_element_rank,
 }
 
 std::error_code WriteHeader(
-    std::ostream& stream, std::string_view format,
+    OutputBuffer& output, std::string_view format,
     std::map<std::string, uintmax_t>& num_element_instances,
     const std::vector<
         std::pair<std::string, std::vector<std::pair<std::string, Property>>>>&
@@ -539,9 +901,9 @@ std::error_code WriteHeader(
       "list uchar ", "list ushort ", "list uint "};
   static constexpr std::string_view header_suffix = "end_header\r";
 
-  if (!stream.write(header_prefix.data(), header_prefix.size()) ||
-      !stream.write(format.data(), format.size()) ||
-      !stream.write(version_suffix.data(), version_suffix.size())) {
+  if (!output.Write(header_prefix.data(), header_prefix.size()) ||
+      !output.Write(format.data(), format.size()) ||
+      !output.Write(version_suffix.data(), version_suffix.size())) {
     return std::io_errc::stream;
   }
 
@@ -550,8 +912,8 @@ std::error_code WriteHeader(
       return ErrorCode::INVALID_COMMENT;
     }
 
-    if (!stream.write(comment_prefix.data(), comment_prefix.size()) ||
-        !stream.write(comment.data(), comment.size()) || !stream.put('\r')) {
+    if (!output.Write(comment_prefix.data(), comment_prefix.size()) ||
+        !output.Write(comment.data(), comment.size()) || !output.Put('\r')) {
       return std::io_errc::stream;
     }
   }
@@ -561,8 +923,8 @@ std::error_code WriteHeader(
       return ErrorCode::INVALID_OBJ_INFO;
     }
 
-    if (!stream.write(obj_info_prefix.data(), obj_info_prefix.size()) ||
-        !stream.write(info.data(), info.size()) || !stream.put('\r')) {
+    if (!output.Write(obj_info_prefix.data(), obj_info_prefix.size()) ||
+        !output.Write(info.data(), info.size()) || !output.Put('\r')) {
       return std::io_errc::stream;
     }
   }
@@ -579,10 +941,12 @@ std::error_code WriteHeader(
       return error;
     }
 
-    uintmax_t num_instances = num_element_instances[element_name];
-    if (!stream.write(element_prefix.data(), element_prefix.size()) ||
-        !stream.write(element_name.data(), element_name.size()) ||
-        !stream.put(' ') || !(stream << num_instances) || !stream.put('\r')) {
+    uint64_t num_instances =
+        static_cast<uint64_t>(num_element_instances[element_name]);
+    if (!output.Write(element_prefix.data(), element_prefix.size()) ||
+        !output.Write(element_name.data(), element_name.size()) ||
+        !output.Put(' ') || !WriteDecimal(output, num_instances) ||
+        !output.Put('\r')) {
       return std::io_errc::stream;
     }
 
@@ -594,11 +958,11 @@ std::error_code WriteHeader(
         return error;
       }
 
-      if (!stream.write(property_prefix.data(), property_prefix.size())) {
+      if (!output.Write(property_prefix.data(), property_prefix.size())) {
         return std::io_errc::stream;
       }
       if ((property.data_type_index & 1u) &&
-          !stream.write(
+          !output.Write(
               list_type_prefixes[static_cast<size_t>(property.list_type)]
                   .data(),
               list_type_prefixes[static_cast<size_t>(property.list_type)]
@@ -608,63 +972,382 @@ std::error_code WriteHeader(
 
       const std::string_view& data_type_name =
           data_type_names[property.data_type_index >> 1u];
-      if (!stream.write(data_type_name.data(), data_type_name.size()) ||
-          !stream.write(property_name.data(), property_name.size()) ||
-          !stream.put('\r')) {
+      if (!output.Write(data_type_name.data(), data_type_name.size()) ||
+          !output.Write(property_name.data(), property_name.size()) ||
+          !output.Put('\r')) {
         return std::io_errc::stream;
       }
     }
   }
 
-  if (!stream.write(header_suffix.data(), header_suffix.size())) {
+  if (!output.Write(header_suffix.data(), header_suffix.size())) {
     return std::io_errc::stream;
   }
 
   return std::error_code();
 }
 
-std::error_code WriteFile(
-    std::ostream& stream, Format format,
+// Writes the instances of an element whose properties are all non-list
+// properties, which have a fixed record size in the binary formats. The
+// records are assembled a block at a time: each property fills in its column of
+// the block and the fields of the whole block are then byte swapped together
+// if required.
+std::error_code WriteRecords(
+    OutputBuffer& output, bool swap_bytes, uintmax_t count,
+    std::vector<std::pair<std::string, Property>>& properties,
+    std::span<const size_t> field_sizes) {
+  plyodine::internal::RecordByteSwapper swapper(field_sizes);
+  size_t record_size = swapper.record_size();
+  size_t max_rows =
+      std::max<size_t>(1u, OutputBuffer::kBlockSize / record_size);
+
+  // The values of a lone property with a batch generator that need no byte
+  // swapping are written straight from each batch, which avoids copying
+  // batches larger than a block through the output buffer
+  WriteFuncs& first_write_funcs = properties.front().second.write_funcs;
+  bool direct = properties.size() == 1u &&
+                static_cast<bool>(first_write_funcs.write_run) &&
+                (!swap_bytes || record_size == 1u);
+
+  for (uintmax_t i = 0; i < count;) {
+    if (direct) {
+      size_t rows = first_write_funcs.available();
+      if (rows > count - i) {
+        rows = static_cast<size_t>(count - i);
+      }
+
+      if (rows != 0u) {
+        if (!first_write_funcs.write_run(output, rows)) {
+          return std::io_errc::stream;
+        }
+
+        i += rows;
+        continue;
+      }
+    }
+
+    size_t rows = static_cast<size_t>(
+        std::min(count - i, static_cast<uintmax_t>(max_rows)));
+    char* block = output.Reserve(rows * record_size);
+    if (block == nullptr) {
+      return std::io_errc::stream;
+    }
+
+    size_t complete_rows = rows;
+    size_t failed_property = properties.size();
+    size_t failed_offset = 0u;
+    size_t offset = 0u;
+    for (size_t j = 0; j < properties.size(); j++) {
+      size_t written = properties[j].second.write_funcs.write_column(
+          block + offset, record_size, rows);
+      if (written < complete_rows) {
+        complete_rows = written;
+        failed_property = j;
+        failed_offset = offset;
+      }
+
+      offset += field_sizes[j];
+    }
+
+    if (swap_bytes) {
+      swapper.Swap(block, std::min(complete_rows + 1u, rows));
+    }
+
+    if (failed_property != properties.size()) {
+      // The output is left as it would be had the values been written one at
+      // a time, ending with the fields preceding the first missing value
+      output.Commit(complete_rows * record_size + failed_offset);
+      return properties[failed_property].second.write_funcs.write(output);
+    }
+
+    output.Commit(rows * record_size);
+    i += rows;
+  }
+
+  return std::error_code();
+}
+
+std::error_code WriteRow(
+    OutputBuffer& output, Format format,
+    std::vector<std::pair<std::string, Property>>& properties) {
+  bool first = true;
+  for (auto& [property_name, property] : properties) {
+    if (!first && format == Format::ASCII && !output.Put(' ')) {
+      return std::io_errc::stream;
+    }
+
+    if (std::error_code error = property.write_funcs.write(output); error) {
+      return error;
+    }
+
+    first = false;
+  }
+
+  if (format == Format::ASCII && !output.Put('\r')) {
+    return std::io_errc::stream;
+  }
+
+  return std::error_code();
+}
+
+// A range of rows formatted as ASCII by a job run on the pool. The text of a
+// range is kept when it is reused so that its storage is only allocated once.
+struct Range {
+  size_t first_row = 0u;
+  size_t num_rows = 0u;
+  OutputBuffer text;
+  std::error_code error;
+
+  // Released once the range has been formatted
+  std::binary_semaphore formatted{0};
+};
+
+void FormatRange(const std::vector<FormatFunc>& formatters, Range& range) {
+  range.text.Clear();
+  range.error = std::error_code();
+
+  // `text` grows as required so the results of writing to it are not checked
+  for (size_t row = range.first_row;
+       row < range.first_row + range.num_rows && !range.error; row++) {
+    for (size_t i = 0; i < formatters.size(); i++) {
+      if (i != 0u) {
+        range.text.Put(' ');
+      }
+
+      range.error = formatters[i](range.text, row);
+      if (range.error) {
+        break;
+      }
+    }
+
+    if (!range.error) {
+      range.text.Put('\r');
+    }
+  }
+
+  range.formatted.release();
+}
+
+// Writes the instances of an element whose properties each have a batch
+// generator as ASCII, formatting them on `pool`. The values available in the
+// current batch of every property are split into ranges of rows that are each
+// formatted by a job into the range's own buffer. Two ranges per thread are in
+// flight so that later ranges are formatted while the calling thread writes
+// the earlier ones in order.
+std::error_code WriteASCIIRowsInParallel(
+    OutputBuffer& output, plyodine::internal::ThreadPool& pool,
+    uintmax_t count,
+    std::vector<std::pair<std::string, Property>>& properties) {
+  static constexpr size_t kRangeSize = 16384u;
+
+  std::vector<FormatFunc> formatters(properties.size());
+  std::vector<Range> ranges(2u * pool.num_threads());
+  for (uintmax_t i = 0; i < count;) {
+    size_t rows = static_cast<size_t>(
+        std::min(count - i, static_cast<uintmax_t>(
+                                std::numeric_limits<size_t>::max())));
+    for (auto& [_, property] : properties) {
+      rows = std::min(rows, property.write_funcs.available());
+    }
+
+    // A property has run out of values, which is reported by writing the row
+    // one value at a time
+    if (rows == 0u) {
+      if (std::error_code error = WriteRow(output, Format::ASCII, properties);
+          error) {
+        return error;
+      }
+
+      i++;
+      continue;
+    }
+
+    for (size_t j = 0; j < properties.size(); j++) {
+      formatters[j] = properties[j].second.write_funcs.take(rows);
+    }
+
+    // Range `j` of the batch is formatted into `ranges[j % ranges.size()]`,
+    // which is only reused once range `j - ranges.size()` has been written
+    size_t num_ranges = (rows - 1u) / kRangeSize + 1u;
+    size_t submitted = 0u;
+    auto submit = [&]() {
+      Range& range = ranges[submitted % ranges.size()];
+      range.first_row = submitted * kRangeSize;
+      range.num_rows = std::min(kRangeSize, rows - range.first_row);
+      pool.Submit([&formatters, &range]() {
+        FormatRange(formatters, range);
+        return std::error_code();
+      });
+      submitted += 1u;
+    };
+
+    while (submitted < std::min(num_ranges, ranges.size())) {
+      submit();
+    }
+
+    for (size_t j = 0; j < num_ranges; j++) {
+      Range& range = ranges[j % ranges.size()];
+      range.formatted.acquire();
+
+      std::error_code error = range.error;
+      if (!output.Write(range.text.data(), range.text.size())) {
+        error = std::io_errc::stream;
+      }
+
+      if (error) {
+        // The jobs formatting later ranges must complete before the ranges and
+        // the batches they read are destroyed
+        pool.Wait();
+        return error;
+      }
+
+      if (submitted < num_ranges) {
+        submit();
+      }
+    }
+
+    i += rows;
+  }
+
+  return std::error_code();
+}
+
+// Writes the instances of an element whose properties all have batch generators
+// and a fixed size to `file`. The values available in the current batch of
+// every property are split into ranges of records, each of which is assembled
+// and written at its offset in the file by a job run on the file's threads.
+std::error_code WriteRecordsToFile(
+    OutputBuffer& output, plyodine::internal::ParallelFileWriter& file,
+    bool swap_bytes, uintmax_t count,
+    std::vector<std::pair<std::string, Property>>& properties,
+    std::span<const size_t> field_sizes) {
+  static constexpr size_t kRangeSize = 1024u * 1024u;
+
+  // The records are placed after everything written so far
+  if (!output.Flush()) {
+    return std::io_errc::stream;
+  }
+
+  plyodine::internal::RecordByteSwapper swapper(field_sizes);
+  size_t record_size = swapper.record_size();
+  size_t range_rows = std::max<size_t>(1u, kRangeSize / record_size);
+
+  std::vector<CopyColumnFunc> columns(properties.size());
+  for (uintmax_t i = 0; i < count;) {
+    size_t rows = static_cast<size_t>(
+        std::min(count - i, static_cast<uintmax_t>(
+                                std::numeric_limits<size_t>::max())));
+    for (auto& [_, property] : properties) {
+      rows = std::min(rows, property.write_funcs.available());
+    }
+
+    // A property has run out of values, which is reported by writing the row
+    // one value at a time
+    if (rows == 0u) {
+      return WriteRow(output, Format::BINARY_LITTLE_ENDIAN, properties);
+    }
+
+    for (size_t j = 0; j < properties.size(); j++) {
+      columns[j] = properties[j].second.write_funcs.take_column(rows);
+    }
+
+    uint64_t offset = file.Reserve(static_cast<uint64_t>(rows) * record_size);
+    for (size_t first_row = 0u; first_row < rows; first_row += range_rows) {
+      size_t num_rows = std::min(range_rows, rows - first_row);
+      file.Submit([&, first_row, num_rows,
+                   range_offset = offset + first_row * record_size]() {
+        std::vector<char> block(num_rows * record_size);
+        size_t field_offset = 0u;
+        for (size_t j = 0; j < columns.size(); j++) {
+          columns[j](block.data() + field_offset, record_size, first_row,
+                     num_rows);
+          field_offset += field_sizes[j];
+        }
+
+        if (swap_bytes) {
+          swapper.Swap(block.data(), num_rows);
+        }
+
+        return file.WriteAt(block.data(), block.size(), range_offset);
+      });
+    }
+
+    // The batches must remain valid until every job reading them completes
+    if (std::error_code error = file.Wait(); error) {
+      return error;
+    }
+
+    i += rows;
+  }
+
+  return std::error_code();
+}
+
+std::error_code WriteData(
+    OutputBuffer& output, Format format, size_t num_threads,
     std::map<std::string, uintmax_t>& num_element_instances,
     std::vector<
         std::pair<std::string, std::vector<std::pair<std::string, Property>>>>&
         elements,
-    const std::vector<std::string>& comments,
-    const std::vector<std::string>& object_info) {
-  static constexpr std::string_view format_strings[3] = {
-      "ascii", "binary_big_endian", "binary_little_endian"};
+    plyodine::internal::ParallelFileWriter* file = nullptr) {
+  bool swap_bytes =
+      format != Format::ASCII &&
+      (format == Format::BINARY_BIG_ENDIAN) !=
+          (std::endian::native == std::endian::big);
 
-  if (std::error_code error =
-          WriteHeader(stream, format_strings[static_cast<size_t>(format)],
-                      num_element_instances, elements, comments, object_info);
-      error) {
-    return error;
-  }
+  // Started by the first element formatted in parallel and kept for the rest
+  // of the write
+  std::optional<plyodine::internal::ThreadPool> pool;
 
-  std::stringstream storage;
   for (auto& [element_name, properties] : elements) {
+    bool fixed_size = format != Format::ASCII;
+    bool batched = true;
+    std::vector<size_t> field_sizes;
     for (auto& [_, property] : properties) {
-      property.write_func = property.make_write_func();
+      property.write_funcs = property.make_write_funcs();
+      fixed_size &= !(property.data_type_index & 1u);
+      batched &= static_cast<bool>(property.write_funcs.take);
+      field_sizes.push_back(kDataTypeSizes[property.data_type_index >> 1u]);
     }
 
     uintmax_t count = num_element_instances[element_name];
-    for (uintmax_t i = 0; i < count; i++) {
-      bool first = true;
-      for (auto& [property_name, property] : properties) {
-        if (!first && format == Format::ASCII && !stream.put(' ')) {
-          return std::io_errc::stream;
-        }
+    if (fixed_size && batched && !properties.empty() && file != nullptr) {
+      if (std::error_code error = WriteRecordsToFile(
+              output, *file, swap_bytes, count, properties, field_sizes);
+          error) {
+        return error;
+      }
 
-        if (std::error_code error = property.write_func(stream, storage);
-            error) {
-          return error;
-        }
+      continue;
+    }
 
-        first = false;
+    if (fixed_size) {
+      if (std::error_code error = WriteRecords(output, swap_bytes, count,
+                                               properties, field_sizes);
+          error) {
+        return error;
       }
 
-      if (format == Format::ASCII && !stream.put('\r')) {
-        return std::io_errc::stream;
+      continue;
+    }
+
+    if (format == Format::ASCII && batched && num_threads > 1u) {
+      if (!pool) {
+        pool.emplace(num_threads);
+      }
+
+      if (std::error_code error =
+              WriteASCIIRowsInParallel(output, *pool, count, properties);
+          error) {
+        return error;
+      }
+
+      continue;
+    }
+
+    for (uintmax_t i = 0; i < count; i++) {
+      if (std::error_code error = WriteRow(output, format, properties); error) {
+        return error;
       }
     }
   }
@@ -672,6 +1355,77 @@ std::error_code WriteFile(
   return std::error_code();
 }
 
+std::error_code WriteFile(
+    std::ostream& stream, Format format, size_t num_threads,
+    std::map<std::string, uintmax_t>& num_element_instances,
+    std::vector<
+        std::pair<std::string, std::vector<std::pair<std::string, Property>>>>&
+        elements,
+    const std::vector<std::string>& comments,
+    const std::vector<std::string>& object_info) {
+  static constexpr std::string_view format_strings[3] = {
+      "ascii", "binary_big_endian", "binary_little_endian"};
+
+  OutputBuffer output([&stream](const char* data, size_t size) {
+    return static_cast<bool>(
+        stream.write(data, static_cast<std::streamsize>(size)));
+  });
+
+  std::error_code error =
+      WriteHeader(output, format_strings[static_cast<size_t>(format)],
+                  num_element_instances, elements, comments, object_info);
+  if (!error) {
+    error = WriteData(output, format, num_threads, num_element_instances,
+                      elements);
+  }
+
+  // The output preceding an error is still written so that the stream is left
+  // in the same state as if each value had been written to it directly
+  if (!output.Flush()) {
+    return std::io_errc::stream;
+  }
+
+  return error;
+}
+
+std::error_code WriteFileInParallel(
+    plyodine::internal::ParallelFileWriter& file, Format format,
+    size_t num_threads, std::map<std::string, uintmax_t>& num_element_instances,
+    std::vector<
+        std::pair<std::string, std::vector<std::pair<std::string, Property>>>>&
+        elements,
+    const std::vector<std::string>& comments,
+    const std::vector<std::string>& object_info) {
+  static constexpr std::string_view format_strings[3] = {
+      "ascii", "binary_big_endian", "binary_little_endian"};
+
+  OutputBuffer output([&file](const char* data, size_t size) {
+    return file.Append(data, size);
+  });
+
+  std::error_code error =
+      WriteHeader(output, format_strings[static_cast<size_t>(format)],
+                  num_element_instances, elements, comments, object_info);
+  if (!error) {
+    error = WriteData(output, format, num_threads, num_element_instances,
+                      elements, &file);
+  }
+
+  bool flushed = output.Flush();
+
+  // A failed write is reported in preference to the failure of the output
+  // buffer it causes
+  if (std::error_code file_error = file.Finish(); file_error) {
+    return file_error;
+  }
+
+  if (!flushed) {
+    return std::io_errc::stream;
+  }
+
+  return error;
+}
+
 GetElementRankFunc MakeGetElementRankFunc(
     const PlyWriter& ply_writer,
     size_t (PlyWriter::*get_element_rank)(const std::string&) const) {
@@ -753,8 +1507,8 @@ std::error_code PlyWriter::WriteToASCII(std::ostream& stream) const {
                                   &PlyWriter::GetPropertyListSizeType),
       property_generators);
 
-  return WriteFile(stream, Format::ASCII, num_element_instances, properties,
-                   comments, object_info);
+  return WriteFile(stream, Format::ASCII, ply_writer->GetNumThreads(),
+                   num_element_instances, properties, comments, object_info);
 }
 
 std::error_code PlyWriter::WriteToBigEndian(std::ostream& stream) const {
@@ -792,8 +1546,8 @@ std::error_code PlyWriter::WriteToBigEndian(std::ostream& stream) const {
                                   &PlyWriter::GetPropertyListSizeType),
       property_generators);
 
-  return WriteFile(stream, Format::BINARY_BIG_ENDIAN, num_element_instances,
-                   properties, comments, object_info);
+  return WriteFile(stream, Format::BINARY_BIG_ENDIAN, 1u,
+                   num_element_instances, properties, comments, object_info);
 }
 
 std::error_code PlyWriter::WriteToLittleEndian(std::ostream& stream) const {
@@ -831,8 +1585,75 @@ std::error_code PlyWriter::WriteToLittleEndian(std::ostream& stream) const {
                                   &PlyWriter::GetPropertyListSizeType),
       property_generators);
 
-  return WriteFile(stream, Format::BINARY_LITTLE_ENDIAN, num_element_instances,
-                   properties, comments, object_info);
+  return WriteFile(stream, Format::BINARY_LITTLE_ENDIAN, 1u,
+                   num_element_instances, properties, comments, object_info);
+}
+
+std::error_code PlyWriter::WriteToFile(
+    const std::filesystem::path& path) const {
+  constexpr Format format = std::endian::native == std::endian::big
+                                ? Format::BINARY_BIG_ENDIAN
+                                : Format::BINARY_LITTLE_ENDIAN;
+
+  std::unique_ptr<const PlyWriter> final_delegate;
+  const PlyWriter* ply_writer = this;
+  for (;;) {
+    std::unique_ptr<const PlyWriter> delegate = ply_writer->DelegateTo();
+    if (!delegate) {
+      break;
+    }
+
+    ply_writer = delegate.get();
+    final_delegate = std::move(delegate);
+  }
+
+  size_t num_threads = ply_writer->GetNumThreads();
+
+  // Where positional writes are not supported, the file is written as a stream
+  auto file = plyodine::internal::ParallelFileWriter::Open(path, num_threads);
+  std::ofstream stream;
+  if (!file) {
+    if (file.error() != std::errc::function_not_supported) {
+      return file.error();
+    }
+
+    stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream) {
+      return std::make_error_code(std::errc::io_error);
+    }
+  }
+
+  std::map<std::string, uintmax_t> num_element_instances;
+  std::map<std::string, std::map<std::string, PropertyGenerator>>
+      property_generators;
+  std::vector<std::string> comments;
+  std::vector<std::string> object_info;
+  if (std::error_code error = ply_writer->Start(
+          num_element_instances, property_generators, comments, object_info);
+      error) {
+    return error;
+  }
+
+  auto properties = BuildProperties<format>(
+      MakeGetElementRankFunc(*ply_writer, &PlyWriter::GetElementRank),
+      MakeGetPropertyRankFunc(*ply_writer, &PlyWriter::GetPropertyRank),
+      MakeGetPropertyListSizeFunc(*ply_writer,
+                                  &PlyWriter::GetPropertyListSizeType),
+      property_generators);
+
+  std::error_code error =
+      file ? WriteFileInParallel(**file, format, num_threads,
+                                 num_element_instances, properties, comments,
+                                 object_info)
+           : WriteFile(stream, format, 1u, num_element_instances, properties,
+                       comments, object_info);
+
+  // Failures to write the file are reported like failures to open it
+  if (error == std::io_errc::stream) {
+    return std::make_error_code(std::errc::io_error);
+  }
+
+  return error;
 }
 
 // Static assertions to ensure float types are properly sized
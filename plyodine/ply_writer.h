@@ -2,6 +2,7 @@
 #define _PLYODINE_PLY_WRITER_
 
 #include <cstdint>
+#include <filesystem>
 #include <generator>
 #include <map>
 #include <memory>
@@ -14,6 +15,14 @@
 
 namespace plyodine {
 
+// A batch of the values of consecutive instances of a non-list property, as
+// yielded by the batch generators of `PlyWriter`. Batches are wrapped so that
+// a batch generator can never be mistaken for the generator of a property list.
+template <typename T>
+struct PropertyBatch final {
+  std::span<const T> values;
+};
+
 // The base class enabling PLY serialization.
 //
 // Derived classes should implement either `DelegateTo` or `Start` (or both).
@@ -64,6 +73,22 @@ class PlyWriter {
   // NOTE: Behavior is undefined if `stream` is not a binary stream.
   std::error_code WriteToLittleEndian(std::ostream& stream) const;
 
+  // Writes a PLY file to the file at `path` in the binary format matching the
+  // system's native endianness, replacing any existing contents.
+  //
+  // Where supported, the file is written by `GetNumThreads()` threads that
+  // each write disjoint ranges of the file using positional writes. The
+  // records of elements whose properties all have batch generators are also
+  // assembled on these threads, and the storage for each batch of records is
+  // allocated once its values have been generated.
+  //
+  // On success returns an `std::error_code` with a zero value. On failure,
+  // returns an `std::error_code` with a non-zero value and the contents of the
+  // file will be left in an undetermined state. If the file cannot be opened or
+  // written, the error is reported using `std::generic_category` and is
+  // `std::errc::io_error` when the reason is unknown.
+  std::error_code WriteToFile(const std::filesystem::path& path) const;
+
  protected:
   // The constructor of PlyWriter is protected in order to reduce the likelihood
   // of accidentally instantiating this class directly.
@@ -124,17 +149,58 @@ class PlyWriter {
   // A generator that yields the values of a double property list.
   using DoublePropertyListGenerator = std::generator<std::span<const double>>;
 
+  // A generator that yields the values of consecutive instances of a char
+  // property in batches. Each batch yielded holds the values of the instances
+  // following those of the previous batch and may be of any length. The values
+  // are read in place and must remain valid until the generator is next
+  // resumed.
+  using CharPropertyBatchGenerator = std::generator<PropertyBatch<int8_t>>;
+
+  // A generator that yields the values of consecutive instances of a uchar
+  // property in batches.
+  using UCharPropertyBatchGenerator = std::generator<PropertyBatch<uint8_t>>;
+
+  // A generator that yields the values of consecutive instances of a short
+  // property in batches.
+  using ShortPropertyBatchGenerator = std::generator<PropertyBatch<int16_t>>;
+
+  // A generator that yields the values of consecutive instances of a ushort
+  // property in batches.
+  using UShortPropertyBatchGenerator = std::generator<PropertyBatch<uint16_t>>;
+
+  // A generator that yields the values of consecutive instances of an int
+  // property in batches.
+  using IntPropertyBatchGenerator = std::generator<PropertyBatch<int32_t>>;
+
+  // A generator that yields the values of consecutive instances of a uint
+  // property in batches.
+  using UIntPropertyBatchGenerator = std::generator<PropertyBatch<uint32_t>>;
+
+  // A generator that yields the values of consecutive instances of a float
+  // property in batches.
+  using FloatPropertyBatchGenerator = std::generator<PropertyBatch<float>>;
+
+  // A generator that yields the values of consecutive instances of a double
+  // property in batches.
+  using DoublePropertyBatchGenerator = std::generator<PropertyBatch<double>>;
+
   // A variant that contains the generator for a property. The type of the
-  // variant determines the type of the property in the output.
-  using PropertyGenerator =
-      std::variant<CharPropertyGenerator, CharPropertyListGenerator,
-                   UCharPropertyGenerator, UCharPropertyListGenerator,
-                   ShortPropertyGenerator, ShortPropertyListGenerator,
-                   UShortPropertyGenerator, UShortPropertyListGenerator,
-                   IntPropertyGenerator, IntPropertyListGenerator,
-                   UIntPropertyGenerator, UIntPropertyListGenerator,
-                   FloatPropertyGenerator, FloatPropertyListGenerator,
-                   DoublePropertyGenerator, DoublePropertyListGenerator>;
+  // variant determines the type of the property in the output. The batch
+  // generators produce the same output as the generator of the corresponding
+  // non-list property, but are much cheaper to resume for large elements.
+  using PropertyGenerator = std::variant<
+      CharPropertyGenerator, CharPropertyListGenerator, UCharPropertyGenerator,
+      UCharPropertyListGenerator, ShortPropertyGenerator,
+      ShortPropertyListGenerator, UShortPropertyGenerator,
+      UShortPropertyListGenerator, IntPropertyGenerator,
+      IntPropertyListGenerator, UIntPropertyGenerator,
+      UIntPropertyListGenerator, FloatPropertyGenerator,
+      FloatPropertyListGenerator, DoublePropertyGenerator,
+      DoublePropertyListGenerator, CharPropertyBatchGenerator,
+      UCharPropertyBatchGenerator, ShortPropertyBatchGenerator,
+      UShortPropertyBatchGenerator, IntPropertyBatchGenerator,
+      UIntPropertyBatchGenerator, FloatPropertyBatchGenerator,
+      DoublePropertyBatchGenerator>;
 
  private:
   // This function may be implemented by derived classes in order to delegate
@@ -195,6 +261,15 @@ class PlyWriter {
                                  const std::string& property_name) const {
     return 0;
   }
+
+  // This function may be implemented by derived classes to control the number
+  // of threads used to format the data section of ASCII output and to write
+  // files with `WriteToFile`. The instances of elements whose properties each
+  // have a batch generator are formatted in ranges on this many threads and
+  // written in order, so the output does not depend on the number of threads
+  // used. Generators are only ever resumed on the calling thread. Values of
+  // zero or one disable formatting on additional threads.
+  virtual size_t GetNumThreads() const { return 1u; }
 };
 
 }  // namespace plyodine
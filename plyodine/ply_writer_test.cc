@@ -5,6 +5,7 @@
 #include <cctype>
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <generator>
 #include <iterator>
@@ -12,6 +13,7 @@
 #include <memory>
 #include <span>
 #include <sstream>
+#include <streambuf>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -80,6 +82,30 @@ class DefaultSizeWriter final : public PlyWriter {
   std::vector<std::vector<uint8_t>> a_ = {{1}};
 };
 
+class BatchAndListWriter final : public PlyWriter {
+  std::generator<std::span<const float>> ListGenerator() const {
+    co_yield std::span(values_);
+  }
+
+  std::generator<PropertyBatch<float>> BatchGenerator() const {
+    co_yield PropertyBatch<float>{values_};
+  }
+
+  std::error_code Start(
+      std::map<std::string, uintmax_t>& num_element_instances,
+      std::map<std::string, std::map<std::string, PropertyGenerator>>&
+          callbacks,
+      std::vector<std::string>& comments,
+      std::vector<std::string>& object_info) const override {
+    num_element_instances["vertex"] = 1;
+    callbacks["vertex"].try_emplace("a", ListGenerator());
+    callbacks["vertex"].try_emplace("b", BatchGenerator());
+    return std::error_code();
+  }
+
+  std::vector<float> values_ = {1.5f};
+};
+
 class DelegatedWriter final : public PlyWriter {
   std::error_code Start(
       std::map<std::string, uintmax_t>& num_element_instances,
@@ -98,14 +124,16 @@ class TestWriter : public PlyWriter {
       std::span<const std::string> comments,
       std::span<const std::string> object_info, bool start_fails = false,
       bool insert_invalid_element = false, bool should_delegate = false,
-      uint32_t max_size = std::numeric_limits<uint32_t>::max())
+      uint32_t max_size = std::numeric_limits<uint32_t>::max(),
+      bool batched = false)
       : properties_(properties),
         comments_(comments),
         object_info_(object_info),
         start_fails_(start_fails),
         insert_invalid_element_(insert_invalid_element),
         should_delegate_(should_delegate),
-        max_size_(max_size) {}
+        max_size_(max_size),
+        batched_(batched) {}
 
   std::unique_ptr<const PlyWriter> DelegateTo() const {
     if (!should_delegate_) {
@@ -134,6 +162,22 @@ class TestWriter : public PlyWriter {
       auto& num_instances = num_element_instances[element_name];
       for (const auto& [property_name, property] : element_properties) {
         num_instances = std::max(num_instances, property.size());
+
+        if (batched_ && property.index() % 2u == 0u) {
+          std::visit(
+              [&](const auto& values) {
+                using T = std::decay_t<decltype(values[0])>;
+                if constexpr (std::is_arithmetic_v<T>) {
+                  property_callbacks.try_emplace(
+                      property_name,
+                      TestWriter::BatchGenerator<T>(element_name,
+                                                    property_name));
+                }
+              },
+              property);
+          continue;
+        }
+
         switch (property.index()) {
           case 0:
             property_callbacks.try_emplace(
@@ -276,6 +320,20 @@ class TestWriter : public PlyWriter {
     }
   }
 
+  // Yields batches of varying sizes, including empty batches, so that the
+  // rows of the output straddle the boundaries between batches
+  template <typename T>
+  std::generator<PropertyBatch<T>> BatchGenerator(
+      const std::string& element_name, const std::string& property_name) const {
+    std::span<const T> values = std::get<std::span<const T>>(
+        properties_.at(element_name).at(property_name));
+    for (size_t size = 0u; !values.empty(); size = (size + 1u) % 5u) {
+      std::span<const T> batch = values.first(std::min(size, values.size()));
+      co_yield PropertyBatch<T>{batch};
+      values = values.subspan(batch.size());
+    }
+  }
+
   const std::map<std::string, std::map<std::string, Property>>& properties_;
   std::span<const std::string> comments_;
   std::span<const std::string> object_info_;
@@ -283,6 +341,24 @@ class TestWriter : public PlyWriter {
   bool insert_invalid_element_;
   bool should_delegate_;
   uint32_t max_size_;
+  bool batched_;
+};
+
+// Produces the values of each non-list property with a batch generator
+class BatchWriter final : public TestWriter {
+ public:
+  BatchWriter(
+      const std::map<std::string, std::map<std::string, Property>>& properties,
+      std::span<const std::string> comments = {},
+      std::span<const std::string> object_info = {}, size_t num_threads = 1u)
+      : TestWriter(properties, comments, object_info, false, false, false,
+                   std::numeric_limits<uint32_t>::max(), true),
+        num_threads_(num_threads) {}
+
+ private:
+  size_t GetNumThreads() const override { return num_threads_; }
+
+  size_t num_threads_;
 };
 
 class ReversedWriter final : public TestWriter {
@@ -572,6 +648,39 @@ TEST(Validate, UnbalancedProperties) {
             "value for every instance of its element)");
 }
 
+TEST(Validate, UnbalancedPropertiesBinary) {
+  static const std::vector<int8_t> a = {-1, 2, 0};
+  static const std::vector<uint8_t> b = {1u, 2u};
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+
+  std::stringstream output(std::ios::out | std::ios::binary);
+  EXPECT_EQ(WriteToBigEndian(output, properties).message(),
+            "A property with type 'uchar' was missing data (must contain a "
+            "value for every instance of its element)");
+  EXPECT_EQ(output.str(),
+            std::string("ply\rformat binary_big_endian 1.0\relement vertex 3\r"
+                        "property char a\rproperty uchar b\rend_header\r") +
+                std::string("\xff\x01\x02\x02\x00", 5u));
+}
+
+TEST(Validate, UnbalancedBatchProperties) {
+  static const std::vector<int8_t> a = {-1, 2, 0};
+  static const std::vector<uint8_t> b = {1u, 2u};
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+
+  BatchWriter writer(properties);
+  std::stringstream output(std::ios::out | std::ios::binary);
+  EXPECT_EQ(writer.WriteToBigEndian(output).message(),
+            "A property with type 'uchar' was missing data (must contain a "
+            "value for every instance of its element)");
+}
+
 TEST(All, DefaultListSize) {
   DefaultSizeWriter writer;
   std::stringstream output(std::ios::out | std::ios::binary);
@@ -588,6 +697,23 @@ TEST(All, DefaultListSize) {
   EXPECT_EQ(expected, output.str());
 }
 
+TEST(All, BatchesAreNotLists) {
+  BatchAndListWriter writer;
+  std::stringstream output(std::ios::out | std::ios::binary);
+  EXPECT_EQ(0, writer.WriteToASCII(output).value());
+
+  std::stringstream input(
+      "ply\r"
+      "format ascii 1.0\r"
+      "element vertex 1\r"
+      "property list uint float a\r"
+      "property float b\r"
+      "end_header\r"
+      "1 1.5 1.5\r");
+  std::string expected(std::istreambuf_iterator<char>(input), {});
+  EXPECT_EQ(expected, output.str());
+}
+
 TEST(All, NoInstances) {
   std::map<std::string, std::map<std::string, Property>> properties;
   properties["vertex"]["a"] = std::vector<int8_t>();
@@ -626,6 +752,122 @@ TEST(All, Ordering) {
   EXPECT_EQ(expected, output.str());
 }
 
+TEST(All, BatchTestData) {
+  auto properties = BuildTestData();
+  std::string comments[] = {{"comment 1"}, {"comment 2"}};
+  std::string object_info[] = {{"obj info 1"}, {"obj info 2"}};
+  BatchWriter writer(properties, comments, object_info);
+
+  std::stringstream ascii(std::ios::out | std::ios::binary);
+  ASSERT_EQ(writer.WriteToASCII(ascii).value(), 0);
+  std::ifstream ascii_input =
+      OpenRunfile("_main/plyodine/test_data/ply_ascii_data.ply");
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(ascii_input), {}),
+            ascii.str());
+
+  std::stringstream big(std::ios::out | std::ios::binary);
+  ASSERT_EQ(writer.WriteToBigEndian(big).value(), 0);
+  std::ifstream big_input =
+      OpenRunfile("_main/plyodine/test_data/ply_big_data.ply");
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(big_input), {}),
+            big.str());
+
+  std::stringstream little(std::ios::out | std::ios::binary);
+  ASSERT_EQ(writer.WriteToLittleEndian(little).value(), 0);
+  std::ifstream little_input =
+      OpenRunfile("_main/plyodine/test_data/ply_little_data.ply");
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(little_input), {}),
+            little.str());
+}
+
+TEST(All, BatchLargeElement) {
+  std::vector<uint8_t> a;
+  std::vector<int16_t> b;
+  std::vector<float> c;
+  std::vector<double> d;
+  for (uint32_t i = 0; i < 100000u; i++) {
+    a.push_back(static_cast<uint8_t>(i));
+    b.push_back(static_cast<int16_t>(i * 7u));
+    c.push_back(static_cast<float>(i) / 3.0f);
+    d.push_back(static_cast<double>(i) * 1.25);
+  }
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+  properties["vertex"]["c"] = c;
+  properties["vertex"]["d"] = d;
+  properties["point"]["a"] = c;
+
+  TestWriter expected_writer(properties, {}, {});
+  BatchWriter writer(properties);
+  for (auto write : {&PlyWriter::WriteToASCII, &PlyWriter::WriteToBigEndian,
+                     &PlyWriter::WriteToLittleEndian}) {
+    std::stringstream expected(std::ios::out | std::ios::binary);
+    ASSERT_EQ((expected_writer.*write)(expected).value(), 0);
+
+    std::stringstream output(std::ios::out | std::ios::binary);
+    ASSERT_EQ((writer.*write)(output).value(), 0);
+    EXPECT_EQ(expected.str(), output.str());
+  }
+}
+
+// A stream buffer that accepts at most `capacity` bytes.
+class LimitedStreamBuf final : public std::streambuf {
+ public:
+  explicit LimitedStreamBuf(size_t capacity) : capacity_(capacity) {}
+
+  const std::string& contents() const { return contents_; }
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+
+    if (contents_.size() == capacity_) {
+      return traits_type::eof();
+    }
+
+    contents_.push_back(traits_type::to_char_type(c));
+    return c;
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize count) override {
+    size_t size = std::min(static_cast<size_t>(count),
+                           capacity_ - contents_.size());
+    contents_.append(s, size);
+    return static_cast<std::streamsize>(size);
+  }
+
+ private:
+  size_t capacity_;
+  std::string contents_;
+};
+
+TEST(All, StreamFails) {
+  std::string comments[] = {{"comment 1"}, {"comment 2"}};
+  std::string object_info[] = {{"obj info 1"}, {"obj info 2"}};
+  auto properties = BuildTestData();
+  TestWriter writer(properties, comments, object_info);
+
+  for (auto write_to :
+       {&PlyWriter::WriteToASCII, &PlyWriter::WriteToBigEndian,
+        &PlyWriter::WriteToLittleEndian}) {
+    std::stringstream expected(std::ios::out | std::ios::binary);
+    ASSERT_EQ(0, (writer.*write_to)(expected).value());
+
+    for (size_t capacity : {0u, 10u, 100u, 200u}) {
+      ASSERT_LT(capacity, expected.str().size());
+
+      LimitedStreamBuf buffer(capacity);
+      std::ostream output(&buffer);
+      EXPECT_EQ(std::io_errc::stream, (writer.*write_to)(output));
+      EXPECT_EQ(expected.str().substr(0u, capacity), buffer.contents());
+    }
+  }
+}
+
 TEST(ASCII, Empty) {
   EmptyWriter writer;
   std::stringstream output(std::ios::out | std::ios::binary);
@@ -736,6 +978,56 @@ TEST(ASCII, SmallFP) {
   EXPECT_EQ(expected, output.str());
 }
 
+TEST(ASCII, Parallel) {
+  std::vector<int32_t> a;
+  std::vector<float> b;
+  std::vector<double> c;
+  for (uint32_t i = 0; i < 100000u; i++) {
+    a.push_back(static_cast<int32_t>(i) - 50000);
+    b.push_back(static_cast<float>(i) / 7.0f);
+    c.push_back(static_cast<double>(i) * 1e10);
+  }
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+  properties["vertex"]["c"] = c;
+  properties["point"]["a"] = b;
+
+  BatchWriter expected_writer(properties);
+  std::stringstream expected(std::ios::out | std::ios::binary);
+  ASSERT_EQ(expected_writer.WriteToASCII(expected).value(), 0);
+
+  for (size_t num_threads : {2u, 3u, 8u}) {
+    BatchWriter writer(properties, {}, {}, num_threads);
+    std::stringstream output(std::ios::out | std::ios::binary);
+    ASSERT_EQ(writer.WriteToASCII(output).value(), 0);
+    EXPECT_EQ(expected.str(), output.str());
+  }
+}
+
+TEST(ASCII, ParallelNonFinite) {
+  std::vector<uint16_t> a(100000u, 7u);
+  std::vector<float> b(100000u, 0.5f);
+  b[70000] = std::numeric_limits<float>::infinity();
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+
+  BatchWriter expected_writer(properties);
+  std::stringstream expected(std::ios::out | std::ios::binary);
+  std::error_code expected_error = expected_writer.WriteToASCII(expected);
+  ASSERT_EQ(expected_error.message(),
+            "A property with type 'float' had a value that was out of range "
+            "for output format 'ascii' (must be finite)");
+
+  BatchWriter writer(properties, {}, {}, 4u);
+  std::stringstream output(std::ios::out | std::ios::binary);
+  EXPECT_EQ(expected_error, writer.WriteToASCII(output));
+  EXPECT_EQ(expected.str(), output.str());
+}
+
 TEST(BigEndian, Empty) {
   EmptyWriter writer;
   std::stringstream output(std::ios::out | std::ios::binary);
@@ -771,6 +1063,105 @@ TEST(BigEndian, ListSizes) {
   EXPECT_EQ(expected, output.str());
 }
 
+TEST(BigEndian, LongList) {
+  std::vector<uint32_t> values;
+  for (uint32_t i = 0; i < 50000u; i++) {
+    values.push_back(i);
+  }
+
+  const std::vector<std::span<const uint32_t>> lists = {
+      {values}, {values.data(), 3u}};
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["l"] = lists;
+
+  std::stringstream output(std::ios::out | std::ios::binary);
+  ASSERT_EQ(WriteToBigEndian(output, properties).value(), 0);
+
+  std::string expected =
+      "ply\rformat binary_big_endian 1.0\relement vertex 2\r"
+      "property list ushort uint l\rend_header\r";
+  auto append = [&](auto value) {
+    if (std::endian::native != std::endian::big) {
+      value = std::byteswap(value);
+    }
+    expected.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  for (const auto& list : lists) {
+    append(static_cast<uint16_t>(list.size()));
+    for (uint32_t value : list) {
+      append(value);
+    }
+  }
+
+  EXPECT_EQ(expected, output.str());
+}
+
+TEST(BigEndian, EmptyList) {
+  // The data of a default constructed span is null
+  const std::vector<std::span<const float>> lists = {{}, {}};
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["l"] = lists;
+
+  std::stringstream output(std::ios::out | std::ios::binary);
+  ASSERT_EQ(WriteToBigEndian(output, properties).value(), 0);
+
+  std::string expected =
+      "ply\rformat binary_big_endian 1.0\relement vertex 2\r"
+      "property list uchar float l\rend_header\r";
+  expected.append(2u, '\0');
+  EXPECT_EQ(expected, output.str());
+}
+
+TEST(BigEndian, WideRecords) {
+  std::vector<std::vector<float>> floats(20u);
+  std::vector<std::vector<uint16_t>> ushorts(20u);
+  for (uint32_t i = 0; i < 3000u; i++) {
+    for (uint32_t j = 0; j < 20u; j++) {
+      floats[j].push_back(static_cast<float>(i * 20u + j) * 0.25f);
+      ushorts[j].push_back(static_cast<uint16_t>(i * 20u + j));
+    }
+  }
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  std::string expected =
+      "ply\rformat binary_big_endian 1.0\relement vertex 3000\r";
+  for (uint32_t j = 0; j < 20u; j++) {
+    std::string suffix = std::to_string(j / 10u) + std::to_string(j % 10u);
+    properties["vertex"]["f" + suffix] = floats[j];
+    properties["vertex"]["u" + suffix] = ushorts[j];
+  }
+  for (uint32_t j = 0; j < 20u; j++) {
+    expected += "property float f" + std::to_string(j / 10u) +
+                std::to_string(j % 10u) + "\r";
+  }
+  for (uint32_t j = 0; j < 20u; j++) {
+    expected += "property ushort u" + std::to_string(j / 10u) +
+                std::to_string(j % 10u) + "\r";
+  }
+  expected += "end_header\r";
+
+  auto append = [&](auto value) {
+    if (std::endian::native != std::endian::big) {
+      value = std::byteswap(value);
+    }
+    expected.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  for (uint32_t i = 0; i < 3000u; i++) {
+    for (uint32_t j = 0; j < 20u; j++) {
+      append(std::bit_cast<uint32_t>(floats[j][i]));
+    }
+    for (uint32_t j = 0; j < 20u; j++) {
+      append(ushorts[j][i]);
+    }
+  }
+
+  std::stringstream output(std::ios::out | std::ios::binary);
+  ASSERT_EQ(WriteToBigEndian(output, properties).value(), 0);
+  EXPECT_EQ(expected, output.str());
+}
+
 TEST(LittleEndian, Empty) {
   EmptyWriter writer;
   std::stringstream output(std::ios::out | std::ios::binary);
@@ -806,6 +1197,23 @@ TEST(LittleEndian, ListSizes) {
   EXPECT_EQ(expected, output.str());
 }
 
+TEST(LittleEndian, EmptyList) {
+  // The data of a default constructed span is null
+  const std::vector<std::span<const float>> lists = {{}, {}};
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["l"] = lists;
+
+  std::stringstream output(std::ios::out | std::ios::binary);
+  ASSERT_EQ(WriteToLittleEndian(output, properties).value(), 0);
+
+  std::string expected =
+      "ply\rformat binary_little_endian 1.0\relement vertex 2\r"
+      "property list uchar float l\rend_header\r";
+  expected.append(2u, '\0');
+  EXPECT_EQ(expected, output.str());
+}
+
 TEST(Native, Empty) {
   std::stringstream output(std::ios::out | std::ios::binary);
   ASSERT_EQ(WriteTo(output, {}).value(), 0);
@@ -859,5 +1267,102 @@ TEST(Native, ListSizes) {
   }
 }
 
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream input(path, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(input), {});
+}
+
+TEST(File, TestData) {
+  auto properties = BuildTestData();
+  std::string comments[] = {{"comment 1"}, {"comment 2"}};
+  std::string object_info[] = {{"obj info 1"}, {"obj info 2"}};
+  TestWriter writer(properties, comments, object_info);
+
+  std::stringstream expected(std::ios::out | std::ios::binary);
+  ASSERT_EQ(writer.WriteTo(expected).value(), 0);
+
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "ply_writer_test_data";
+  ASSERT_EQ(writer.WriteToFile(path).value(), 0);
+  EXPECT_EQ(expected.str(), ReadFile(path));
+
+  BatchWriter batch_writer(properties, comments, object_info, 4u);
+  ASSERT_EQ(batch_writer.WriteToFile(path).value(), 0);
+  EXPECT_EQ(expected.str(), ReadFile(path));
+}
+
+TEST(File, LargeElements) {
+  std::vector<uint8_t> a;
+  std::vector<int16_t> b;
+  std::vector<float> c;
+  std::vector<double> d;
+  std::vector<int32_t> values(3u, 5);
+  std::vector<std::span<const int32_t>> e;
+  for (uint32_t i = 0; i < 300000u; i++) {
+    a.push_back(static_cast<uint8_t>(i));
+    b.push_back(static_cast<int16_t>(i * 7u));
+    c.push_back(static_cast<float>(i) / 3.0f);
+    d.push_back(static_cast<double>(i) * 1.25);
+    e.push_back(std::span<const int32_t>(values).first(i % 4u));
+  }
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+  properties["vertex"]["c"] = c;
+  properties["vertex"]["d"] = d;
+  properties["face"]["a"] = e;
+  properties["point"]["a"] = d;
+
+  TestWriter expected_writer(properties, {}, {});
+  std::stringstream expected(std::ios::out | std::ios::binary);
+  ASSERT_EQ(expected_writer.WriteTo(expected).value(), 0);
+
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "ply_writer_large_elements";
+  for (size_t num_threads : {1u, 2u, 8u}) {
+    BatchWriter writer(properties, {}, {}, num_threads);
+    ASSERT_EQ(writer.WriteToFile(path).value(), 0);
+    EXPECT_EQ(expected.str(), ReadFile(path));
+  }
+}
+
+TEST(File, UnbalancedBatchProperties) {
+  std::vector<int8_t> a(100000u, 1);
+  std::vector<uint8_t> b(99999u, 2u);
+
+  std::map<std::string, std::map<std::string, Property>> properties;
+  properties["vertex"]["a"] = a;
+  properties["vertex"]["b"] = b;
+
+  BatchWriter writer(properties, {}, {}, 4u);
+  std::stringstream expected(std::ios::out | std::ios::binary);
+  std::error_code expected_error = writer.WriteTo(expected);
+  ASSERT_EQ(expected_error.message(),
+            "A property with type 'uchar' was missing data (must contain a "
+            "value for every instance of its element)");
+
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "ply_writer_unbalanced";
+  EXPECT_EQ(expected_error, writer.WriteToFile(path));
+  EXPECT_EQ(expected.str(), ReadFile(path));
+}
+
+TEST(File, StartFails) {
+  TestWriter writer({}, {}, {}, true);
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "ply_writer_start_fails";
+  EXPECT_EQ(1, writer.WriteToFile(path).value());
+}
+
+TEST(File, OpenFails) {
+  EmptyWriter writer;
+  std::filesystem::path path =
+      std::filesystem::path(testing::TempDir()) / "missing" / "file.ply";
+  std::error_code error = writer.WriteToFile(path);
+  EXPECT_NE(0, error.value());
+  EXPECT_EQ(std::generic_category(), error.category());
+}
+
 }  // namespace
 }  // namespace plyodine
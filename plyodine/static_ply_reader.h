@@ -0,0 +1,540 @@
+#ifndef _PLYODINE_STATIC_PLY_READER_
+#define _PLYODINE_STATIC_PLY_READER_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "plyodine/byte_source.h"
+#include "plyodine/internal/static_ply_input.h"
+#include "plyodine/ply_header_reader.h"
+
+namespace plyodine {
+
+// A string literal usable as a template argument for naming the elements and
+// properties of a `PlySchema`.
+template <size_t N>
+struct PlyName final {
+  constexpr PlyName(const char (&name)[N]) { std::copy_n(name, N, value); }
+
+  constexpr std::string_view view() const {
+    return std::string_view(value, N - 1u);
+  }
+
+  char value[N];
+};
+
+namespace internal {
+
+template <typename T>
+concept StaticPlyType =
+    std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t> ||
+    std::is_same_v<T, int16_t> || std::is_same_v<T, uint16_t> ||
+    std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename T>
+concept StaticPlyListSizeType =
+    StaticPlyType<T> && !std::is_floating_point_v<T>;
+
+template <StaticPlyType T>
+constexpr PlyHeader::Property::Type GetStaticPlyType() {
+  if constexpr (std::is_same_v<T, int8_t>) {
+    return PlyHeader::Property::Type::CHAR;
+  } else if constexpr (std::is_same_v<T, uint8_t>) {
+    return PlyHeader::Property::Type::UCHAR;
+  } else if constexpr (std::is_same_v<T, int16_t>) {
+    return PlyHeader::Property::Type::SHORT;
+  } else if constexpr (std::is_same_v<T, uint16_t>) {
+    return PlyHeader::Property::Type::USHORT;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return PlyHeader::Property::Type::INT;
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return PlyHeader::Property::Type::UINT;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return PlyHeader::Property::Type::FLOAT;
+  } else {
+    return PlyHeader::Property::Type::DOUBLE;
+  }
+}
+
+// Returns true if no two entries of `names` are equal.
+template <size_t N>
+constexpr bool HasUniqueNames(const std::array<std::string_view, N>& names) {
+  for (size_t i = 0u; i < N; i++) {
+    for (size_t j = i + 1u; j < N; j++) {
+      if (names[i] == names[j]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace internal
+
+// A property of an element of a `PlySchema` holding a single value of type `T`
+// which is passed to the handler as a `T`.
+template <PlyName Name, internal::StaticPlyType T>
+struct PlyProperty final {
+  using Value = T;
+  using Storage = T;
+
+  static constexpr std::string_view kName = Name.view();
+  static constexpr PlyHeader::Property::Type kDataType =
+      internal::GetStaticPlyType<T>();
+
+  static bool Matches(const PlyHeader::Property& property) {
+    return property.name == kName && property.data_type == kDataType &&
+           !property.list_type;
+  }
+};
+
+// A property of an element of a `PlySchema` holding a list of values of type
+// `T` with its size stored as a `SizeType`. The list is passed to the handler
+// as an `std::span<const T>` which remains valid only for the duration of the
+// call.
+template <PlyName Name, internal::StaticPlyType T,
+          internal::StaticPlyListSizeType SizeType = uint8_t>
+struct PlyPropertyList final {
+  using Value = std::span<const T>;
+  using Storage = std::vector<T>;
+  using Size = SizeType;
+
+  static constexpr std::string_view kName = Name.view();
+  static constexpr PlyHeader::Property::Type kDataType =
+      internal::GetStaticPlyType<T>();
+  static constexpr PlyHeader::Property::Type kListType =
+      internal::GetStaticPlyType<SizeType>();
+
+  static bool Matches(const PlyHeader::Property& property) {
+    return property.name == kName && property.data_type == kDataType &&
+           property.list_type == kListType;
+  }
+};
+
+// An element of a `PlySchema` with the properties `Properties` in the order in
+// which they appear in the input.
+template <PlyName Name, typename... Properties>
+struct PlyElement final {
+  static_assert(internal::HasUniqueNames(
+                    std::array<std::string_view, sizeof...(Properties)>{
+                        Properties::kName...}),
+                "The properties of a PlyElement must have unique names");
+
+  // The type of the values passed to the handler for each instance of the
+  // element.
+  using Values = std::tuple<typename Properties::Value...>;
+
+  static constexpr std::string_view kName = Name.view();
+
+  static bool Matches(const PlyHeader::Element& element) {
+    if (element.properties.size() != sizeof...(Properties)) {
+      return false;
+    }
+
+    size_t index = 0u;
+    return (Properties::Matches(element.properties[index++]) && ...);
+  }
+};
+
+// The set of elements expected to be found in a PLY input.
+template <typename... Elements>
+struct PlySchema final {};
+
+// A PLY reader for inputs whose layout is known at compile time.
+//
+// Unlike `PlyReader`, which resolves the type of each property at runtime and
+// delivers values through type-erased callbacks, `StaticPlyReader` checks the
+// header of the input against `Schema` once and then decodes each instance with
+// a loop generated for the element's exact layout before passing its values to
+// the handler.
+//
+// Each element of the schema must be present in the input with exactly the
+// properties listed in the schema, in the same order and with the same types.
+// No conversions are performed. The elements of the schema may appear in the
+// input in any order and elements of the input that are not in the schema are
+// skipped.
+//
+// For each instance of an element `E` of the schema, the handler is invoked as
+// `handler(E(), values)` where `values` is a `const E::Values&`. The handler
+// must return an `std::error_code` and if a non-zero value is returned reading
+// stops and that error is returned.
+//
+// NOTE: Since values are decoded in place, only inputs held in memory are
+// supported. `PlyReader` should be used for reading from streams.
+template <typename Schema>
+class StaticPlyReader;
+
+template <typename... Elements>
+class StaticPlyReader<PlySchema<Elements...>> final {
+  static_assert(internal::HasUniqueNames(
+                    std::array<std::string_view, sizeof...(Elements)>{
+                        Elements::kName...}),
+                "The elements of a PlySchema must have unique names");
+
+ public:
+  // Reads the PLY input contained in `data`. On failure, returns an
+  // `std::error_code` containing a non-zero value.
+  template <typename Handler>
+  static std::error_code ReadFrom(std::span<const std::byte> data,
+                                  Handler&& handler) {
+    auto header = ReadPlyHeader(data);
+    if (!header) {
+      return header.error();
+    }
+
+    std::vector<size_t> schema_indices;
+    std::array<bool, sizeof...(Elements)> found = {};
+    for (const PlyHeader::Element& element : header->elements) {
+      size_t schema_index = FindElement(
+          element, std::make_index_sequence<sizeof...(Elements)>());
+      if (schema_index < sizeof...(Elements)) {
+        if (!kMatches[schema_index](element)) {
+          return internal::MakeStaticPlyError(
+              internal::StaticPlyError::MISMATCHED_PROPERTIES);
+        }
+
+        found[schema_index] = true;
+      }
+
+      schema_indices.push_back(schema_index);
+    }
+
+    if (std::find(found.begin(), found.end(), false) != found.end()) {
+      return internal::MakeStaticPlyError(
+          internal::StaticPlyError::MISSING_ELEMENT);
+    }
+
+    internal::StaticPlyInput input(data.subspan(header->data_offset),
+                                   header->line_ending);
+    for (size_t i = 0; i < header->elements.size(); i++) {
+      std::error_code error;
+      if (schema_indices[i] < sizeof...(Elements)) {
+        error = ReadElement(header->format, header->elements[i].instance_count,
+                            schema_indices[i], input, handler,
+                            std::make_index_sequence<sizeof...(Elements)>());
+      } else {
+        error = input.SkipElement(header->format, header->elements[i]);
+      }
+
+      if (error) {
+        return error;
+      }
+    }
+
+    return std::error_code();
+  }
+
+  // Reads the PLY file at `path`. If the file cannot be opened or read, the
+  // error is reported using `std::generic_category` and is
+  // `std::errc::io_error` when the reason is unknown.
+  //
+  // Where supported, the file is memory mapped rather than read into memory.
+  template <typename Handler>
+  static std::error_code ReadFrom(const std::filesystem::path& path,
+                                  Handler&& handler) {
+    auto source = MappedFileByteSource::Open(path);
+    if (!source) {
+      return source.error();
+    }
+
+    // The source returns the contents of the file as a single buffer
+    auto data = source->Next();
+    if (!data) {
+      return data.error();
+    }
+
+    return ReadFrom(*data, std::forward<Handler>(handler));
+  }
+
+ private:
+  static constexpr std::array<bool (*)(const PlyHeader::Element&),
+                              sizeof...(Elements)>
+      kMatches = {&Elements::Matches...};
+
+  template <size_t... I>
+  static size_t FindElement(const PlyHeader::Element& element,
+                            std::index_sequence<I...>) {
+    size_t result = sizeof...(Elements);
+    static_cast<void>(
+        ((element.name == Elements::kName ? (result = I, true) : false) ||
+         ...));
+    return result;
+  }
+
+  template <typename Handler, size_t... I>
+  static std::error_code ReadElement(PlyHeader::Format format,
+                                     uintmax_t instance_count,
+                                     size_t schema_index,
+                                     internal::StaticPlyInput& input,
+                                     Handler& handler,
+                                     std::index_sequence<I...>) {
+    std::error_code result;
+    static_cast<void>(
+        ((schema_index == I
+              ? (result = ElementReader<Elements>::Read(format, instance_count,
+                                                        input, handler),
+                 true)
+              : false) ||
+         ...));
+    return result;
+  }
+
+  template <typename Element>
+  struct ElementReader;
+
+  template <PlyName Name, typename... Properties>
+  struct ElementReader<PlyElement<Name, Properties...>> final {
+    using Element = PlyElement<Name, Properties...>;
+    using Storage = std::tuple<typename Properties::Storage...>;
+
+    static constexpr bool kFixedSize =
+        (std::is_same_v<typename Properties::Value,
+                        typename Properties::Storage> &&
+         ...);
+
+    static constexpr size_t kInstanceSize =
+        (sizeof(typename Properties::Storage) + ... + 0u);
+
+    static constexpr std::array<size_t, sizeof...(Properties)> kOffsets =
+        [] {
+          std::array<size_t, sizeof...(Properties)> offsets = {};
+          size_t offset = 0u;
+          size_t index = 0u;
+          ((offsets[index++] = offset,
+            offset += sizeof(typename Properties::Storage)),
+           ...);
+          return offsets;
+        }();
+
+    template <typename Handler>
+    static std::error_code Read(PlyHeader::Format format,
+                                uintmax_t instance_count,
+                                internal::StaticPlyInput& input,
+                                Handler& handler) {
+      switch (format) {
+        case PlyHeader::Format::ASCII:
+          return ReadASCII(instance_count, input, handler);
+        case PlyHeader::Format::BINARY_BIG_ENDIAN:
+          return ReadBinary<std::endian::big>(instance_count, input, handler);
+        case PlyHeader::Format::BINARY_LITTLE_ENDIAN:
+          return ReadBinary<std::endian::little>(instance_count, input,
+                                                 handler);
+      }
+
+      return std::error_code();
+    }
+
+    template <typename Handler>
+    static std::error_code Deliver(Handler& handler, const Storage& storage) {
+      return std::apply(
+          [&](const auto&... storage) {
+            const typename Element::Values values(storage...);
+            return static_cast<std::error_code>(handler(Element(), values));
+          },
+          storage);
+    }
+
+    template <std::endian Endianness, typename T>
+    static T Load(const char* bytes) {
+      T value;
+      std::memcpy(&value, bytes, sizeof(T));
+
+      if constexpr (Endianness != std::endian::native && sizeof(T) != 1u) {
+        using Bits = std::conditional_t<
+            sizeof(T) == 2u, uint16_t,
+            std::conditional_t<sizeof(T) == 4u, uint32_t, uint64_t>>;
+        value = std::bit_cast<T>(std::byteswap(std::bit_cast<Bits>(value)));
+      }
+
+      return value;
+    }
+
+    template <std::endian Endianness, size_t... I>
+    static void LoadInstance(const char* bytes, Storage& storage,
+                             std::index_sequence<I...>) {
+      ((std::get<I>(storage) =
+            Load<Endianness, std::tuple_element_t<I, Storage>>(bytes +
+                                                               kOffsets[I])),
+       ...);
+    }
+
+    template <std::endian Endianness, typename Property>
+    static std::error_code ReadBinaryProperty(
+        internal::StaticPlyInput& input, typename Property::Storage& storage) {
+      if constexpr (std::is_same_v<typename Property::Value,
+                                   typename Property::Storage>) {
+        const char* bytes = input.Take(sizeof(storage));
+        if (!bytes) {
+          return internal::MakeStaticPlyError(
+              internal::StaticPlyError::UNEXPECTED_EOF);
+        }
+
+        storage = Load<Endianness, typename Property::Storage>(bytes);
+      } else {
+        using T = typename Property::Storage::value_type;
+        using SizeType = typename Property::Size;
+
+        const char* bytes = input.Take(sizeof(SizeType));
+        if (!bytes) {
+          return internal::MakeStaticPlyError(
+              internal::StaticPlyError::UNEXPECTED_EOF);
+        }
+
+        SizeType size = Load<Endianness, SizeType>(bytes);
+        if constexpr (std::is_signed_v<SizeType>) {
+          if (size < 0) {
+            return internal::MakeStaticPlyError(
+                internal::StaticPlyError::NEGATIVE_LIST_SIZE);
+          }
+        }
+
+        if (input.remaining() / sizeof(T) < static_cast<size_t>(size)) {
+          return internal::MakeStaticPlyError(
+              internal::StaticPlyError::UNEXPECTED_EOF);
+        }
+
+        storage.resize(static_cast<size_t>(size));
+        bytes = input.Take(sizeof(T) * storage.size());
+        for (T& entry : storage) {
+          entry = Load<Endianness, T>(bytes);
+          bytes += sizeof(T);
+        }
+      }
+
+      return std::error_code();
+    }
+
+    template <std::endian Endianness, typename Handler>
+    static std::error_code ReadBinary(uintmax_t instance_count,
+                                      internal::StaticPlyInput& input,
+                                      Handler& handler) {
+      Storage storage;
+      for (uintmax_t instance = 0; instance < instance_count; instance++) {
+        if constexpr (kFixedSize) {
+          const char* bytes = input.Take(kInstanceSize);
+          if (!bytes) {
+            return internal::MakeStaticPlyError(
+                internal::StaticPlyError::UNEXPECTED_EOF);
+          }
+
+          LoadInstance<Endianness>(
+              bytes, storage, std::index_sequence_for<Properties...>());
+        } else {
+          std::error_code error;
+          std::apply(
+              [&](auto&... storage) {
+                ((error = ReadBinaryProperty<Endianness, Properties>(input,
+                                                                     storage),
+                  !error) &&
+                 ...);
+              },
+              storage);
+          if (error) {
+            return error;
+          }
+        }
+
+        if (std::error_code error = Deliver(handler, storage); error) {
+          return error;
+        }
+      }
+
+      return std::error_code();
+    }
+
+    template <typename Property>
+    static std::error_code ReadASCIIProperty(
+        internal::StaticPlyInput& input, typename Property::Storage& storage) {
+      std::string_view token;
+      if (std::error_code error = input.NextToken(token); error) {
+        return error;
+      }
+
+      if constexpr (std::is_same_v<typename Property::Value,
+                                   typename Property::Storage>) {
+        return internal::ParseToken(token, storage);
+      } else {
+        using SizeType = typename Property::Size;
+
+        SizeType size;
+        if (std::error_code error = internal::ParseToken(token, size); error) {
+          return error;
+        }
+
+        if constexpr (std::is_signed_v<SizeType>) {
+          if (size < 0) {
+            return internal::MakeStaticPlyError(
+                internal::StaticPlyError::NEGATIVE_LIST_SIZE);
+          }
+        }
+
+        storage.clear();
+        for (SizeType i = 0; i < size; i++) {
+          if (std::error_code error = input.NextToken(token); error) {
+            return error;
+          }
+
+          if (std::error_code error =
+                  internal::ParseToken(token, storage.emplace_back());
+              error) {
+            return error;
+          }
+        }
+      }
+
+      return std::error_code();
+    }
+
+    template <typename Handler>
+    static std::error_code ReadASCII(uintmax_t instance_count,
+                                     internal::StaticPlyInput& input,
+                                     Handler& handler) {
+      Storage storage;
+      for (uintmax_t instance = 0; instance < instance_count; instance++) {
+        if (std::error_code error = input.NextLine(); error) {
+          return error;
+        }
+
+        std::error_code error;
+        std::apply(
+            [&](auto&... storage) {
+              ((error = ReadASCIIProperty<Properties>(input, storage),
+                !error) &&
+               ...);
+            },
+            storage);
+        if (error) {
+          return error;
+        }
+
+        if (std::error_code error = input.EndLine(); error) {
+          return error;
+        }
+
+        if (std::error_code error = Deliver(handler, storage); error) {
+          return error;
+        }
+      }
+
+      return std::error_code();
+    }
+  };
+};
+
+}  // namespace plyodine
+
+#endif  // _PLYODINE_STATIC_PLY_READER_
@@ -0,0 +1,391 @@
+#include "plyodine/static_ply_reader.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+#include "tools/cpp/runfiles/runfiles.h"
+
+namespace plyodine {
+namespace {
+
+using ::bazel::tools::cpp::runfiles::Runfiles;
+
+using Vertex = PlyElement<"vertex", PlyProperty<"x", float>,
+                          PlyProperty<"y", float>, PlyProperty<"z", float>>;
+using Face =
+    PlyElement<"face", PlyProperty<"flags", uint16_t>,
+               PlyPropertyList<"vertex_indices", int32_t, int16_t>>;
+using MeshReader = StaticPlyReader<PlySchema<Vertex, Face>>;
+
+struct MeshHandler {
+  std::error_code operator()(Vertex, const Vertex::Values& values) {
+    vertices.push_back(values);
+    return std::error_code();
+  }
+
+  std::error_code operator()(Face, const Face::Values& values) {
+    flags.push_back(std::get<0>(values));
+    faces.emplace_back(std::get<1>(values).begin(), std::get<1>(values).end());
+    if (faces.size() == fail_after) {
+      return std::make_error_code(std::errc::interrupted);
+    }
+
+    return std::error_code();
+  }
+
+  std::vector<std::tuple<float, float, float>> vertices;
+  std::vector<uint16_t> flags;
+  std::vector<std::vector<int32_t>> faces;
+  size_t fail_after = 0u;
+};
+
+std::span<const std::byte> AsBytes(const std::string& data) {
+  return std::as_bytes(std::span(data.data(), data.size()));
+}
+
+template <typename T>
+void Append(std::string& output, T value, std::endian endianness) {
+  if (endianness != std::endian::native) {
+    if constexpr (sizeof(T) == 2u) {
+      value = std::bit_cast<T>(std::byteswap(std::bit_cast<uint16_t>(value)));
+    } else if constexpr (sizeof(T) == 4u) {
+      value = std::bit_cast<T>(std::byteswap(std::bit_cast<uint32_t>(value)));
+    } else if constexpr (sizeof(T) == 8u) {
+      value = std::bit_cast<T>(std::byteswap(std::bit_cast<uint64_t>(value)));
+    }
+  }
+
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  output.append(bytes, sizeof(T));
+}
+
+// Returns a binary input with 3 vertices followed by an element that is not in
+// the schema and 3 faces with between zero and two vertex indices.
+std::string MakeBinaryInput(std::endian endianness) {
+  std::string result = "ply\nformat ";
+  result += (endianness == std::endian::big) ? "binary_big_endian"
+                                             : "binary_little_endian";
+  result +=
+      " 1.0\nelement vertex 3\nproperty float x\nproperty float y\n"
+      "property float z\nelement extra 2\nproperty list uchar double a\n"
+      "property int b\nelement face 3\nproperty ushort flags\n"
+      "property list short int vertex_indices\nend_header\n";
+
+  for (int i = 0; i < 9; i++) {
+    Append(result, static_cast<float>(i), endianness);
+  }
+
+  for (uint8_t i = 1; i < 3; i++) {
+    Append(result, i, endianness);
+    for (uint8_t j = 0; j < i; j++) {
+      Append(result, 1.0, endianness);
+    }
+    Append(result, static_cast<int32_t>(i), endianness);
+  }
+
+  for (int16_t i = 0; i < 3; i++) {
+    Append(result, static_cast<uint16_t>(i + 10), endianness);
+    Append(result, i, endianness);
+    for (int32_t j = 0; j < i; j++) {
+      Append(result, j + 1, endianness);
+    }
+  }
+
+  return result;
+}
+
+void ExpectMesh(const MeshHandler& handler) {
+  std::vector<std::tuple<float, float, float>> vertices = {
+      {0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}, {6.0f, 7.0f, 8.0f}};
+  EXPECT_EQ(vertices, handler.vertices);
+  EXPECT_EQ(std::vector<uint16_t>({10u, 11u, 12u}), handler.flags);
+  EXPECT_EQ(std::vector<std::vector<int32_t>>({{}, {1}, {1, 2}}),
+            handler.faces);
+}
+
+TEST(StaticPlyReader, BigEndian) {
+  std::string input = MakeBinaryInput(std::endian::big);
+  MeshHandler handler;
+  EXPECT_FALSE(MeshReader::ReadFrom(AsBytes(input), handler));
+  ExpectMesh(handler);
+}
+
+TEST(StaticPlyReader, LittleEndian) {
+  std::string input = MakeBinaryInput(std::endian::little);
+  MeshHandler handler;
+  EXPECT_FALSE(MeshReader::ReadFrom(AsBytes(input), handler));
+  ExpectMesh(handler);
+}
+
+TEST(StaticPlyReader, ASCII) {
+  std::string input =
+      "ply\r\nformat ascii 1.0\r\nelement face 3\r\nproperty ushort flags\r\n"
+      "property list short int vertex_indices\r\nelement extra 1\r\n"
+      "property list uchar double a\r\nelement vertex 3\r\n"
+      "property float x\r\nproperty float y\r\nproperty float z\r\n"
+      "end_header\r\n10 0\r\n11 1 1\r\n12\t2 1  2 \r\n2 1.0 2.0\r\n"
+      "0 1 2\r\n3.0 4 5\r\n6 7 8";
+  MeshHandler handler;
+  EXPECT_FALSE(MeshReader::ReadFrom(AsBytes(input), handler));
+  ExpectMesh(handler);
+}
+
+TEST(StaticPlyReader, EmptySchema) {
+  std::string input = MakeBinaryInput(std::endian::little);
+  EXPECT_FALSE(StaticPlyReader<PlySchema<>>::ReadFrom(
+      AsBytes(input), [](auto, const auto&) { return std::error_code(); }));
+}
+
+TEST(StaticPlyReader, BadHeader) {
+  std::string input = "ply\nformat ascii 2.0\n";
+  std::span<const std::byte> data = AsBytes(input);
+  MeshHandler handler;
+  EXPECT_EQ(ReadPlyHeader(data).error(), MeshReader::ReadFrom(data, handler));
+}
+
+TEST(StaticPlyReader, MissingElement) {
+  std::string input =
+      "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n"
+      "property float y\nproperty float z\nend_header\n1 2 3\n";
+  MeshHandler handler;
+  EXPECT_EQ("The input did not contain an element required by the schema",
+            MeshReader::ReadFrom(AsBytes(input), handler).message());
+  EXPECT_TRUE(handler.vertices.empty());
+}
+
+TEST(StaticPlyReader, MismatchedProperties) {
+  for (const std::string& properties :
+       {std::string("property double x\nproperty float y\nproperty float z\n"),
+        std::string("property float x\nproperty float z\nproperty float y\n"),
+        std::string("property float x\nproperty float y\n"),
+        std::string("property float x\nproperty float y\nproperty float z\n"
+                    "property float w\n"),
+        std::string("property float x\nproperty float y\n"
+                    "property list uchar float z\n")}) {
+    std::string input =
+        "ply\nformat ascii 1.0\nelement vertex 1\n" + properties +
+        "element face 0\nproperty ushort flags\n"
+        "property list short int vertex_indices\nend_header\n";
+    MeshHandler handler;
+    EXPECT_EQ("The properties of an element of the input did not match the "
+              "schema",
+              MeshReader::ReadFrom(AsBytes(input), handler).message())
+        << properties;
+  }
+
+  std::string input =
+      "ply\nformat ascii 1.0\nelement vertex 0\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 0\n"
+      "property ushort flags\nproperty list uchar int vertex_indices\n"
+      "end_header\n";
+  MeshHandler handler;
+  EXPECT_EQ("The properties of an element of the input did not match the "
+            "schema",
+            MeshReader::ReadFrom(AsBytes(input), handler).message());
+}
+
+TEST(StaticPlyReader, Truncated) {
+  std::string input = MakeBinaryInput(std::endian::little);
+  size_t data_offset = input.find("end_header\n") + 11u;
+
+  for (size_t size = data_offset; size < input.size(); size++) {
+    MeshHandler handler;
+    EXPECT_EQ(
+        "The input ended earlier than expected",
+        MeshReader::ReadFrom(AsBytes(input.substr(0u, size)), handler)
+            .message());
+    EXPECT_EQ(std::min<size_t>(3u, (size - data_offset) / 12u),
+              handler.vertices.size());
+  }
+
+  std::string ascii =
+      "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 1\n"
+      "property ushort flags\nproperty list short int vertex_indices\n"
+      "end_header\n1 2 3\n0 2 1";
+  MeshHandler handler;
+  EXPECT_EQ("The input ended earlier than expected",
+            MeshReader::ReadFrom(AsBytes(ascii), handler).message());
+}
+
+TEST(StaticPlyReader, NegativeListSize) {
+  std::string header =
+      "ply\nformat binary_little_endian 1.0\nelement vertex 0\n"
+      "property float x\nproperty float y\nproperty float z\n"
+      "element face 1\nproperty ushort flags\n"
+      "property list short int vertex_indices\nend_header\n";
+  std::string input = header;
+  Append(input, static_cast<uint16_t>(0u), std::endian::little);
+  Append(input, static_cast<int16_t>(-1), std::endian::little);
+
+  MeshHandler handler;
+  EXPECT_EQ("The input contained a property list with a negative size",
+            MeshReader::ReadFrom(AsBytes(input), handler).message());
+
+  std::string skipped =
+      "ply\nformat binary_little_endian 1.0\nelement extra 1\n"
+      "property list char int a\nelement vertex 0\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 0\n"
+      "property ushort flags\nproperty list short int vertex_indices\n"
+      "end_header\n\xff";
+  EXPECT_EQ("The input contained a property list with a negative size",
+            MeshReader::ReadFrom(AsBytes(skipped), handler).message());
+}
+
+TEST(StaticPlyReader, ASCIIErrors) {
+  const std::string header =
+      "ply\nformat ascii 1.0\nelement vertex 0\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 1\n"
+      "property ushort flags\nproperty list short int vertex_indices\n"
+      "end_header\n";
+  for (const auto& [data, message] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"1 1 1 1\n", "The input contained a line with too many tokens"},
+           {"1 2 1\n", "The input contained a line with too few tokens"},
+           {"1 a\n", "The input contained a token that could not be parsed"},
+           {"-1 0\n",
+            "The input contained a token that was out of range for its type"},
+           {"70000 0\n",
+            "The input contained a token that was out of range for its type"},
+           {"1 -1\n",
+            "The input contained a property list with a negative size"},
+           {"1 0\r\n", "The input contained mismatched line endings"},
+           {"1 \x01 0\n", "The input contained an invalid character"},
+           {"1", "The input ended earlier than expected"},
+           {"", "The input ended earlier than expected"}}) {
+    std::string input = header + data;
+    MeshHandler handler;
+    EXPECT_EQ(message, MeshReader::ReadFrom(AsBytes(input), handler).message())
+        << data;
+  }
+}
+
+TEST(StaticPlyReader, ASCIISkippedErrors) {
+  const std::string header =
+      "ply\nformat ascii 1.0\nelement extra 1\nproperty int a\n"
+      "property list char int b\nelement vertex 0\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 0\n"
+      "property ushort flags\nproperty list short int vertex_indices\n"
+      "end_header\n";
+  for (const auto& [data, message] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"1 1 1 1\n", "The input contained a line with too many tokens"},
+           {"1 2 1\n", "The input contained a line with too few tokens"},
+           {"1\n", "The input contained a line with too few tokens"},
+           {"1 a\n", "The input contained a token that could not be parsed"},
+           {"1 200 1\n",
+            "The input contained a token that was out of range for its type"},
+           {"1 -1\n",
+            "The input contained a property list with a negative size"},
+           {"1 0\r\n", "The input contained mismatched line endings"},
+           {"", "The input ended earlier than expected"}}) {
+    std::string input = header + data;
+    MeshHandler handler;
+    EXPECT_EQ(message, MeshReader::ReadFrom(AsBytes(input), handler).message())
+        << data;
+  }
+
+  // Values that are skipped are not parsed
+  std::string input = header + "x 2 y z\n";
+  MeshHandler handler;
+  EXPECT_FALSE(MeshReader::ReadFrom(AsBytes(input), handler));
+}
+
+TEST(StaticPlyReader, HandlerError) {
+  std::string input = MakeBinaryInput(std::endian::little);
+  MeshHandler handler;
+  handler.fail_after = 2u;
+  EXPECT_EQ(std::errc::interrupted,
+            MeshReader::ReadFrom(AsBytes(input), handler));
+  EXPECT_EQ(2u, handler.faces.size());
+}
+
+using Values = PlyElement<
+    "vertex", PlyProperty<"a", int8_t>, PlyProperty<"b", uint8_t>,
+    PlyProperty<"c", int16_t>, PlyProperty<"d", uint16_t>,
+    PlyProperty<"e", int32_t>, PlyProperty<"f", uint32_t>,
+    PlyProperty<"g", float>, PlyProperty<"h", double>>;
+using Lists = PlyElement<
+    "vertex_lists", PlyPropertyList<"a", int8_t>, PlyPropertyList<"b", uint8_t>,
+    PlyPropertyList<"c", int16_t>, PlyPropertyList<"d", uint16_t>,
+    PlyPropertyList<"e", int32_t>, PlyPropertyList<"f", uint32_t>,
+    PlyPropertyList<"g", float>, PlyPropertyList<"h", double>>;
+using DataReader = StaticPlyReader<PlySchema<Lists, Values>>;
+
+struct DataHandler {
+  std::error_code operator()(Values, const Values::Values& values) {
+    this->values.push_back(values);
+    return std::error_code();
+  }
+
+  std::error_code operator()(Lists, const Lists::Values& values) {
+    std::apply(
+        [&](const auto&... lists) {
+          (this->lists.push_back(std::vector<double>(lists.begin(),
+                                                     lists.end())),
+           ...);
+        },
+        values);
+    return std::error_code();
+  }
+
+  std::vector<Values::Values> values;
+  std::vector<std::vector<double>> lists;
+};
+
+std::filesystem::path RunfilePath(const std::string& path) {
+  std::unique_ptr<Runfiles> runfiles(Runfiles::CreateForTest());
+  return runfiles->Rlocation(path);
+}
+
+TEST(StaticPlyReader, Path) {
+  DataHandler ascii;
+  EXPECT_FALSE(DataReader::ReadFrom(
+      RunfilePath("_main/plyodine/test_data/ply_ascii_data.ply"), ascii));
+  EXPECT_EQ(3u, ascii.values.size());
+  EXPECT_EQ(8u, ascii.lists.size());
+
+  for (std::string name : {"ply_big_data.ply", "ply_little_data.ply"}) {
+    DataHandler binary;
+    EXPECT_FALSE(DataReader::ReadFrom(
+        RunfilePath("_main/plyodine/test_data/" + name), binary));
+    EXPECT_EQ(ascii.values, binary.values) << name;
+    EXPECT_EQ(ascii.lists, binary.lists) << name;
+  }
+
+  DataHandler handler;
+  EXPECT_EQ(std::errc::no_such_file_or_directory,
+            DataReader::ReadFrom(
+                RunfilePath("_main/plyodine/test_data/missing.ply"), handler));
+}
+
+TEST(StaticPlyReader, PathError) {
+  DataHandler missing;
+  std::error_code error = DataReader::ReadFrom(
+      RunfilePath("_main/plyodine/test_data/missing.ply"), missing);
+  EXPECT_EQ(std::errc::no_such_file_or_directory, error);
+  EXPECT_EQ(std::generic_category(), error.category());
+
+  // Directories are opened but cannot be read as a file
+  DataHandler directory;
+  error = DataReader::ReadFrom(std::filesystem::path(testing::TempDir()),
+                               directory);
+  EXPECT_NE(0, error.value());
+  EXPECT_EQ(std::generic_category(), error.category());
+}
+
+}  // namespace
+}  // namespace plyodine
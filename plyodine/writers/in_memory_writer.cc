@@ -11,10 +11,13 @@
 
 namespace {
 
-std::generator<int8_t> MakeGenerator(std::span<const int8_t> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+// A generator that yields the values of a non-list property as a single batch
+// so that they are written in bulk rather than one value at a time
+template <typename T>
+using BatchGenerator = std::generator<plyodine::PropertyBatch<T>>;
+
+BatchGenerator<int8_t> MakeGenerator(std::span<const int8_t> values) {
+  co_yield plyodine::PropertyBatch<int8_t>{values};
 }
 
 std::generator<std::span<const int8_t>> MakeGenerator(
@@ -31,10 +34,8 @@ std::generator<std::span<const int8_t>> MakeGenerator(
   }
 }
 
-std::generator<uint8_t> MakeGenerator(std::span<const uint8_t> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<uint8_t> MakeGenerator(std::span<const uint8_t> values) {
+  co_yield plyodine::PropertyBatch<uint8_t>{values};
 }
 
 std::generator<std::span<const uint8_t>> MakeGenerator(
@@ -51,10 +52,8 @@ std::generator<std::span<const uint8_t>> MakeGenerator(
   }
 }
 
-std::generator<int16_t> MakeGenerator(std::span<const int16_t> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<int16_t> MakeGenerator(std::span<const int16_t> values) {
+  co_yield plyodine::PropertyBatch<int16_t>{values};
 }
 
 std::generator<std::span<const int16_t>> MakeGenerator(
@@ -71,10 +70,8 @@ std::generator<std::span<const int16_t>> MakeGenerator(
   }
 }
 
-std::generator<uint16_t> MakeGenerator(std::span<const uint16_t> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<uint16_t> MakeGenerator(std::span<const uint16_t> values) {
+  co_yield plyodine::PropertyBatch<uint16_t>{values};
 }
 
 std::generator<std::span<const uint16_t>> MakeGenerator(
@@ -91,10 +88,8 @@ std::generator<std::span<const uint16_t>> MakeGenerator(
   }
 }
 
-std::generator<int32_t> MakeGenerator(std::span<const int32_t> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<int32_t> MakeGenerator(std::span<const int32_t> values) {
+  co_yield plyodine::PropertyBatch<int32_t>{values};
 }
 
 std::generator<std::span<const int32_t>> MakeGenerator(
@@ -111,10 +106,8 @@ std::generator<std::span<const int32_t>> MakeGenerator(
   }
 }
 
-std::generator<uint32_t> MakeGenerator(std::span<const uint32_t> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<uint32_t> MakeGenerator(std::span<const uint32_t> values) {
+  co_yield plyodine::PropertyBatch<uint32_t>{values};
 }
 
 std::generator<std::span<const uint32_t>> MakeGenerator(
@@ -131,10 +124,8 @@ std::generator<std::span<const uint32_t>> MakeGenerator(
   }
 }
 
-std::generator<float> MakeGenerator(std::span<const float> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<float> MakeGenerator(std::span<const float> values) {
+  co_yield plyodine::PropertyBatch<float>{values};
 }
 
 std::generator<std::span<const float>> MakeGenerator(
@@ -151,10 +142,8 @@ std::generator<std::span<const float>> MakeGenerator(
   }
 }
 
-std::generator<double> MakeGenerator(std::span<const double> values) {
-  for (const auto& value : values) {
-    co_yield value;
-  }
+BatchGenerator<double> MakeGenerator(std::span<const double> values) {
+  co_yield plyodine::PropertyBatch<double>{values};
 }
 
 std::generator<std::span<const double>> MakeGenerator(
@@ -183,6 +172,10 @@ void InMemoryWriter::AddObjectInfo(std::string object_info) {
   object_info_.push_back(std::move(object_info));
 }
 
+void InMemoryWriter::SetNumThreads(size_t num_threads) {
+  num_threads_ = num_threads;
+}
+
 void InMemoryWriter::AddPropertyShallow(const std::string& element_name,
                                         const std::string& property_name,
                                         std::span<const int8_t> values) {
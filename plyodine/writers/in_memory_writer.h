@@ -29,6 +29,11 @@ class InMemoryWriter final : public PlyWriter {
   // Adds an object info to the the file
   void AddObjectInfo(std::string object_info);
 
+  // Sets the number of threads used to format the non-list properties of the
+  // data section when writing ASCII output and to write the file in parallel
+  // with `WriteToFile`. Defaults to one.
+  void SetNumThreads(size_t num_threads);
+
   // Add a char property to the file without copying or moving the values into
   // this object.
   //
@@ -478,6 +483,8 @@ class InMemoryWriter final : public PlyWriter {
       const std::string& element_name,
       const std::string& property_name) const override;
 
+  size_t GetNumThreads() const override { return num_threads_; }
+
  private:
   template <typename T>
   void AddPropertyShallowImpl(const std::string& element_name,
@@ -589,6 +596,7 @@ class InMemoryWriter final : public PlyWriter {
 
   std::vector<std::string> comments_;
   std::vector<std::string> object_info_;
+  size_t num_threads_ = 1u;
   std::map<std::string, std::map<std::string, Property>> properties_;
   std::map<std::string, std::map<std::string, PropertyStorage>>
       property_storage_;
@@ -139,12 +139,90 @@ TEST(ASCII, WithData) {
       "end_header\r"
       "-1 1 -1 1 -1 1 1.5 1.5\r"
       "2 2 2 2 2 2 2.5 2.5\r"
-      "0 0 0 0 0 0 3.14159274 3.1415926535897931\r"
-      "3 -1 2 0 3 1 2 0 3 -1 2 0 3 1 2 0 3 -1 2 0 3 1 2 0 3 1.5 2.5 3.14159274 "
-      "3 1.5 2.5 3.1415926535897931\r");
+      "0 0 0 0 0 0 3.1415927 3.141592653589793\r"
+      "3 -1 2 0 3 1 2 0 3 -1 2 0 3 1 2 0 3 -1 2 0 3 1 2 0 3 1.5 2.5 3.1415927 "
+      "3 1.5 2.5 3.141592653589793\r");
   std::string expected(std::istreambuf_iterator<char>(input), {});
   EXPECT_EQ(expected, output.str());
 }
 
+TEST(Binary, LargeElements) {
+  std::vector<float> x, y, z;
+  std::vector<uint32_t> index;
+  std::vector<uint8_t> flags;
+  for (uint32_t i = 0; i < 100000u; i++) {
+    x.push_back(static_cast<float>(i));
+    y.push_back(static_cast<float>(i) * 0.5f);
+    z.push_back(static_cast<float>(i) * -2.0f);
+    index.push_back(i * 3u);
+    flags.push_back(static_cast<uint8_t>(i));
+  }
+
+  InMemoryWriter writer;
+  writer.AddProperty("vertex", "x", x);
+  writer.AddProperty("vertex", "y", y);
+  writer.AddProperty("vertex", "z", z);
+  writer.AddProperty("face", "index", index);
+  writer.AddProperty("flag", "value", flags);
+
+  for (std::endian endianness : {std::endian::big, std::endian::little}) {
+    std::string expected =
+        std::string("ply\rformat ") +
+        (endianness == std::endian::big ? "binary_big_endian"
+                                        : "binary_little_endian") +
+        " 1.0\relement face 100000\rproperty uint index\r"
+        "element flag 100000\rproperty uchar value\r"
+        "element vertex 100000\rproperty float x\rproperty float y\r"
+        "property float z\rend_header\r";
+    auto append = [&](auto value) {
+      if (endianness != std::endian::native) {
+        value = std::byteswap(value);
+      }
+      expected.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    for (uint32_t value : index) {
+      append(value);
+    }
+    for (uint8_t value : flags) {
+      append(value);
+    }
+    for (size_t i = 0; i < x.size(); i++) {
+      append(std::bit_cast<uint32_t>(x[i]));
+      append(std::bit_cast<uint32_t>(y[i]));
+      append(std::bit_cast<uint32_t>(z[i]));
+    }
+
+    std::stringstream output;
+    if (endianness == std::endian::big) {
+      ASSERT_EQ(0, writer.WriteToBigEndian(output).value());
+    } else {
+      ASSERT_EQ(0, writer.WriteToLittleEndian(output).value());
+    }
+
+    EXPECT_EQ(expected, output.str());
+  }
+}
+
+TEST(ASCII, Parallel) {
+  std::vector<float> x;
+  std::vector<std::vector<uint32_t>> faces;
+  for (uint32_t i = 0; i < 100000u; i++) {
+    x.push_back(static_cast<float>(i) / 3.0f);
+    faces.push_back({i, i + 1u, i + 2u});
+  }
+
+  InMemoryWriter writer;
+  writer.AddProperty("vertex", "x", x);
+  writer.AddPropertyList("face", "vertex_indices", faces);
+
+  std::stringstream expected;
+  ASSERT_EQ(0, writer.WriteToASCII(expected).value());
+
+  writer.SetNumThreads(4u);
+  std::stringstream output;
+  ASSERT_EQ(0, writer.WriteToASCII(output).value());
+  EXPECT_EQ(expected.str(), output.str());
+}
+
 }  // namespace
 }  // namespace plyodine
@@ -136,6 +136,12 @@ class Sanitizer final : private PlyReader, private PlyWriter {
       std::move_only_function<std::error_code(std::span<const T>)>& callback,
       bool low_mem, uintmax_t num_instances);
 
+  template <typename T>
+  static std::unique_ptr<PropertyInterface> UpdateCallback(
+      std::move_only_function<std::error_code(uintmax_t, std::span<const T>)>&
+          callback,
+      bool low_mem, uintmax_t num_instances);
+
   void Cancel();
 
   // PlyReader
@@ -285,6 +291,15 @@ std::unique_ptr<Sanitizer::PropertyInterface> Sanitizer::UpdateCallback(
   return property_list;
 }
 
+template <typename T>
+std::unique_ptr<Sanitizer::PropertyInterface> Sanitizer::UpdateCallback(
+    std::move_only_function<std::error_code(uintmax_t, std::span<const T>)>&
+        callback,
+    bool low_mem, uintmax_t num_instances) {
+  // Batch callbacks are never passed to Start
+  return nullptr;
+}
+
 void Sanitizer::Cancel() {
   if (!low_mem_) {
     return;
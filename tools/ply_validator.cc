@@ -2,6 +2,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <span>
 #include <string>
 #include <system_error>
 #include <variant>
@@ -26,6 +27,13 @@ void UpdateCallback(std::move_only_function<std::error_code(T)>& callback) {
   callback = [](T) { return std::error_code(); };
 }
 
+template <typename T>
+void UpdateCallback(
+    std::move_only_function<std::error_code(uintmax_t, std::span<const T>)>&
+        callback) {
+  callback = [](uintmax_t, std::span<const T>) { return std::error_code(); };
+}
+
 std::error_code Validator::Start(
     std::map<std::string, uintmax_t> num_element_instances,
     std::map<std::string, std::map<std::string, PropertyCallback>>& callbacks,